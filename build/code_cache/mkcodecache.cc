@@ -0,0 +1,205 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+// Compiles Electron's js2c bundles ahead of time and writes the resulting V8
+// code cache as a header that is embedded next to the bundle sources, so that
+// every process can skip parsing and compiling them at startup.
+//
+// Usage:
+//   mkcodecache <output> [--js-flags=<flags>] <file> ...
+//
+// Each <file> is a bundle named electron/js2c/<basename>. It is compiled with
+// the parameters listed for it in shell/common/js2c_bundles.h, which the
+// runtime compiles it with as well.
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "shell/common/js2c_bundles.h"
+#include "v8/include/libplatform/libplatform.h"
+#include "v8/include/v8.h"
+
+namespace {
+
+struct Bundle {
+  std::string id;
+  const char* const* parameters;
+  std::string path;
+};
+
+// Maps out/gen/electron/js2c/foo.js to electron/js2c/foo, like js2c does.
+std::string GetBundleId(const std::string& path) {
+  std::string name = path.substr(path.find_last_of("/\\") + 1);
+  return "electron/js2c/" + name.substr(0, name.rfind('.'));
+}
+
+bool ReadFile(const std::string& path, std::string* contents) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+    return false;
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  *contents = buffer.str();
+  return true;
+}
+
+std::string GetVariableName(size_t index) {
+  return "kCodeCache" + std::to_string(index);
+}
+
+void WriteCodeCache(std::ostream& out,
+                    const std::string& name,
+                    const v8::ScriptCompiler::CachedData* cached_data) {
+  out << "const uint8_t " << name << "[] = {";
+  for (int i = 0; i < cached_data->length; ++i) {
+    out << (i % 20 == 0 ? "\n    " : " ")
+        << static_cast<int>(cached_data->data[i]) << ",";
+  }
+  out << "\n};\n\n";
+}
+
+std::unique_ptr<v8::ScriptCompiler::CachedData> CreateCodeCache(
+    v8::Local<v8::Context> context,
+    const Bundle& bundle) {
+  v8::Isolate* isolate = context->GetIsolate();
+  std::string contents;
+  if (!ReadFile(bundle.path, &contents)) {
+    std::cerr << "Failed to read " << bundle.path << std::endl;
+    return nullptr;
+  }
+
+  // The bundles are embedded with the same UTF-8 decoding, V8 checks the
+  // source length before accepting a cache.
+  v8::Local<v8::String> source_string =
+      v8::String::NewFromUtf8(isolate, contents.data(),
+                              v8::NewStringType::kNormal, contents.size())
+          .ToLocalChecked();
+  v8::Local<v8::String> filename =
+      v8::String::NewFromUtf8(isolate, (bundle.id + ".js").c_str())
+          .ToLocalChecked();
+  v8::ScriptOrigin origin(filename, v8::Integer::New(isolate, 0),
+                          v8::Integer::New(isolate, 0), v8::True(isolate));
+  v8::ScriptCompiler::Source source(source_string, origin);
+
+  std::vector<v8::Local<v8::String>> parameters;
+  for (const char* const* name = bundle.parameters; *name; ++name) {
+    parameters.push_back(
+        v8::String::NewFromUtf8(isolate, *name).ToLocalChecked());
+  }
+
+  v8::TryCatch try_catch(isolate);
+  v8::Local<v8::Function> function;
+  if (!v8::ScriptCompiler::CompileFunctionInContext(
+           context, &source, parameters.size(), parameters.data(), 0, nullptr,
+           v8::ScriptCompiler::kEagerCompile)
+           .ToLocal(&function)) {
+    v8::String::Utf8Value message(isolate, try_catch.Message()->Get());
+    std::cerr << "Failed to compile " << bundle.id << ": " << *message
+              << std::endl;
+    return nullptr;
+  }
+  return std::unique_ptr<v8::ScriptCompiler::CachedData>(
+      v8::ScriptCompiler::CreateCodeCacheForFunction(function));
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0]
+              << " <output> [--js-flags=<flags>] <file> ..." << std::endl;
+    return 1;
+  }
+
+  std::string output = argv[1];
+  std::vector<Bundle> bundles;
+  const std::string js_flags_prefix = "--js-flags=";
+  int i = 2;
+  if (i < argc && std::string(argv[i]).rfind(js_flags_prefix, 0) == 0) {
+    // The flags hash is part of the cache, so the flags that change code
+    // generation have to match the ones the processes run with.
+    std::string js_flags = std::string(argv[i]).substr(js_flags_prefix.size());
+    v8::V8::SetFlagsFromString(js_flags.c_str(), js_flags.size());
+    ++i;
+  }
+  for (; i < argc; ++i) {
+    std::string id = GetBundleId(argv[i]);
+    const electron::Js2cBundle* bundle = electron::FindJs2cBundle(id.c_str());
+    if (!bundle) {
+      std::cerr << id << " is not listed in js2c_bundles.h" << std::endl;
+      return 1;
+    }
+    bundles.push_back({id, bundle->parameters, argv[i]});
+  }
+
+  v8::V8::InitializeICUDefaultLocation(argv[0]);
+  v8::V8::InitializeExternalStartupData(argv[0]);
+  std::unique_ptr<v8::Platform> platform = v8::platform::NewDefaultPlatform();
+  v8::V8::InitializePlatform(platform.get());
+  v8::V8::Initialize();
+
+  std::unique_ptr<v8::ArrayBuffer::Allocator> allocator(
+      v8::ArrayBuffer::Allocator::NewDefaultAllocator());
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = allocator.get();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+
+  std::stringstream out;
+  out << "// This file is generated by mkcodecache, do not edit.\n\n"
+         "#include <cstdlib>\n"
+         "#include <memory>\n\n"
+         "namespace electron {\n\n"
+         "namespace {\n\n";
+
+  bool success = true;
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+
+    for (size_t index = 0; index < bundles.size(); ++index) {
+      auto cached_data = CreateCodeCache(context, bundles[index]);
+      if (!cached_data) {
+        success = false;
+        break;
+      }
+      WriteCodeCache(out, GetVariableName(index), cached_data.get());
+    }
+  }
+
+  isolate->Dispose();
+  v8::V8::Dispose();
+  v8::V8::ShutdownPlatform();
+  if (!success)
+    return 1;
+
+  out << "}  // namespace\n\n"
+         "// Called while node's builtin loader is being constructed, the "
+         "cache\n"
+         "// entries are consumed by the first compilation of each bundle.\n"
+         "inline void LoadBuiltinCodeCache(\n"
+         "    node::native_module::NativeModuleCacheMap* code_cache) {\n"
+         "  if (std::getenv(\"ELECTRON_DISABLE_BUILTIN_CODE_CACHE\"))\n"
+         "    return;\n";
+  for (size_t index = 0; index < bundles.size(); ++index) {
+    std::string name = GetVariableName(index);
+    out << "  code_cache->emplace(\n"
+        << "      \"" << bundles[index].id << "\",\n"
+        << "      std::make_unique<v8::ScriptCompiler::CachedData>(\n"
+        << "          " << name << ", static_cast<int>(sizeof(" << name
+        << ")),\n"
+        << "          v8::ScriptCompiler::CachedData::BufferNotOwned));\n";
+  }
+  out << "}\n\n"
+         "}  // namespace electron\n";
+
+  std::ofstream file(output, std::ios::binary);
+  file << out.str();
+  return file ? 0 : 1;
+}
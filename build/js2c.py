@@ -23,10 +23,32 @@ void NativeModuleLoader::LoadEmbedderJavaScriptSource() {{
 }}  // namespace node
 """
 
+LOAD_EMBEDDER_SOURCE = 'void NativeModuleLoader::LoadEmbedderJavaScriptSource() {'
+
+def inject_code_cache(natives, code_cache):
+  # The code cache has to be handed to the loader from one of its members, so
+  # hook the generated loader instead of patching node.
+  with open(natives, 'r') as f:
+    source = f.read()
+  assert LOAD_EMBEDDER_SOURCE in source
+  source = source.replace(
+    LOAD_EMBEDDER_SOURCE,
+    LOAD_EMBEDDER_SOURCE + '\n  electron::LoadBuiltinCodeCache(&code_cache_);')
+  # Both files are generated into the same directory.
+  include = '#include "{}"\n'.format(os.path.basename(code_cache))
+  source = source.replace('namespace node {', include + '\nnamespace node {', 1)
+  with open(natives, 'w') as f:
+    f.write(source)
+
 def main():
-  node_path = os.path.abspath(sys.argv[1])
-  natives = os.path.abspath(sys.argv[2])
-  js_source_files = sys.argv[3:]
+  args = sys.argv[1:]
+  code_cache = None
+  if args[0].startswith('--code-cache='):
+    code_cache = os.path.abspath(args.pop(0)[len('--code-cache='):])
+
+  node_path = os.path.abspath(args[0])
+  natives = os.path.abspath(args[1])
+  js_source_files = args[2:]
 
   js2c = os.path.join(node_path, 'tools', 'js2c.py')
   subprocess.check_call(
@@ -34,6 +56,9 @@ def main():
     js_source_files +
     ['--only-js', '--target', natives])
 
+  if code_cache:
+    inject_code_cache(natives, code_cache)
+
 
 if __name__ == '__main__':
   sys.exit(main())
@@ -24,18 +24,19 @@ const MenuItem = function (this: any, options: any) {
 
   this.overrideReadOnlyProperty('type', roles.getDefaultType(this.role));
   this.overrideReadOnlyProperty('role');
-  this.overrideReadOnlyProperty('accelerator');
   this.overrideReadOnlyProperty('icon');
   this.overrideReadOnlyProperty('submenu');
 
   this.overrideProperty('label', roles.getDefaultLabel(this.role));
   this.overrideProperty('sublabel', '');
   this.overrideProperty('toolTip', '');
-  this.overrideProperty('enabled', true);
-  this.overrideProperty('visible', true);
-  this.overrideProperty('checked', false);
-  this.overrideProperty('acceleratorWorksWhenHidden', true);
-  this.overrideProperty('registerAccelerator', roles.shouldRegisterAccelerator(this.role));
+  this.overrideReadOnlyProperty('dynamicState', false);
+  this.overrideStateProperty('enabled', true);
+  this.overrideStateProperty('visible', true);
+  this.overrideStateProperty('checked', false);
+  this.overrideStateProperty('accelerator', null);
+  this.overrideStateProperty('acceleratorWorksWhenHidden', true);
+  this.overrideStateProperty('registerAccelerator', roles.shouldRegisterAccelerator(this.role));
 
   if (!MenuItem.types.includes(this.type)) {
     throw new Error(`Unknown menu item type: ${this.type}`);
@@ -78,6 +79,26 @@ MenuItem.prototype.overrideProperty = function (name: string, defaultValue: any
   }
 };
 
+MenuItem.prototype.hasDynamicState = function () {
+  return !!this.dynamicState || roles.shouldOverrideCheckStatus(this.role);
+};
+
+// Properties that the native menu model keeps a copy of, so that showing a
+// menu doesn't have to call back into JS. Setting them refreshes that copy.
+MenuItem.prototype.overrideStateProperty = function (name: string, defaultValue: any) {
+  this.overrideProperty(name, defaultValue);
+  let value = this[name];
+  Object.defineProperty(this, name, {
+    enumerable: true,
+    configurable: true,
+    get: () => value,
+    set: (newValue) => {
+      value = newValue;
+      if (this.menu) this.menu._updateItemState(this);
+    }
+  });
+};
+
 MenuItem.prototype.overrideReadOnlyProperty = function (name: string, defaultValue: any) {
   this.overrideProperty(name, defaultValue);
   Object.defineProperty(this, name, {
@@ -60,10 +60,28 @@ Menu.prototype._menuWillShow = function () {
   // Ensure radio groups have at least one menu item selected
   for (const id of Object.keys(this.groupsMap)) {
     const found = this.groupsMap[id].find(item => item.checked) || null;
-    if (!found) v8Util.setHiddenValue(this.groupsMap[id][0], 'checked', true);
+    if (!found) {
+      v8Util.setHiddenValue(this.groupsMap[id][0], 'checked', true);
+      this._updateItemState(this.groupsMap[id][0]);
+    }
   }
 };
 
+// Push the item's state to the native model. Items with dynamic state are
+// left out of the model and queried through the delegate methods above.
+Menu.prototype._updateItemState = function (item) {
+  if (item.hasDynamicState()) return;
+  this.setItemState(item.commandId, {
+    checked: !!item.checked,
+    enabled: !!item.enabled,
+    visible: !!item.visible,
+    acceleratorWorksWhenHidden: !!item.acceleratorWorksWhenHidden,
+    registerAccelerator: !!item.registerAccelerator,
+    accelerator: item.accelerator != null ? item.accelerator : undefined,
+    defaultAccelerator: item.getDefaultRoleAccelerator()
+  });
+};
+
 Menu.prototype.popup = function (options = {}) {
   if (options == null || typeof options !== 'object') {
     throw new TypeError('Options must be an object');
@@ -147,6 +165,7 @@ Menu.prototype.insert = function (pos, item) {
   // Remember the items.
   this.items.splice(pos, 0, item);
   this.commandsMap[item.commandId] = item;
+  this._updateItemState(item);
 };
 
 Menu.prototype._callMenuWillShow = function () {
@@ -281,9 +300,13 @@ function insertItemByType (this: MenuType, item: MenuItem, pos: number) {
         get: () => v8Util.getHiddenValue(item, 'checked'),
         set: () => {
           this.groupsMap[item.groupId].forEach(other => {
-            if (other !== item) v8Util.setHiddenValue(other, 'checked', false);
+            if (other !== item && other.checked) {
+              v8Util.setHiddenValue(other, 'checked', false);
+              this._updateItemState(other);
+            }
           });
           v8Util.setHiddenValue(item, 'checked', true);
+          this._updateItemState(item);
         }
       });
       this.insertRadioItem(pos, item.commandId, item.label, item.groupId);
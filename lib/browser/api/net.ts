@@ -198,6 +198,10 @@ class ChunkedBodyStream extends Writable {
   }
 }
 
+function isFileBody (body: NodeJS.CreateURLLoaderOptions['body']): body is NodeJS.FileBody {
+  return body != null && typeof body === 'object' && !ArrayBuffer.isView(body);
+}
+
 type RedirectPolicy = 'manual' | 'follow' | 'error';
 
 function parseOptions (optionsIn: ClientRequestConstructorOptions | string): NodeJS.CreateURLLoaderOptions & { redirectPolicy: RedirectPolicy, headers: Record<string, { name: string, value: string | string[] }> } {
@@ -252,6 +256,19 @@ function parseOptions (optionsIn: ClientRequestConstructorOptions | string): Nod
     throw new TypeError('headers must be an object');
   }
 
+  if (options.uploadFile != null && (typeof options.uploadFile !== 'object' || typeof options.uploadFile.path !== 'string')) {
+    throw new TypeError('`uploadFile` should be an object with a `path` string');
+  }
+  if (options.downloadToFile != null && typeof options.downloadToFile !== 'string') {
+    throw new TypeError('`downloadToFile` should be a string');
+  }
+  if (options.downloadHash != null && !options.downloadToFile) {
+    throw new TypeError('`downloadHash` requires `downloadToFile`');
+  }
+  if (options.downloadToFile && options.downloadToBuffer) {
+    throw new TypeError('`downloadToFile` and `downloadToBuffer` are mutually exclusive');
+  }
+
   const urlLoaderOptions: NodeJS.CreateURLLoaderOptions & { redirectPolicy: RedirectPolicy, headers: Record<string, { name: string, value: string | string[] }> } = {
     method: (options.method || 'GET').toUpperCase(),
     url: urlStr,
@@ -260,8 +277,17 @@ function parseOptions (optionsIn: ClientRequestConstructorOptions | string): Nod
     body: null as any,
     useSessionCookies: options.useSessionCookies,
     credentials: options.credentials,
-    origin: options.origin
+    origin: options.origin,
+    downloadToFile: options.downloadToFile,
+    downloadHash: options.downloadHash,
+    downloadToBuffer: options.downloadToBuffer,
+    downloadMaxSize: options.downloadMaxSize,
+    progressInterval: options.progressInterval
   };
+  if (options.uploadFile) {
+    const { path, offset, length } = options.uploadFile;
+    urlLoaderOptions.body = { path, offset, length };
+  }
   const headers: Record<string, string | string[]> = options.headers || {};
   for (const [name, value] of Object.entries(headers)) {
     if (!isValidHeaderName(name)) {
@@ -330,6 +356,9 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
     if (typeof this._chunkedEncoding !== 'undefined') {
       throw new Error('chunkedEncoding can only be set once');
     }
+    if (isFileBody(this._urlLoaderOptions.body)) {
+      throw new Error('chunkedEncoding can\'t be used with uploadFile');
+    }
     this._chunkedEncoding = !!value;
     if (this._chunkedEncoding) {
       this._body = new ChunkedBodyStream(this);
@@ -383,7 +412,10 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
     delete this._urlLoaderOptions.headers[key];
   }
 
-  _write (chunk: Buffer, encoding: BufferEncoding, callback: () => void) {
+  _write (chunk: Buffer, encoding: BufferEncoding, callback: (error?: Error) => void) {
+    if (isFileBody(this._urlLoaderOptions.body)) {
+      return callback(new Error('Can\'t write to a request whose body is an uploadFile'));
+    }
     this._firstWrite = true;
     if (!this._body) {
       this._body = new SlurpStream();
@@ -429,7 +461,7 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
       this.emit('response', response);
     });
     this._urlLoader.on('data', (event, data, resume) => {
-      this._response!._storeInternalData(Buffer.from(data), resume);
+      this._response!._storeInternalData(Buffer.from(data), resume || null);
     });
     this._urlLoader.on('complete', () => {
       if (this._response) { this._response._storeInternalData(null, null); }
@@ -485,7 +517,7 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
 
     this._urlLoader.on('download-progress', (event, current) => {
       if (this._response) {
-        this._response.emit('download-progress', current); // Undocumented, for now
+        this._response.emit('download-progress', current);
       }
     });
   }
@@ -2,6 +2,7 @@ import { app, ipcMain, session, deprecate, webFrameMain } from 'electron/main';
 import type { BrowserWindowConstructorOptions, LoadURLOptions } from 'electron/main';
 
 import * as url from 'url';
+import { Readable } from 'stream';
 import * as path from 'path';
 import { openGuestWindow, makeWebPreferences } from '@electron/internal/browser/guest-window-manager';
 import { NavigationController } from '@electron/internal/browser/navigation-controller';
@@ -391,6 +392,29 @@ WebContents.prototype.getPrinters = function () {
   }
 };
 
+WebContents.prototype.createHeapSnapshotStream = function (options = {}) {
+  let resumeReading: (() => void) | null = null;
+  const stream = new Readable({
+    read () {
+      if (resumeReading) {
+        const resume = resumeReading;
+        resumeReading = null;
+        resume();
+      }
+    }
+  });
+  this._streamHeapSnapshot((chunk: Buffer, resume: () => void) => {
+    if (stream.push(chunk)) return true;
+    resumeReading = resume;
+    return false;
+  }, options).then(() => {
+    stream.push(null);
+  }, (error: Error) => {
+    stream.destroy(error);
+  });
+  return stream;
+};
+
 WebContents.prototype.loadFile = function (filePath, options = {}) {
   if (typeof filePath !== 'string') {
     throw new Error('Must pass filePath as a string');
@@ -2,7 +2,7 @@ import { webContents } from 'electron/main';
 import { ipcMainInternal } from '@electron/internal/browser/ipc-main-internal';
 import * as ipcMainUtils from '@electron/internal/browser/ipc-main-internal-utils';
 import { parseWebViewWebPreferences } from '@electron/internal/common/parse-features-string';
-import { syncMethods, asyncMethods, properties } from '@electron/internal/common/web-view-methods';
+import { syncMethods, asyncMethods, mutatingMethods, properties, guestStateMethods } from '@electron/internal/common/web-view-methods';
 import { webViewEvents } from '@electron/internal/common/web-view-events';
 import { serialize } from '@electron/internal/common/type-utils';
 import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
@@ -21,6 +21,46 @@ const supportedWebViewEvents = Object.keys(webViewEvents);
 const guestInstances = new Map<number, GuestInstance>();
 const embedderElementsMap = new Map<string, number>();
 
+// Guest events after which the state cached by the embedder may be stale.
+const guestStateEvents = [
+  'did-attach',
+  'did-start-loading',
+  'did-stop-loading',
+  'did-start-navigation',
+  'did-navigate',
+  'did-navigate-in-page',
+  'did-fail-load',
+  'dom-ready',
+  'page-title-updated',
+  'render-process-gone',
+  'devtools-opened',
+  'devtools-closed',
+  'zoom-changed',
+  '-audio-state-changed'
+];
+
+// Orders the snapshots, which reach the embedder both as messages and as
+// replies to its calls.
+let guestStateSeq = 0;
+
+const getGuestState = function (guest: Electron.WebContents) {
+  const state: Record<string, any> = { seq: ++guestStateSeq };
+  for (const [method, key] of guestStateMethods) {
+    state[key] = (guest as any)[method]();
+  }
+  return state;
+};
+
+// Push the guest's current state to its <webview>, so that getters in the
+// embedder don't need a sync round-trip to the browser.
+const sendGuestState = function (guestInstanceId: number) {
+  const guestInstance = guestInstances.get(guestInstanceId);
+  if (!guestInstance) return;
+  const { guest, embedder } = guestInstance;
+  if (guest.isDestroyed() || embedder.isDestroyed() || guest.viewInstanceId == null) return;
+  embedder._sendInternal(`${IPC_MESSAGES.GUEST_VIEW_INTERNAL_STATE_UPDATE}-${guest.viewInstanceId}`, getGuestState(guest));
+};
+
 function sanitizeOptionsForGuest (options: Record<string, any>) {
   const ret = { ...options };
   // WebContents values can't be sent over IPC.
@@ -81,6 +121,11 @@ const createGuest = function (embedder: Electron.WebContents, params: Record<str
     }
   };
 
+  // Update the embedder's copy of the guest state before it sees the event.
+  for (const event of guestStateEvents) {
+    guest.on(event as any, () => sendGuestState(guestInstanceId));
+  }
+
   // Dispatch events to embedder.
   const fn = function (event: string) {
     guest.on(event as any, function (_, ...args: any[]) {
@@ -334,12 +379,17 @@ handleMessage(IPC_MESSAGES.GUEST_VIEW_MANAGER_CALL, function (event, guestInstan
     throw new Error(`Invalid method: ${method}`);
   }
 
+  if (mutatingMethods.has(method)) {
+    (guest as any)[method](...args);
+    // The embedder holds back state updates until its calls are answered.
+    return getGuestState(guest);
+  }
   return (guest as any)[method](...args);
 });
 
 handleMessageSync(IPC_MESSAGES.GUEST_VIEW_MANAGER_CALL, function (event, guestInstanceId: number, method: string, args: any[]) {
   const guest = getGuestForWebContents(guestInstanceId, event.sender);
-  if (!syncMethods.has(method)) {
+  if (!syncMethods.has(method) && !mutatingMethods.has(method)) {
     throw new Error(`Invalid method: ${method}`);
   }
 
@@ -364,6 +414,16 @@ handleMessageSync(IPC_MESSAGES.GUEST_VIEW_MANAGER_PROPERTY_SET, function (event,
   (guest as any)[property] = val;
 });
 
+handleMessage(IPC_MESSAGES.GUEST_VIEW_MANAGER_PROPERTY_SET, function (event, guestInstanceId: number, property: string, val: any) {
+  const guest = getGuestForWebContents(guestInstanceId, event.sender);
+  if (!properties.has(property)) {
+    throw new Error(`Invalid property: ${property}`);
+  }
+
+  (guest as any)[property] = val;
+  return getGuestState(guest);
+});
+
 handleMessage(IPC_MESSAGES.GUEST_VIEW_MANAGER_CAPTURE_PAGE, async function (event, guestInstanceId: number, args: any[]) {
   const guest = getGuestForWebContents(guestInstanceId, event.sender);
 
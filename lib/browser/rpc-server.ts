@@ -43,7 +43,7 @@ const allowedClipboardMethods = (() => {
     case 'darwin':
       return new Set(['readFindText', 'writeFindText']);
     case 'linux':
-      return new Set(Object.keys(clipboard));
+      return new Set(Object.keys(clipboard).filter(method => !method.endsWith('Async')));
     default:
       return new Set();
   }
@@ -57,6 +57,20 @@ ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_CLIPBOARD_SYNC, function (event, me
   return typeUtils.serialize((clipboard as any)[method](...typeUtils.deserialize(args)));
 });
 
+const allowedAsyncClipboardMethods = process.platform === 'linux'
+  ? new Set(['readTextAsync', 'readHTMLAsync', 'readImageAsync'])
+  : new Set();
+
+ipcMainInternal.handle(IPC_MESSAGES.BROWSER_CLIPBOARD_ASYNC, async function (event, method: string, ...args: any[]) {
+  if (!allowedAsyncClipboardMethods.has(method)) {
+    throw new Error(`Invalid method: ${method}`);
+  }
+
+  const result = await (clipboard as any)[method](...args);
+  // The image is already PNG-encoded off the UI thread, so toPNG() is a copy.
+  return method === 'readImageAsync' ? result.toPNG() : result;
+});
+
 if (BUILDFLAG(ENABLE_DESKTOP_CAPTURER)) {
   const desktopCapturer = require('@electron/internal/browser/desktop-capturer');
 
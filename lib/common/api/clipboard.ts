@@ -5,6 +5,8 @@ const clipboard = process._linkedBinding('electron_common_clipboard');
 if (process.type === 'renderer') {
   const ipcRendererUtils = require('@electron/internal/renderer/ipc-renderer-internal-utils');
   const typeUtils = require('@electron/internal/common/type-utils');
+  const { ipcRendererInternal } = require('@electron/internal/renderer/ipc-renderer-internal');
+  const { nativeImage } = process._linkedBinding('electron_common_native_image');
 
   const makeRemoteMethod = function (method: keyof Electron.Clipboard) {
     return (...args: any[]) => {
@@ -14,10 +16,19 @@ if (process.type === 'renderer') {
     };
   };
 
+  // Async readers are answered by the browser without blocking this renderer
+  // on a sync IPC. Images are transferred as PNG-encoded buffers.
+  const makeRemoteAsyncMethod = function (method: keyof Electron.Clipboard) {
+    return async (...args: any[]) => {
+      const result = await ipcRendererInternal.invoke(IPC_MESSAGES.BROWSER_CLIPBOARD_ASYNC, method, ...args);
+      return method === 'readImageAsync' ? nativeImage.createFromBuffer(result) : result;
+    };
+  };
+
   if (process.platform === 'linux') {
     // On Linux we could not access clipboard in renderer process.
     for (const method of Object.keys(clipboard) as (keyof Electron.Clipboard)[]) {
-      clipboard[method] = makeRemoteMethod(method);
+      clipboard[method] = method.endsWith('Async') ? makeRemoteAsyncMethod(method) : makeRemoteMethod(method);
     }
   } else if (process.platform === 'darwin') {
     // Read/write to find pasteboard over IPC since only main process is notified of changes
@@ -1,4 +1,5 @@
 export const enum IPC_MESSAGES {
+  BROWSER_CLIPBOARD_ASYNC = 'BROWSER_CLIPBOARD_ASYNC',
   BROWSER_CLIPBOARD_SYNC = 'BROWSER_CLIPBOARD_SYNC',
   BROWSER_GET_LAST_WEB_PREFERENCES = 'BROWSER_GET_LAST_WEB_PREFERENCES',
   BROWSER_PRELOAD_ERROR = 'BROWSER_PRELOAD_ERROR',
@@ -10,6 +11,7 @@ export const enum IPC_MESSAGES {
   GUEST_VIEW_INTERNAL_DESTROY_GUEST = 'GUEST_VIEW_INTERNAL_DESTROY_GUEST',
   GUEST_VIEW_INTERNAL_DISPATCH_EVENT = 'GUEST_VIEW_INTERNAL_DISPATCH_EVENT',
   GUEST_VIEW_INTERNAL_IPC_MESSAGE = 'GUEST_VIEW_INTERNAL_IPC_MESSAGE',
+  GUEST_VIEW_INTERNAL_STATE_UPDATE = 'GUEST_VIEW_INTERNAL_STATE_UPDATE',
 
   GUEST_VIEW_MANAGER_CREATE_GUEST = 'GUEST_VIEW_MANAGER_CREATE_GUEST',
   GUEST_VIEW_MANAGER_ATTACH_GUEST = 'GUEST_VIEW_MANAGER_ATTACH_GUEST',
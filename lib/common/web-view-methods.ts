@@ -1,32 +1,59 @@
 // Public-facing API methods.
+
+// Getters answered from the guest state the browser pushes to the embedder,
+// mapped to the key they are stored under. They fall back to a sync call
+// until the first state update has arrived.
+export const guestStateMethods = new Map([
+  ['getURL', 'url'],
+  ['getTitle', 'title'],
+  ['isLoading', 'loading'],
+  ['isLoadingMainFrame', 'loadingMainFrame'],
+  ['canGoBack', 'canGoBack'],
+  ['canGoForward', 'canGoForward'],
+  ['isCrashed', 'crashed'],
+  ['isDevToolsOpened', 'devToolsOpened'],
+  ['isCurrentlyAudible', 'currentlyAudible'],
+  ['getUserAgent', 'userAgent'],
+  ['isAudioMuted', 'audioMuted'],
+  ['getZoomFactor', 'zoomFactor'],
+  ['getZoomLevel', 'zoomLevel']
+]);
+
+// Setters whose effect on the guest state is known up front, mapped to the
+// key they change, so the embedder can update its copy without waiting for
+// the browser.
+export const guestStateSetters = new Map([
+  ['setUserAgent', 'userAgent'],
+  ['setAudioMuted', 'audioMuted'],
+  ['setZoomFactor', 'zoomFactor'],
+  ['setZoomLevel', 'zoomLevel']
+]);
+
+// Methods that need a synchronous answer from the guest and have no cached
+// value.
 export const syncMethods = new Set([
-  'getURL',
-  'getTitle',
-  'isLoading',
-  'isLoadingMainFrame',
+  ...guestStateMethods.keys(),
   'isWaitingForResponse',
+  'canGoToOffset',
+  'isDevToolsFocused',
+  'findInPage'
+]);
+
+// Methods that don't return anything. They are sent without waiting for the
+// browser; the sync path is still accepted for compatibility.
+export const mutatingMethods = new Set([
   'stop',
   'reload',
   'reloadIgnoringCache',
-  'canGoBack',
-  'canGoForward',
-  'canGoToOffset',
   'clearHistory',
   'goBack',
   'goForward',
   'goToIndex',
   'goToOffset',
-  'isCrashed',
-  'setUserAgent',
-  'getUserAgent',
+  ...guestStateSetters.keys(),
   'openDevTools',
   'closeDevTools',
-  'isDevToolsOpened',
-  'isDevToolsFocused',
   'inspectElement',
-  'setAudioMuted',
-  'isAudioMuted',
-  'isCurrentlyAudible',
   'undo',
   'redo',
   'cut',
@@ -38,16 +65,11 @@ export const syncMethods = new Set([
   'unselect',
   'replace',
   'replaceMisspelling',
-  'findInPage',
   'stopFindInPage',
   'downloadURL',
   'inspectSharedWorker',
   'inspectServiceWorker',
-  'showDefinitionForSelection',
-  'getZoomFactor',
-  'getZoomLevel',
-  'setZoomFactor',
-  'setZoomLevel'
+  'showDefinitionForSelection'
 ]);
 
 export const properties = new Set([
@@ -59,6 +81,7 @@ export const properties = new Set([
 ]);
 
 export const asyncMethods = new Set([
+  ...mutatingMethods,
   'loadURL',
   'executeJavaScript',
   'insertCSS',
@@ -34,6 +34,7 @@ const dispatchEvent = function (
 export function registerEvents (webView: WebViewImpl, viewInstanceId: number) {
   ipcRendererInternal.on(`${IPC_MESSAGES.GUEST_VIEW_INTERNAL_DESTROY_GUEST}-${viewInstanceId}`, function () {
     webView.guestInstanceId = undefined;
+    webView.guestState = undefined;
     webView.reset();
     webView.dispatchEvent('destroyed');
   });
@@ -45,12 +46,17 @@ export function registerEvents (webView: WebViewImpl, viewInstanceId: number) {
   ipcRendererInternal.on(`${IPC_MESSAGES.GUEST_VIEW_INTERNAL_IPC_MESSAGE}-${viewInstanceId}`, function (event, channel, ...args) {
     webView.dispatchEvent('ipc-message', { channel, args });
   });
+
+  ipcRendererInternal.on(`${IPC_MESSAGES.GUEST_VIEW_INTERNAL_STATE_UPDATE}-${viewInstanceId}`, function (event, state) {
+    webView.setGuestState(state);
+  });
 }
 
 export function deregisterEvents (viewInstanceId: number) {
   ipcRendererInternal.removeAllListeners(`${IPC_MESSAGES.GUEST_VIEW_INTERNAL_DESTROY_GUEST}-${viewInstanceId}`);
   ipcRendererInternal.removeAllListeners(`${IPC_MESSAGES.GUEST_VIEW_INTERNAL_DISPATCH_EVENT}-${viewInstanceId}`);
   ipcRendererInternal.removeAllListeners(`${IPC_MESSAGES.GUEST_VIEW_INTERNAL_IPC_MESSAGE}-${viewInstanceId}`);
+  ipcRendererInternal.removeAllListeners(`${IPC_MESSAGES.GUEST_VIEW_INTERNAL_STATE_UPDATE}-${viewInstanceId}`);
 }
 
 export function createGuest (params: Record<string, any>): Promise<number> {
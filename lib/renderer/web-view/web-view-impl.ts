@@ -4,7 +4,7 @@ import { ipcRendererInternal } from '@electron/internal/renderer/ipc-renderer-in
 import * as ipcRendererUtils from '@electron/internal/renderer/ipc-renderer-internal-utils';
 import * as guestViewInternal from '@electron/internal/renderer/web-view/guest-view-internal';
 import { WEB_VIEW_CONSTANTS } from '@electron/internal/renderer/web-view/web-view-constants';
-import { syncMethods, asyncMethods, properties } from '@electron/internal/common/web-view-methods';
+import { syncMethods, asyncMethods, mutatingMethods, properties, guestStateMethods, guestStateSetters } from '@electron/internal/common/web-view-methods';
 import type { WebViewAttribute, PartitionAttribute } from '@electron/internal/renderer/web-view/web-view-attributes';
 import { deserialize } from '@electron/internal/common/type-utils';
 import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
@@ -19,11 +19,31 @@ const getNextId = function () {
   return ++nextId;
 };
 
+// Chromium's zoom level to zoom factor mapping, see content/common/page_zoom.h.
+const kZoomFactorBase = 1.2;
+
+// Applies the change a setter makes to the cached guest state.
+const applyGuestStateSetter = function (state: Record<string, any>, key: string, value: any) {
+  if (!(key in state)) return false;
+  if (key === 'zoomFactor') {
+    if (typeof value !== 'number' || !(value > 0)) return false;
+    state.zoomLevel = Math.log(value) / Math.log(kZoomFactorBase);
+  } else if (key === 'zoomLevel') {
+    if (typeof value !== 'number') return false;
+    state.zoomFactor = Math.pow(kZoomFactorBase, value);
+  }
+  state[key] = value;
+  return true;
+};
+
 // Represents the internal state of the WebView node.
 export class WebViewImpl {
   public beforeFirstNavigation = true
   public elementAttached = false
   public guestInstanceId?: number
+  // Last guest state pushed by the browser, see guestStateMethods.
+  public guestState?: Record<string, any>
+  public guestStateSeq = 0
   public hasFocus = false
   public internalInstanceId?: number;
   public resizeObserver?: ResizeObserver;
@@ -34,6 +54,9 @@ export class WebViewImpl {
   public on: Record<string, any> = {}
   public internalElement: HTMLIFrameElement
 
+  // Calls that may change the guest state and haven't been answered yet.
+  private pendingCalls = 0
+
   // Replaced in web-view-attributes
   public attributes = new Map<string, WebViewAttribute>();
   public setupWebViewAttributes (): void {}
@@ -80,6 +103,7 @@ export class WebViewImpl {
     if (this.guestInstanceId) {
       this.guestInstanceId = undefined;
     }
+    this.guestState = undefined;
 
     this.beforeFirstNavigation = true;
     (this.attributes.get(WEB_VIEW_CONSTANTS.ATTRIBUTE_PARTITION) as PartitionAttribute).validPartitionId = true;
@@ -148,6 +172,33 @@ export class WebViewImpl {
     });
   }
 
+  // Takes a guest state snapshot from the browser, unless it is older than
+  // the cached one or calls that may change it are still in flight.
+  setGuestState (state: Record<string, any>) {
+    if (this.pendingCalls > 0 || state.seq <= this.guestStateSeq) return;
+    this.guestStateSeq = state.seq;
+    this.guestState = state;
+  }
+
+  // Sends a call that changes the guest without waiting for the browser. A
+  // change known up front is applied to the cached state right away; for any
+  // other the getters go back to sync IPC until the browser answers with the
+  // state the call left the guest in.
+  invokeMutation (channel: string, description: string, guestInstanceId: number, args: Array<any>, key?: string, value?: any) {
+    if (!this.guestState || !key || !applyGuestStateSetter(this.guestState, key, value)) {
+      this.guestState = undefined;
+    }
+    this.pendingCalls++;
+    ipcRendererInternal.invoke<Record<string, any>>(channel, guestInstanceId, ...args).then(state => {
+      this.pendingCalls--;
+      this.setGuestState(state);
+    }, error => {
+      this.pendingCalls--;
+      this.guestState = undefined;
+      console.error(`${description} failed: ${error}`);
+    });
+  }
+
   // Updates state upon loadcommit.
   onLoadCommit (props: Record<string, any>) {
     const oldValue = this.webviewNode.getAttribute(WEB_VIEW_CONSTANTS.ATTRIBUTE_SRC);
@@ -235,8 +286,34 @@ export const setupMethods = (WebViewElement: typeof ElectronInternal.WebViewElem
     };
   };
 
+  // Answer getters from the cached guest state when we have it.
+  const createCachedHandler = function (method: string, key: string) {
+    const blockHandler = createBlockHandler(method);
+    return function (this: ElectronInternal.WebViewElement, ...args: Array<any>) {
+      const internal = v8Util.getHiddenValue<WebViewImpl>(this, 'internal');
+      if (internal.guestInstanceId && internal.guestState) {
+        return internal.guestState[key];
+      }
+      return blockHandler.apply(this, args);
+    };
+  };
+
   for (const method of syncMethods) {
-    (WebViewElement.prototype as Record<string, any>)[method] = createBlockHandler(method);
+    const key = guestStateMethods.get(method);
+    (WebViewElement.prototype as Record<string, any>)[method] = key ? createCachedHandler(method, key) : createBlockHandler(method);
+  }
+
+  // Methods without a return value don't need to block the embedder.
+  const createMutatingHandler = function (method: string) {
+    const key = guestStateSetters.get(method);
+    return function (this: ElectronInternal.WebViewElement, ...args: Array<any>) {
+      const internal = v8Util.getHiddenValue<WebViewImpl>(this, 'internal');
+      internal.invokeMutation(IPC_MESSAGES.GUEST_VIEW_MANAGER_CALL, `<webview>.${method}()`, this.getWebContentsId(), [method, args], key, args[0]);
+    };
+  };
+
+  for (const method of mutatingMethods) {
+    (WebViewElement.prototype as Record<string, any>)[method] = createMutatingHandler(method);
   }
 
   const createNonBlockHandler = function (method: string) {
@@ -246,6 +323,7 @@ export const setupMethods = (WebViewElement: typeof ElectronInternal.WebViewElem
   };
 
   for (const method of asyncMethods) {
+    if (mutatingMethods.has(method)) continue;
     (WebViewElement.prototype as Record<string, any>)[method] = createNonBlockHandler(method);
   }
 
@@ -255,13 +333,18 @@ export const setupMethods = (WebViewElement: typeof ElectronInternal.WebViewElem
 
   const createPropertyGetter = function (property: string) {
     return function (this: ElectronInternal.WebViewElement) {
+      const internal = v8Util.getHiddenValue<WebViewImpl>(this, 'internal');
+      if (internal.guestInstanceId && internal.guestState && property in internal.guestState) {
+        return internal.guestState[property];
+      }
       return ipcRendererUtils.invokeSync(IPC_MESSAGES.GUEST_VIEW_MANAGER_PROPERTY_GET, this.getWebContentsId(), property);
     };
   };
 
   const createPropertySetter = function (property: string) {
     return function (this: ElectronInternal.WebViewElement, arg: any) {
-      return ipcRendererUtils.invokeSync(IPC_MESSAGES.GUEST_VIEW_MANAGER_PROPERTY_SET, this.getWebContentsId(), property, arg);
+      const internal = v8Util.getHiddenValue<WebViewImpl>(this, 'internal');
+      internal.invokeMutation(IPC_MESSAGES.GUEST_VIEW_MANAGER_PROPERTY_SET, `Setting <webview>.${property}`, this.getWebContentsId(), [property, arg], property, arg);
     };
   };
 
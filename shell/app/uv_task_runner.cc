@@ -2,6 +2,7 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <utility>
 
 #include "shell/app/uv_task_runner.h"
@@ -10,23 +11,55 @@
 
 namespace electron {
 
-UvTaskRunner::UvTaskRunner(uv_loop_t* loop) : loop_(loop) {}
+UvTaskRunner::DelayedTask::DelayedTask(base::TimeTicks run_time,
+                                       uint64_t sequence_num,
+                                       base::OnceClosure task)
+    : run_time(run_time), sequence_num(sequence_num), task(std::move(task)) {}
 
-UvTaskRunner::~UvTaskRunner() {
-  for (auto& iter : tasks_) {
-    uv_unref(reinterpret_cast<uv_handle_t*>(iter.first));
-    delete iter.first;
-  }
+UvTaskRunner::DelayedTask::DelayedTask(DelayedTask&& other) = default;
+
+UvTaskRunner::DelayedTask::~DelayedTask() = default;
+
+UvTaskRunner::DelayedTask& UvTaskRunner::DelayedTask::operator=(
+    DelayedTask&& other) = default;
+
+bool UvTaskRunner::DelayedTask::operator<(const DelayedTask& other) const {
+  // std::push_heap builds a max-heap, so invert the comparison.
+  if (run_time != other.run_time)
+    return run_time > other.run_time;
+  return sequence_num > other.sequence_num;
+}
+
+UvTaskRunner::UvTaskRunner(uv_loop_t* loop) : loop_(loop) {
+  uv_async_init(loop_, async_.get(), UvTaskRunner::OnAsync);
+  async_.get()->data = this;
+  uv_unref(async_.handle());
+
+  uv_timer_init(loop_, timer_.get());
+  timer_.get()->data = this;
 }
 
+UvTaskRunner::~UvTaskRunner() = default;
+
 bool UvTaskRunner::PostDelayedTask(const base::Location& from_here,
                                    base::OnceClosure task,
                                    base::TimeDelta delay) {
-  auto* timer = new uv_timer_t;
-  timer->data = this;
-  uv_timer_init(loop_, timer);
-  uv_timer_start(timer, UvTaskRunner::OnTimeout, delay.InMilliseconds(), 0);
-  tasks_[timer] = std::move(task);
+  if (delay <= base::TimeDelta()) {
+    immediate_tasks_.push_back(std::move(task));
+    if (immediate_tasks_.size() == 1) {
+      UpdateAsyncRef();
+      uv_async_send(async_.get());
+    }
+    return true;
+  }
+
+  base::TimeTicks run_time = base::TimeTicks::Now() + delay;
+  bool is_earliest =
+      delayed_tasks_.empty() || run_time < delayed_tasks_.front().run_time;
+  delayed_tasks_.emplace_back(run_time, next_sequence_num_++, std::move(task));
+  std::push_heap(delayed_tasks_.begin(), delayed_tasks_.end());
+  if (is_earliest)
+    UpdateTimer();
   return true;
 }
 
@@ -40,22 +73,57 @@ bool UvTaskRunner::PostNonNestableDelayedTask(const base::Location& from_here,
   return PostDelayedTask(from_here, std::move(task), delay);
 }
 
+// static
+void UvTaskRunner::OnAsync(uv_async_t* handle) {
+  static_cast<UvTaskRunner*>(handle->data)->RunImmediateTasks();
+}
+
 // static
 void UvTaskRunner::OnTimeout(uv_timer_t* timer) {
-  auto& tasks = static_cast<UvTaskRunner*>(timer->data)->tasks_;
-  const auto iter = tasks.find(timer);
-  if (iter == std::end(tasks))
-    return;
+  static_cast<UvTaskRunner*>(timer->data)->RunDelayedTasks();
+}
 
-  std::move(iter->second).Run();
-  tasks.erase(iter);
-  uv_timer_stop(timer);
-  uv_close(reinterpret_cast<uv_handle_t*>(timer), UvTaskRunner::OnClose);
+void UvTaskRunner::RunImmediateTasks() {
+  // Only run the tasks that were queued before this pass, tasks posted while
+  // running are picked up by the next wakeup.
+  size_t count = immediate_tasks_.size();
+  for (size_t i = 0; i < count && !immediate_tasks_.empty(); ++i) {
+    base::OnceClosure task = std::move(immediate_tasks_.front());
+    immediate_tasks_.pop_front();
+    std::move(task).Run();
+  }
+  if (!immediate_tasks_.empty())
+    uv_async_send(async_.get());
+  UpdateAsyncRef();
 }
 
-// static
-void UvTaskRunner::OnClose(uv_handle_t* handle) {
-  delete reinterpret_cast<uv_timer_t*>(handle);
+void UvTaskRunner::RunDelayedTasks() {
+  base::TimeTicks now = base::TimeTicks::Now();
+  while (!delayed_tasks_.empty() && delayed_tasks_.front().run_time <= now) {
+    std::pop_heap(delayed_tasks_.begin(), delayed_tasks_.end());
+    base::OnceClosure task = std::move(delayed_tasks_.back().task);
+    delayed_tasks_.pop_back();
+    std::move(task).Run();
+  }
+  UpdateTimer();
+}
+
+void UvTaskRunner::UpdateTimer() {
+  if (delayed_tasks_.empty()) {
+    uv_timer_stop(timer_.get());
+    return;
+  }
+  base::TimeDelta delay =
+      delayed_tasks_.front().run_time - base::TimeTicks::Now();
+  uv_timer_start(timer_.get(), UvTaskRunner::OnTimeout,
+                 std::max<int64_t>(0, delay.InMillisecondsRoundedUp()), 0);
+}
+
+void UvTaskRunner::UpdateAsyncRef() {
+  if (immediate_tasks_.empty())
+    uv_unref(async_.handle());
+  else
+    uv_ref(async_.handle());
 }
 
 }  // namespace electron
@@ -5,16 +5,23 @@
 #ifndef SHELL_APP_UV_TASK_RUNNER_H_
 #define SHELL_APP_UV_TASK_RUNNER_H_
 
-#include <map>
+#include <vector>
 
 #include "base/callback.h"
+#include "base/containers/circular_deque.h"
 #include "base/location.h"
 #include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
+#include "shell/common/node_bindings.h"
 #include "uv.h"  // NOLINT(build/include_directory)
 
 namespace electron {
 
 // TaskRunner implementation that posts tasks into libuv's default loop.
+//
+// Immediate tasks are queued and drained by a single uv_async_t, delayed tasks
+// are kept in a min-heap ordered by run time and backed by a single uv timer
+// armed for the earliest one.
 class UvTaskRunner : public base::SingleThreadTaskRunner {
  public:
   explicit UvTaskRunner(uv_loop_t* loop);
@@ -29,13 +36,43 @@ class UvTaskRunner : public base::SingleThreadTaskRunner {
                                   base::TimeDelta delay) override;
 
  private:
+  struct DelayedTask {
+    DelayedTask(base::TimeTicks run_time,
+                uint64_t sequence_num,
+                base::OnceClosure task);
+    DelayedTask(DelayedTask&& other);
+    ~DelayedTask();
+    DelayedTask& operator=(DelayedTask&& other);
+
+    // Orders the heap so that the earliest task, and for equal run times the
+    // first posted one, is on top.
+    bool operator<(const DelayedTask& other) const;
+
+    base::TimeTicks run_time;
+    uint64_t sequence_num;
+    base::OnceClosure task;
+  };
+
   ~UvTaskRunner() override;
+  static void OnAsync(uv_async_t* handle);
   static void OnTimeout(uv_timer_t* timer);
-  static void OnClose(uv_handle_t* handle);
+
+  void RunImmediateTasks();
+  void RunDelayedTasks();
+
+  // Arms the timer for the earliest delayed task, and keeps the loop alive
+  // only while there are tasks left to run.
+  void UpdateTimer();
+  void UpdateAsyncRef();
 
   uv_loop_t* loop_;
 
-  std::map<uv_timer_t*, base::OnceClosure> tasks_;
+  UvHandle<uv_async_t> async_;
+  UvHandle<uv_timer_t> timer_;
+
+  base::circular_deque<base::OnceClosure> immediate_tasks_;
+  std::vector<DelayedTask> delayed_tasks_;
+  uint64_t next_sequence_num_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(UvTaskRunner);
 };
@@ -0,0 +1,125 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/app/uv_task_runner.h"
+
+#include <map>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/timer/elapsed_timer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace electron {
+
+namespace {
+
+constexpr int kTaskCount = 100000;
+
+// The previous implementation, one heap allocated uv_timer_t per task, kept
+// here as the baseline of the posting benchmark.
+class TimerPerTaskRunner {
+ public:
+  explicit TimerPerTaskRunner(uv_loop_t* loop) : loop_(loop) {}
+
+  void PostDelayedTask(base::OnceClosure task, base::TimeDelta delay) {
+    auto* timer = new uv_timer_t;
+    timer->data = this;
+    uv_timer_init(loop_, timer);
+    uv_timer_start(timer, OnTimeout, delay.InMilliseconds(), 0);
+    tasks_[timer] = std::move(task);
+  }
+
+ private:
+  static void OnTimeout(uv_timer_t* timer) {
+    auto& tasks = static_cast<TimerPerTaskRunner*>(timer->data)->tasks_;
+    auto iter = tasks.find(timer);
+    std::move(iter->second).Run();
+    tasks.erase(iter);
+    uv_close(reinterpret_cast<uv_handle_t*>(timer), [](uv_handle_t* handle) {
+      delete reinterpret_cast<uv_timer_t*>(handle);
+    });
+  }
+
+  uv_loop_t* loop_;
+  std::map<uv_timer_t*, base::OnceClosure> tasks_;
+};
+
+class UvTaskRunnerTest : public testing::Test {
+ protected:
+  void SetUp() override { ASSERT_EQ(0, uv_loop_init(&loop_)); }
+
+  void TearDown() override {
+    uv_run(&loop_, UV_RUN_DEFAULT);
+    ASSERT_EQ(0, uv_loop_close(&loop_));
+  }
+
+  uv_loop_t loop_;
+};
+
+}  // namespace
+
+TEST_F(UvTaskRunnerTest, RunsImmediateTasksInOrder) {
+  std::vector<int> order;
+  {
+    auto runner = base::MakeRefCounted<UvTaskRunner>(&loop_);
+    for (int i = 0; i < 3; ++i) {
+      runner->PostTask(FROM_HERE, base::BindOnce(
+                                      [](std::vector<int>* order, int i) {
+                                        order->push_back(i);
+                                      },
+                                      &order, i));
+    }
+    uv_run(&loop_, UV_RUN_DEFAULT);
+  }
+  EXPECT_EQ((std::vector<int>{0, 1, 2}), order);
+}
+
+TEST_F(UvTaskRunnerTest, RunsDelayedTasksByRunTime) {
+  std::vector<int> order;
+  {
+    auto runner = base::MakeRefCounted<UvTaskRunner>(&loop_);
+    auto push = [](std::vector<int>* order, int i) { order->push_back(i); };
+    runner->PostDelayedTask(FROM_HERE, base::BindOnce(push, &order, 2),
+                            base::TimeDelta::FromMilliseconds(20));
+    runner->PostDelayedTask(FROM_HERE, base::BindOnce(push, &order, 1),
+                            base::TimeDelta::FromMilliseconds(5));
+    runner->PostTask(FROM_HERE, base::BindOnce(push, &order, 0));
+    uv_run(&loop_, UV_RUN_DEFAULT);
+  }
+  EXPECT_EQ((std::vector<int>{0, 1, 2}), order);
+}
+
+TEST_F(UvTaskRunnerTest, PostingThroughput) {
+  int ran = 0;
+  auto count = [](int* ran) { ++*ran; };
+
+  base::ElapsedTimer baseline_timer;
+  {
+    TimerPerTaskRunner baseline(&loop_);
+    for (int i = 0; i < kTaskCount; ++i)
+      baseline.PostDelayedTask(base::BindOnce(count, &ran), base::TimeDelta());
+    uv_run(&loop_, UV_RUN_DEFAULT);
+  }
+  base::TimeDelta baseline_elapsed = baseline_timer.Elapsed();
+  ASSERT_EQ(kTaskCount, ran);
+
+  ran = 0;
+  base::ElapsedTimer runner_timer;
+  {
+    auto runner = base::MakeRefCounted<UvTaskRunner>(&loop_);
+    for (int i = 0; i < kTaskCount; ++i)
+      runner->PostTask(FROM_HERE, base::BindOnce(count, &ran));
+    uv_run(&loop_, UV_RUN_DEFAULT);
+  }
+  base::TimeDelta runner_elapsed = runner_timer.Elapsed();
+  ASSERT_EQ(kTaskCount, ran);
+
+  LOG(INFO) << "Posted and ran " << kTaskCount << " tasks: timer per task "
+            << baseline_elapsed.InMillisecondsF() << "ms, UvTaskRunner "
+            << runner_elapsed.InMillisecondsF() << "ms";
+}
+
+}  // namespace electron
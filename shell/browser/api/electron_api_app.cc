@@ -627,6 +627,10 @@ void App::OnWindowAllClosed() {
 }
 
 void App::OnQuit() {
+  // Stop the watchdog before shutdown starts tearing down the isolate it
+  // interrupts. Stalls while quitting are not reported either.
+  watchdog_.reset();
+
   int exitCode = ElectronBrowserMainParts::Get()->GetExitCode();
   Emit("quit", exitCode);
 
@@ -1464,6 +1468,37 @@ bool App::CanBrowserClientUseCustomSiteInstance() {
   return ElectronBrowserClient::Get()->CanUseCustomSiteInstance();
 }
 
+void App::EnableStallDetection(gin_helper::ErrorThrower thrower,
+                               gin::Arguments* args) {
+  int threshold = 1000;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("threshold", &threshold);
+  if (threshold <= 0) {
+    thrower.ThrowRangeError("threshold must be a positive number");
+    return;
+  }
+
+  watchdog_ = std::make_unique<MainThreadWatchdog>(
+      JavascriptEnvironment::GetIsolate(),
+      base::TimeDelta::FromMilliseconds(threshold),
+      base::BindRepeating(&App::OnMainThreadStall, base::Unretained(this)));
+}
+
+void App::DisableStallDetection() {
+  watchdog_.reset();
+}
+
+void App::OnMainThreadStall(const MainThreadWatchdog::Stall& stall) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  gin_helper::Dictionary details = gin::Dictionary::CreateEmpty(isolate);
+  details.Set("duration", stall.duration.InMillisecondsF());
+  details.Set("stack", stall.stack);
+  details.Set("activity", stall.activity);
+  Emit("main-thread-stall", details);
+}
+
 #if defined(OS_MAC)
 bool App::MoveToApplicationsFolder(gin_helper::ErrorThrower thrower,
                                    gin::Arguments* args) {
@@ -1666,6 +1701,8 @@ gin::ObjectTemplateBuilder App::GetObjectTemplateBuilder(v8::Isolate* isolate) {
       .SetProperty("userAgentFallback", &App::GetUserAgentFallback,
                    &App::SetUserAgentFallback)
       .SetMethod("enableSandbox", &App::EnableSandbox)
+      .SetMethod("enableStallDetection", &App::EnableStallDetection)
+      .SetMethod("disableStallDetection", &App::DisableStallDetection)
       .SetProperty("allowRendererProcessReuse",
                    &App::CanBrowserClientUseCustomSiteInstance,
                    &App::SetBrowserClientCanUseCustomSiteInstance);
@@ -26,6 +26,7 @@
 #include "shell/browser/browser_observer.h"
 #include "shell/browser/electron_browser_client.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/browser/main_thread_watchdog.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
@@ -215,6 +216,10 @@ class App : public ElectronBrowserClient::Delegate,
   std::string GetUserAgentFallback();
   void SetBrowserClientCanUseCustomSiteInstance(bool should_disable);
   bool CanBrowserClientUseCustomSiteInstance();
+  void EnableStallDetection(gin_helper::ErrorThrower thrower,
+                            gin::Arguments* args);
+  void DisableStallDetection();
+  void OnMainThreadStall(const MainThreadWatchdog::Stall& stall);
 
 #if defined(OS_MAC)
   void SetActivationPolicy(gin_helper::ErrorThrower thrower,
@@ -250,6 +255,8 @@ class App : public ElectronBrowserClient::Delegate,
 
   base::FilePath app_path_;
 
+  std::unique_ptr<MainThreadWatchdog> watchdog_;
+
   using ProcessMetricMap =
       std::map<int, std::unique_ptr<electron::ProcessMetric>>;
   ProcessMetricMap app_metrics_;
@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/trace_event/trace_event.h"
 #include "electron/buildflags/buildflags.h"
 #include "gin/dictionary.h"
 #include "shell/browser/api/electron_api_browser_view.h"
@@ -77,6 +78,7 @@ v8::Local<v8::Value> ToBuffer(v8::Isolate* isolate, void* val, int size) {
 
 BaseWindow::BaseWindow(v8::Isolate* isolate,
                        const gin_helper::Dictionary& options) {
+  TRACE_EVENT0("electron.window", "BaseWindow::BaseWindow");
   // The parent window.
   gin::Handle<BaseWindow> parent;
   if (options.Get("parent", &parent) && !parent.IsEmpty())
@@ -110,6 +112,7 @@ BaseWindow::BaseWindow(gin_helper::Arguments* args,
     : BaseWindow(args->isolate(), options) {
   InitWithArgs(args);
   // Init window after everything has been setup.
+  TRACE_EVENT0("electron.window", "NativeWindow::InitFromOptions");
   window()->InitFromOptions(options);
 }
 
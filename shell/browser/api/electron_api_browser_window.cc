@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"  // nogncheck
 #include "content/browser/renderer_host/render_widget_host_owner_delegate.h"  // nogncheck
 #include "content/browser/web_contents/web_contents_impl.h"  // nogncheck
@@ -358,8 +359,8 @@ void BrowserWindow::SetBackgroundColor(const std::string& color_name) {
     auto* web_preferences =
         WebContentsPreferences::From(api_web_contents_->web_contents());
     if (web_preferences) {
-      web_preferences->preference()->SetStringKey(options::kBackgroundColor,
-                                                  color_name);
+      web_preferences->SetPreference(options::kBackgroundColor,
+                                     base::Value(color_name));
     }
   }
 }
@@ -469,6 +470,7 @@ void BrowserWindow::OnWindowHide() {
 // static
 gin_helper::WrappableBase* BrowserWindow::New(gin_helper::ErrorThrower thrower,
                                               gin::Arguments* args) {
+  TRACE_EVENT0("electron.window", "BrowserWindow::New");
   if (!Browser::Get()->is_ready()) {
     thrower.ThrowError("Cannot create BrowserWindow before app is ready");
     return nullptr;
@@ -9,7 +9,9 @@
 
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "content/public/browser/download_item_utils.h"
 #include "net/base/filename_util.h"
+#include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/common/gin_converters/file_dialog_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
@@ -84,7 +86,9 @@ DownloadItem* DownloadItem::FromDownloadItem(
 
 DownloadItem::DownloadItem(v8::Isolate* isolate,
                            download::DownloadItem* download_item)
-    : download_item_(download_item), isolate_(isolate) {
+    : download_item_(download_item),
+      last_state_(download_item->GetState()),
+      isolate_(isolate) {
   download_item_->AddObserver(this);
   download_item_->SetUserData(
       kElectronApiDownloadItemKey,
@@ -111,10 +115,21 @@ bool DownloadItem::CheckAlive() const {
 void DownloadItem::OnDownloadUpdated(download::DownloadItem* item) {
   if (!CheckAlive())
     return;
+  // A resumed download restarts the session's progress timer, which stops
+  // once no download is in progress.
+  download::DownloadItem::DownloadState state = item->GetState();
+  if (state == download::DownloadItem::IN_PROGRESS && state != last_state_) {
+    auto* session = Session::FromBrowserContext(
+        content::DownloadItemUtils::GetBrowserContext(item));
+    if (session)
+      session->UpdateDownloadProgressTimer();
+  }
+  last_state_ = state;
+
   if (download_item_->IsDone()) {
     Emit("done", item->GetState());
     Unpin();
-  } else {
+  } else if (emit_updates_) {
     Emit("updated", item->GetState());
   }
 }
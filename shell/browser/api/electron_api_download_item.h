@@ -43,6 +43,10 @@ class DownloadItem : public gin::Wrappable<DownloadItem>,
   base::FilePath GetSavePath() const;
   file_dialog::DialogSettings GetSaveDialogOptions() const;
 
+  // Whether "updated" is emitted for every progress update. Sessions that
+  // aggregate progress turn this off.
+  void set_emit_updates(bool emit_updates) { emit_updates_ = emit_updates; }
+
  private:
   DownloadItem(v8::Isolate* isolate, download::DownloadItem* download_item);
   ~DownloadItem() override;
@@ -77,6 +81,8 @@ class DownloadItem : public gin::Wrappable<DownloadItem>,
   base::FilePath save_path_;
   file_dialog::DialogSettings dialog_options_;
   download::DownloadItem* download_item_;
+  download::DownloadItem::DownloadState last_state_;
+  bool emit_updates_ = true;
 
   v8::Isolate* isolate_;
 
@@ -7,6 +7,7 @@
 #include <map>
 #include <utility>
 
+#include "base/trace_event/trace_event.h"
 #include "shell/browser/api/ui_event.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/native_window.h"
@@ -84,19 +85,29 @@ bool InvokeBoolMethod(const Menu* menu,
   return gin::ConvertFromV8(isolate, val, &ret) ? ret : default_value;
 }
 
+// Items pushed through setItemState() are answered from the model; only items
+// that opted into dynamic state are queried from JS.
 bool Menu::IsCommandIdChecked(int command_id) const {
+  if (const auto* state = model_->GetItemState(command_id))
+    return state->checked;
   return InvokeBoolMethod(this, "_isCommandIdChecked", command_id);
 }
 
 bool Menu::IsCommandIdEnabled(int command_id) const {
+  if (const auto* state = model_->GetItemState(command_id))
+    return state->enabled;
   return InvokeBoolMethod(this, "_isCommandIdEnabled", command_id);
 }
 
 bool Menu::IsCommandIdVisible(int command_id) const {
+  if (const auto* state = model_->GetItemState(command_id))
+    return state->visible;
   return InvokeBoolMethod(this, "_isCommandIdVisible", command_id);
 }
 
 bool Menu::ShouldCommandIdWorkWhenHidden(int command_id) const {
+  if (const auto* state = model_->GetItemState(command_id))
+    return state->works_when_hidden;
   return InvokeBoolMethod(this, "_shouldCommandIdWorkWhenHidden", command_id);
 }
 
@@ -104,6 +115,17 @@ bool Menu::GetAcceleratorForCommandIdWithParams(
     int command_id,
     bool use_default_accelerator,
     ui::Accelerator* accelerator) const {
+  if (const auto* state = model_->GetItemState(command_id)) {
+    if (state->accelerator) {
+      *accelerator = *state->accelerator;
+      return true;
+    }
+    if (use_default_accelerator && state->default_accelerator) {
+      *accelerator = *state->default_accelerator;
+      return true;
+    }
+    return false;
+  }
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   v8::Local<v8::Value> val = gin_helper::CallMethod(
@@ -113,6 +135,8 @@ bool Menu::GetAcceleratorForCommandIdWithParams(
 }
 
 bool Menu::ShouldRegisterAcceleratorForCommandId(int command_id) const {
+  if (const auto* state = model_->GetItemState(command_id))
+    return state->register_accelerator;
   return InvokeBoolMethod(this, "_shouldRegisterAcceleratorForCommandId",
                           command_id);
 }
@@ -138,6 +162,7 @@ void Menu::ExecuteCommand(int command_id, int flags) {
 }
 
 void Menu::OnMenuWillShow(ui::SimpleMenuModel* source) {
+  TRACE_EVENT0("electron.menu", "Menu::OnMenuWillShow");
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   gin_helper::CallMethod(isolate, const_cast<Menu*>(this), "_menuWillShow");
@@ -208,6 +233,21 @@ void Menu::SetRole(int index, const std::u16string& role) {
   model_->SetRole(index, role);
 }
 
+void Menu::SetItemState(int command_id, const gin_helper::Dictionary& dict) {
+  ElectronMenuModel::ItemState state;
+  dict.Get("checked", &state.checked);
+  dict.Get("enabled", &state.enabled);
+  dict.Get("visible", &state.visible);
+  dict.Get("acceleratorWorksWhenHidden", &state.works_when_hidden);
+  dict.Get("registerAccelerator", &state.register_accelerator);
+  ui::Accelerator accelerator;
+  if (dict.Get("accelerator", &accelerator))
+    state.accelerator = accelerator;
+  if (dict.Get("defaultAccelerator", &accelerator))
+    state.default_accelerator = accelerator;
+  model_->SetItemState(command_id, state);
+}
+
 void Menu::Clear() {
   model_->Clear();
 }
@@ -282,6 +322,7 @@ v8::Local<v8::ObjectTemplate> Menu::FillObjectTemplate(
       .SetMethod("setSublabel", &Menu::SetSublabel)
       .SetMethod("setToolTip", &Menu::SetToolTip)
       .SetMethod("setRole", &Menu::SetRole)
+      .SetMethod("setItemState", &Menu::SetItemState)
       .SetMethod("clear", &Menu::Clear)
       .SetMethod("getIndexOfCommandId", &Menu::GetIndexOfCommandId)
       .SetMethod("getItemCount", &Menu::GetItemCount)
@@ -14,6 +14,7 @@
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/browser/ui/electron_menu_model.h"
 #include "shell/common/gin_helper/constructible.h"
+#include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/pinnable.h"
 
 namespace electron {
@@ -104,6 +105,7 @@ class Menu : public gin::Wrappable<Menu>,
   void SetSublabel(int index, const std::u16string& sublabel);
   void SetToolTip(int index, const std::u16string& toolTip);
   void SetRole(int index, const std::u16string& role);
+  void SetItemState(int command_id, const gin_helper::Dictionary& state);
   void Clear();
   int GetIndexOfCommandId(int command_id);
   int GetItemCount() const;
@@ -7,6 +7,7 @@
 #include <memory>
 #include <utility>
 
+#include "base/trace_event/trace_event.h"
 #include "shell/browser/native_window_views.h"
 #include "shell/browser/unresponsive_suppressor.h"
 #include "ui/display/screen.h"
@@ -26,6 +27,7 @@ void MenuViews::PopupAt(BaseWindow* window,
                         int y,
                         int positioning_item,
                         base::OnceClosure callback) {
+  TRACE_EVENT0("electron.menu", "MenuViews::PopupAt");
   auto* native_window = static_cast<NativeWindowViews*>(window->window());
   if (!native_window)
     return;
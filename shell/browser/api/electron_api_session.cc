@@ -5,6 +5,7 @@
 #include "shell/browser/api/electron_api_session.h"
 
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <memory>
 #include <set>
@@ -33,6 +34,8 @@
 #include "content/public/browser/download_item_utils.h"
 #include "content/public/browser/download_manager_delegate.h"
 #include "content/public/browser/network_service_instance.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/storage_partition.h"
 #include "gin/arguments.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
@@ -52,6 +55,7 @@
 #include "shell/browser/api/electron_api_net_log.h"
 #include "shell/browser/api/electron_api_protocol.h"
 #include "shell/browser/api/electron_api_service_worker_context.h"
+#include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/api/electron_api_web_request.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/electron_browser_context.h"
@@ -61,11 +65,13 @@
 #include "shell/browser/media/media_device_id_salt.h"
 #include "shell/browser/net/cert_verifier_client.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/spare_renderer_pool.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/content_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
+#include "shell/common/gin_converters/time_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
@@ -182,6 +188,54 @@ struct Converter<ClearStorageDataOptions> {
   }
 };
 
+template <>
+struct Converter<electron::ElectronPermissionManager::CheckResult> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::ElectronPermissionManager::CheckResult* out) {
+    gin_helper::Dictionary dict;
+    if (!val->IsObject() || !ConvertFromV8(isolate, val, &dict)) {
+      out->granted = val->BooleanValue(isolate);
+      return true;
+    }
+    dict.Get("granted", &out->granted);
+    double cache_for = 0;
+    if (dict.Get("cacheFor", &cache_for)) {
+      if (std::isinf(cache_for) && cache_for > 0)
+        out->cache_lifetime = base::TimeDelta::Max();
+      else if (cache_for > 0)
+        out->cache_lifetime = base::TimeDelta::FromMillisecondsD(cache_for);
+    }
+    return true;
+  }
+};
+
+template <>
+struct Converter<electron::ElectronPermissionManager::DecisionStats> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::ElectronPermissionManager::DecisionStats& val) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("hits", static_cast<double>(val.hits));
+    dict.Set("misses", static_cast<double>(val.misses));
+    dict.Set("entries", static_cast<double>(val.entries));
+    return dict.GetHandle();
+  }
+};
+
+template <>
+struct Converter<electron::api::RendererMemoryManager::Candidate> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::api::RendererMemoryManager::Candidate& val) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("webContents", val.web_contents);
+    dict.Set("privateMemory", static_cast<double>(val.private_memory_kb));
+    dict.Set("lastActiveTime", val.last_active_time.ToJsTime());
+    return dict.GetHandle();
+  }
+};
+
 bool SSLProtocolVersionFromString(const std::string& version_str,
                                   network::mojom::SSLVersion* version) {
   if (version_str == switches::kSSLVersionTLSv1) {
@@ -383,6 +437,7 @@ void Session::OnDownloadCreated(content::DownloadManager* manager,
   v8::Locker locker(isolate_);
   v8::HandleScope handle_scope(isolate_);
   auto handle = DownloadItem::FromOrCreate(isolate_, item);
+  handle->set_emit_updates(emit_download_item_updates_);
   if (item->GetState() == download::DownloadItem::INTERRUPTED)
     handle->SetSavePath(item->GetTargetFilePath());
   content::WebContents* web_contents =
@@ -391,7 +446,9 @@ void Session::OnDownloadCreated(content::DownloadManager* manager,
   if (prevent_default) {
     item->Cancel(true);
     item->Remove();
+    return;
   }
+  UpdateDownloadProgressTimer();
 }
 
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
@@ -424,6 +481,33 @@ v8::Local<v8::Promise> Session::ResolveProxy(gin::Arguments* args) {
   return handle;
 }
 
+void Session::SetProxyResolverOptions(const gin_helper::Dictionary& options) {
+  auto* helper = browser_context_->GetResolveProxyHelper();
+  ResolveProxyHelper::Options resolver_options = helper->options();
+  int max_concurrent_lookups;
+  if (options.Get("maxConcurrentLookups", &max_concurrent_lookups) &&
+      max_concurrent_lookups > 0)
+    resolver_options.max_concurrent_lookups = max_concurrent_lookups;
+  double cache_ttl;
+  if (options.Get("cacheTTL", &cache_ttl) && cache_ttl >= 0)
+    resolver_options.cache_ttl = base::TimeDelta::FromMillisecondsD(cache_ttl);
+  helper->SetOptions(resolver_options);
+}
+
+v8::Local<v8::Value> Session::GetProxyResolverStats(v8::Isolate* isolate) {
+  const auto& stats = browser_context_->GetResolveProxyHelper()->stats();
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("lookups", static_cast<double>(stats.lookups));
+  dict.Set("cacheHits", static_cast<double>(stats.cache_hits));
+  dict.Set("pending", static_cast<double>(stats.pending));
+  dict.Set("inFlight", static_cast<double>(stats.in_flight));
+  dict.Set("averageLatency",
+           stats.lookups ? stats.total_latency.InMillisecondsF() / stats.lookups
+                         : 0.0);
+  dict.Set("maxLatency", stats.max_latency.InMillisecondsF());
+  return dict.GetHandle();
+}
+
 v8::Local<v8::Promise> Session::GetCacheSize() {
   gin_helper::Promise<int64_t> promise(isolate_);
   auto handle = promise.GetHandle();
@@ -547,6 +631,7 @@ v8::Local<v8::Promise> Session::SetProxy(gin::Arguments* args) {
   browser_context_->in_memory_pref_store()->SetValue(
       proxy_config::prefs::kProxy, std::move(proxy_config),
       WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  browser_context_->GetResolveProxyHelper()->ClearCache();
 
   base::ThreadTaskRunnerHandle::Get()->PostTask(
       FROM_HERE, base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
@@ -559,6 +644,7 @@ v8::Local<v8::Promise> Session::ForceReloadProxyConfig() {
   gin_helper::Promise<void> promise(isolate_);
   auto handle = promise.GetHandle();
 
+  browser_context_->GetResolveProxyHelper()->ClearCache();
   content::BrowserContext::GetDefaultStoragePartition(browser_context_)
       ->GetNetworkContext()
       ->ForceReloadProxyConfig(base::BindOnce(
@@ -657,6 +743,18 @@ void Session::SetPermissionCheckHandler(v8::Local<v8::Value> val,
   permission_manager->SetPermissionCheckHandler(handler);
 }
 
+void Session::ClearPermissionDecisions() {
+  auto* permission_manager = static_cast<ElectronPermissionManager*>(
+      browser_context()->GetPermissionControllerDelegate());
+  permission_manager->ClearPermissionDecisions();
+}
+
+ElectronPermissionManager::DecisionStats Session::GetPermissionDecisionStats() {
+  auto* permission_manager = static_cast<ElectronPermissionManager*>(
+      browser_context()->GetPermissionControllerDelegate());
+  return permission_manager->GetPermissionDecisionStats();
+}
+
 v8::Local<v8::Promise> Session::ClearHostResolverCache(gin::Arguments* args) {
   v8::Isolate* isolate = args->isolate();
   gin_helper::Promise<void> promise(isolate);
@@ -776,6 +874,212 @@ void Session::CreateInterruptedDownload(const gin_helper::Dictionary& options) {
       length, last_modified, etag, base::Time::FromDoubleT(start_time)));
 }
 
+void Session::SetDownloadProgressOptions(
+    const gin_helper::Dictionary& options) {
+  double interval_ms = 0;
+  if (options.Get("interval", &interval_ms))
+    download_progress_interval_ =
+        base::TimeDelta::FromMillisecondsD(std::max(interval_ms, 0.0));
+  options.Get("emitItemUpdates", &emit_download_item_updates_);
+
+  std::vector<download::DownloadItem*> items;
+  content::BrowserContext::GetDownloadManager(browser_context())
+      ->GetAllDownloads(&items);
+  for (auto* item : items) {
+    if (auto* api_item = DownloadItem::FromDownloadItem(item))
+      api_item->set_emit_updates(emit_download_item_updates_);
+  }
+
+  download_progress_timer_.Stop();
+  UpdateDownloadProgressTimer();
+}
+
+void Session::SetRendererMemoryBudget(gin_helper::ErrorThrower thrower,
+                                      v8::Local<v8::Value> val) {
+  if (val->IsNull()) {
+    renderer_memory_manager_.reset();
+    return;
+  }
+
+  gin_helper::Dictionary options;
+  double limit = 0;
+  if (!gin::ConvertFromV8(isolate_, val, &options) ||
+      !options.Get("limit", &limit) || limit <= 0) {
+    thrower.ThrowTypeError("Must pass an object with a positive limit");
+    return;
+  }
+
+  RendererMemoryManager::Options manager_options;
+  manager_options.budget_kb = static_cast<uint64_t>(limit);
+  double interval_ms = 0;
+  if (options.Get("interval", &interval_ms) && interval_ms > 0)
+    manager_options.interval = base::TimeDelta::FromMillisecondsD(interval_ms);
+  if (options.Has("policy") &&
+      !options.Get("policy", &manager_options.policy)) {
+    thrower.ThrowTypeError("policy must be a function");
+    return;
+  }
+
+  // Replacing the manager resets its metrics.
+  renderer_memory_manager_ = std::make_unique<RendererMemoryManager>(
+      browser_context_, manager_options);
+}
+
+v8::Local<v8::Value> Session::GetRendererMemoryMetrics(v8::Isolate* isolate) {
+  if (!renderer_memory_manager_)
+    return v8::Null(isolate);
+  const auto& metrics = renderer_memory_manager_->metrics();
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("usage", static_cast<double>(metrics.usage_kb));
+  dict.Set("limit",
+           static_cast<double>(renderer_memory_manager_->options().budget_kb));
+  dict.Set("pressureEvents", static_cast<double>(metrics.pressure_events));
+  dict.Set("systemPressureEvents",
+           static_cast<double>(metrics.system_pressure_events));
+  dict.Set("discards", static_cast<double>(metrics.discards));
+  dict.Set("restores", static_cast<double>(metrics.restores));
+  return dict.GetHandle();
+}
+
+void Session::SetSpareRendererOptions(const gin_helper::Dictionary& options) {
+  auto* pool = browser_context_->GetSpareRendererPool();
+  int count = static_cast<int>(pool->count());
+  int max_profiles = static_cast<int>(pool->max_profiles());
+  options.Get("count", &count);
+  options.Get("maxProfiles", &max_profiles);
+  pool->SetOptions(std::max(count, 0), std::max(max_profiles, 1));
+}
+
+v8::Local<v8::Value> Session::GetSpareRendererMetrics(v8::Isolate* isolate) {
+  auto* pool = browser_context_->GetSpareRendererPool();
+  const auto& metrics = pool->metrics();
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("spares", static_cast<double>(pool->GetSpareCount()));
+  dict.Set("launched", static_cast<double>(metrics.launched));
+  dict.Set("hits", static_cast<double>(metrics.hits));
+  dict.Set("misses", static_cast<double>(metrics.misses));
+  dict.Set("discarded", static_cast<double>(metrics.discarded));
+  if (metrics.first_paints_with_spare) {
+    dict.Set("firstPaintWithSpare",
+             metrics.first_paint_with_spare.InMillisecondsF() /
+                 metrics.first_paints_with_spare);
+  }
+  if (metrics.first_paints_without_spare) {
+    dict.Set("firstPaintWithoutSpare",
+             metrics.first_paint_without_spare.InMillisecondsF() /
+                 metrics.first_paints_without_spare);
+  }
+  return dict.GetHandle();
+}
+
+void Session::SetRendererSharingPolicy(const gin_helper::Dictionary& options) {
+  auto* prefs = SessionPreferences::FromBrowserContext(browser_context());
+  DCHECK(prefs);
+  auto policy = prefs->renderer_sharing_policy();
+  int max_renderers = static_cast<int>(policy.max_renderers);
+  int sharing_threshold = static_cast<int>(policy.sharing_threshold);
+  options.Get("maxRenderers", &max_renderers);
+  options.Get("sharingThreshold", &sharing_threshold);
+  policy.max_renderers = std::max(max_renderers, 0);
+  policy.sharing_threshold = std::max(sharing_threshold, 0);
+  prefs->set_renderer_sharing_policy(policy);
+}
+
+v8::Local<v8::Value> Session::GetRendererSharingMetrics(v8::Isolate* isolate) {
+  auto* prefs = SessionPreferences::FromBrowserContext(browser_context());
+  DCHECK(prefs);
+  std::set<int> renderers;
+  size_t pages = 0;
+  // Each page the policy placed in an existing renderer, and that is still
+  // there, would otherwise have a renderer of its own.
+  size_t processes_saved = 0;
+  for (auto* web_contents : WebContents::GetAll()) {
+    if (!web_contents->web_contents() ||
+        web_contents->GetBrowserContext() != browser_context())
+      continue;
+    content::RenderProcessHost* process =
+        web_contents->web_contents()->GetMainFrame()->GetProcess();
+    if (!process->IsInitializedAndNotDead())
+      continue;
+    renderers.insert(process->GetID());
+    pages++;
+    if (web_contents->shared_renderer_id() == process->GetID())
+      processes_saved++;
+  }
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("renderers", static_cast<double>(renderers.size()));
+  dict.Set("webContents", static_cast<double>(pages));
+  dict.Set("processesSaved", static_cast<double>(processes_saved));
+  dict.Set("sharedNavigations",
+           static_cast<double>(prefs->shared_navigations()));
+  return dict.GetHandle();
+}
+
+// The timer only runs while there are downloads in progress, so idle sessions
+// don't wake up the main thread.
+void Session::UpdateDownloadProgressTimer() {
+  if (download_progress_interval_.is_zero() ||
+      download_progress_timer_.IsRunning())
+    return;
+  download_progress_timer_.Start(FROM_HERE, download_progress_interval_,
+                                 this, &Session::EmitDownloadProgress);
+}
+
+void Session::EmitDownloadProgress() {
+  std::vector<download::DownloadItem*> items;
+  content::BrowserContext::GetDownloadManager(browser_context())
+      ->GetAllDownloads(&items);
+
+  v8::Locker locker(isolate_);
+  v8::HandleScope handle_scope(isolate_);
+  std::vector<v8::Local<v8::Value>> item_progress;
+  int64_t received_bytes = 0;
+  int64_t total_bytes = 0;
+  int64_t bytes_per_second = 0;
+  bool total_known = true;
+  for (auto* item : items) {
+    if (item->GetState() != download::DownloadItem::IN_PROGRESS ||
+        item->IsSavePackageDownload())
+      continue;
+    // Chromium already tracks a smoothed transfer rate and the time left for
+    // every download, so there is nothing to compute in JS.
+    int64_t speed = item->IsPaused() ? 0 : item->CurrentSpeed();
+    base::TimeDelta time_remaining;
+    bool has_time_remaining = item->TimeRemaining(&time_remaining);
+
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate_);
+    dict.Set("item", DownloadItem::FromOrCreate(isolate_, item));
+    dict.Set("receivedBytes", item->GetReceivedBytes());
+    dict.Set("totalBytes", item->GetTotalBytes());
+    dict.Set("bytesPerSecond", speed);
+    dict.Set("timeRemaining",
+             has_time_remaining ? time_remaining.InSecondsF() : -1.0);
+    item_progress.push_back(dict.GetHandle());
+
+    received_bytes += item->GetReceivedBytes();
+    total_bytes += item->GetTotalBytes();
+    bytes_per_second += speed;
+    total_known &= item->GetTotalBytes() > 0;
+  }
+
+  if (item_progress.empty()) {
+    download_progress_timer_.Stop();
+    return;
+  }
+
+  gin_helper::Dictionary progress = gin::Dictionary::CreateEmpty(isolate_);
+  progress.Set("items", item_progress);
+  progress.Set("receivedBytes", received_bytes);
+  progress.Set("totalBytes", total_bytes);
+  progress.Set("bytesPerSecond", bytes_per_second);
+  progress.Set("timeRemaining",
+               total_known && bytes_per_second > 0
+                   ? static_cast<double>(total_bytes - received_bytes) /
+                         bytes_per_second
+                   : -1.0);
+  Emit("download-progress", progress);
+}
+
 void Session::SetPreloads(const std::vector<base::FilePath>& preloads) {
   auto* prefs = SessionPreferences::FromBrowserContext(browser_context());
   DCHECK(prefs);
@@ -1141,6 +1445,8 @@ gin::ObjectTemplateBuilder Session::GetObjectTemplateBuilder(
   return gin_helper::EventEmitterMixin<Session>::GetObjectTemplateBuilder(
              isolate)
       .SetMethod("resolveProxy", &Session::ResolveProxy)
+      .SetMethod("setProxyResolverOptions", &Session::SetProxyResolverOptions)
+      .SetMethod("getProxyResolverStats", &Session::GetProxyResolverStats)
       .SetMethod("getCacheSize", &Session::GetCacheSize)
       .SetMethod("clearCache", &Session::ClearCache)
       .SetMethod("clearStorageData", &Session::ClearStorageData)
@@ -1155,6 +1461,10 @@ gin::ObjectTemplateBuilder Session::GetObjectTemplateBuilder(
                  &Session::SetPermissionRequestHandler)
       .SetMethod("setPermissionCheckHandler",
                  &Session::SetPermissionCheckHandler)
+      .SetMethod("clearPermissionDecisions",
+                 &Session::ClearPermissionDecisions)
+      .SetMethod("getPermissionDecisionStats",
+                 &Session::GetPermissionDecisionStats)
       .SetMethod("clearHostResolverCache", &Session::ClearHostResolverCache)
       .SetMethod("clearAuthCache", &Session::ClearAuthCache)
       .SetMethod("allowNTLMCredentialsForDomains",
@@ -1167,6 +1477,16 @@ gin::ObjectTemplateBuilder Session::GetObjectTemplateBuilder(
       .SetMethod("downloadURL", &Session::DownloadURL)
       .SetMethod("createInterruptedDownload",
                  &Session::CreateInterruptedDownload)
+      .SetMethod("setDownloadProgressOptions",
+                 &Session::SetDownloadProgressOptions)
+      .SetMethod("setRendererMemoryBudget", &Session::SetRendererMemoryBudget)
+      .SetMethod("getRendererMemoryMetrics",
+                 &Session::GetRendererMemoryMetrics)
+      .SetMethod("setSpareRendererOptions", &Session::SetSpareRendererOptions)
+      .SetMethod("getSpareRendererMetrics", &Session::GetSpareRendererMetrics)
+      .SetMethod("setRendererSharingPolicy", &Session::SetRendererSharingPolicy)
+      .SetMethod("getRendererSharingMetrics",
+                 &Session::GetRendererSharingMetrics)
       .SetMethod("setPreloads", &Session::SetPreloads)
       .SetMethod("getPreloads", &Session::GetPreloads)
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
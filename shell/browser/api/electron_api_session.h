@@ -5,15 +5,19 @@
 #ifndef SHELL_BROWSER_API_ELECTRON_API_SESSION_H_
 #define SHELL_BROWSER_API_ELECTRON_API_SESSION_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "content/public/browser/download_manager.h"
 #include "electron/buildflags/buildflags.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "services/network/public/mojom/ssl_config.mojom.h"
+#include "shell/browser/api/renderer_memory_manager.h"
+#include "shell/browser/electron_permission_manager.h"
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/browser/net/resolve_proxy_helper.h"
 #include "shell/common/gin_helper/cleaned_up_at_exit.h"
@@ -90,6 +94,8 @@ class Session : public gin::Wrappable<Session>,
 
   // Methods.
   v8::Local<v8::Promise> ResolveProxy(gin::Arguments* args);
+  void SetProxyResolverOptions(const gin_helper::Dictionary& options);
+  v8::Local<v8::Value> GetProxyResolverStats(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetCacheSize();
   v8::Local<v8::Promise> ClearCache();
   v8::Local<v8::Promise> ClearStorageData(gin::Arguments* args);
@@ -104,6 +110,8 @@ class Session : public gin::Wrappable<Session>,
                                    gin::Arguments* args);
   void SetPermissionCheckHandler(v8::Local<v8::Value> val,
                                  gin::Arguments* args);
+  void ClearPermissionDecisions();
+  ElectronPermissionManager::DecisionStats GetPermissionDecisionStats();
   v8::Local<v8::Promise> ClearHostResolverCache(gin::Arguments* args);
   v8::Local<v8::Promise> ClearAuthCache();
   void AllowNTLMCredentialsForDomains(const std::string& domains);
@@ -115,6 +123,16 @@ class Session : public gin::Wrappable<Session>,
                                      const std::string& uuid);
   void DownloadURL(const GURL& url);
   void CreateInterruptedDownload(const gin_helper::Dictionary& options);
+  void SetDownloadProgressOptions(const gin_helper::Dictionary& options);
+  // Starts the "download-progress" timer if a download may be in progress.
+  void UpdateDownloadProgressTimer();
+  void SetRendererMemoryBudget(gin_helper::ErrorThrower thrower,
+                               v8::Local<v8::Value> val);
+  v8::Local<v8::Value> GetRendererMemoryMetrics(v8::Isolate* isolate);
+  void SetSpareRendererOptions(const gin_helper::Dictionary& options);
+  v8::Local<v8::Value> GetSpareRendererMetrics(v8::Isolate* isolate);
+  void SetRendererSharingPolicy(const gin_helper::Dictionary& options);
+  v8::Local<v8::Value> GetRendererSharingMetrics(v8::Isolate* isolate);
   void SetPreloads(const std::vector<base::FilePath>& preloads);
   std::vector<base::FilePath> GetPreloads() const;
   v8::Local<v8::Value> Cookies(v8::Isolate* isolate);
@@ -183,6 +201,17 @@ class Session : public gin::Wrappable<Session>,
   // The client id to enable the network throttler.
   base::UnguessableToken network_emulation_token_;
 
+  // Emits the aggregated "download-progress" event.
+  void EmitDownloadProgress();
+
+  // Aggregated download progress, see setDownloadProgressOptions().
+  base::TimeDelta download_progress_interval_;
+  bool emit_download_item_updates_ = true;
+  base::RepeatingTimer download_progress_timer_;
+
+  // Discards hidden webContents, see setRendererMemoryBudget().
+  std::unique_ptr<RendererMemoryManager> renderer_memory_manager_;
+
   ElectronBrowserContext* browser_context_;
 
   DISALLOW_COPY_AND_ASSIGN(Session);
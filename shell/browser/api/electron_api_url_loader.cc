@@ -5,6 +5,7 @@
 #include "shell/browser/api/electron_api_url_loader.h"
 
 #include <algorithm>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -12,21 +13,33 @@
 #include <vector>
 
 #include "base/containers/id_map.h"
+#include "base/files/file.h"
+#include "base/files/file_util.h"
 #include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
+#include "crypto/secure_hash.h"
+#include "crypto/sha2.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/receiver_set.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "net/base/load_flags.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/simple_url_loader.h"
 #include "services/network/public/mojom/chunked_data_pipe_getter.mojom.h"
+#include "services/network/public/mojom/data_pipe_getter.mojom.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -76,12 +89,15 @@ namespace api {
 
 namespace {
 
+// Reads straight out of a V8 BackingStore. Holding a reference to the
+// BackingStore keeps the memory alive for as long as the pipe write is in
+// flight, even if the ArrayBuffer itself is collected, so the body never has
+// to be copied into an intermediate buffer.
 class BufferDataSource : public mojo::DataPipeProducer::DataSource {
  public:
-  explicit BufferDataSource(base::span<char> buffer) {
-    buffer_.resize(buffer.size());
-    memcpy(buffer_.data(), buffer.data(), buffer_.size());
-  }
+  BufferDataSource(std::shared_ptr<v8::BackingStore> backing_store,
+                   base::span<const char> buffer)
+      : backing_store_(std::move(backing_store)), buffer_(buffer) {}
   ~BufferDataSource() override = default;
 
  private:
@@ -104,7 +120,62 @@ class BufferDataSource : public mojo::DataPipeProducer::DataSource {
     return result;
   }
 
-  std::vector<char> buffer_;
+  std::shared_ptr<v8::BackingStore> backing_store_;
+  base::span<const char> buffer_;
+};
+
+// Serves an ArrayBufferView request body to the network service through a
+// data pipe. Unlike ResourceRequestBody::CreateFromBytes this doesn't copy the
+// body up front, and it can be read again if the request is redirected.
+// Deletes itself once the network service drops every connection to it.
+class BufferDataPipeGetter : public network::mojom::DataPipeGetter {
+ public:
+  static mojo::PendingRemote<network::mojom::DataPipeGetter> Create(
+      std::shared_ptr<v8::BackingStore> backing_store,
+      base::span<const char> buffer) {
+    mojo::PendingRemote<network::mojom::DataPipeGetter> remote;
+    auto* getter = new BufferDataPipeGetter(std::move(backing_store), buffer);
+    getter->Clone(remote.InitWithNewPipeAndPassReceiver());
+    return remote;
+  }
+
+  ~BufferDataPipeGetter() override = default;
+
+ private:
+  BufferDataPipeGetter(std::shared_ptr<v8::BackingStore> backing_store,
+                       base::span<const char> buffer)
+      : backing_store_(std::move(backing_store)), buffer_(buffer) {
+    receivers_.set_disconnect_handler(base::BindRepeating(
+        &BufferDataPipeGetter::OnDisconnect, base::Unretained(this)));
+  }
+
+  // network::mojom::DataPipeGetter:
+  void Read(mojo::ScopedDataPipeProducerHandle pipe,
+            ReadCallback callback) override {
+    std::move(callback).Run(net::OK, buffer_.size());
+    auto producer = std::make_unique<mojo::DataPipeProducer>(std::move(pipe));
+    auto* raw_producer = producer.get();
+    raw_producer->Write(
+        std::make_unique<BufferDataSource>(backing_store_, buffer_),
+        base::BindOnce(
+            [](std::unique_ptr<mojo::DataPipeProducer> producer,
+               MojoResult result) {},
+            std::move(producer)));
+  }
+
+  void Clone(
+      mojo::PendingReceiver<network::mojom::DataPipeGetter> receiver) override {
+    receivers_.Add(this, std::move(receiver));
+  }
+
+  void OnDisconnect() {
+    if (receivers_.empty())
+      delete this;
+  }
+
+  std::shared_ptr<v8::BackingStore> backing_store_;
+  base::span<const char> buffer_;
+  mojo::ReceiverSet<network::mojom::DataPipeGetter> receivers_;
 };
 
 class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
@@ -190,9 +261,10 @@ class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
     bytes_written_ += buffer->ByteLength();
     auto backing_store = buffer->Buffer()->GetBackingStore();
     auto buffer_span = base::make_span(
-        static_cast<char*>(backing_store->Data()) + buffer->ByteOffset(),
+        static_cast<const char*>(backing_store->Data()) + buffer->ByteOffset(),
         buffer->ByteLength());
-    auto buffer_source = std::make_unique<BufferDataSource>(buffer_span);
+    auto buffer_source = std::make_unique<BufferDataSource>(
+        std::move(backing_store), buffer_span);
     data_producer_->Write(
         std::move(buffer_source),
         base::BindOnce(&JSChunkedDataPipeGetter::OnWriteChunkComplete,
@@ -260,6 +332,35 @@ const net::NetworkTrafficAnnotationTag kTrafficAnnotation =
           setting: "This feature cannot be disabled."
         })");
 
+// Bodies up to this size are copied into the request, so that webRequest and
+// protocol handlers still see them as bytes. Larger ones are served through a
+// BufferDataPipeGetter and show up as blobs.
+constexpr size_t kMaxCopiedUploadBodySize = 1024 * 1024;
+
+// Hashes |path| in fixed size chunks so that large downloads never have to be
+// held in memory. Runs on a blocking-capable pool thread.
+std::string ComputeFileSHA256(const base::FilePath& path) {
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return std::string();
+
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  std::vector<char> buffer(64 * 1024);
+  while (true) {
+    int bytes_read = file.ReadAtCurrentPos(buffer.data(), buffer.size());
+    if (bytes_read < 0)
+      return std::string();
+    if (bytes_read == 0)
+      break;
+    hash->Update(buffer.data(), bytes_read);
+  }
+
+  uint8_t digest[crypto::kSHA256Length];
+  hash->Finish(digest, sizeof(digest));
+  return base::HexEncode(digest, sizeof(digest));
+}
+
 base::IDMap<SimpleURLLoaderWrapper*>& GetAllRequests() {
   static base::NoDestructor<base::IDMap<SimpleURLLoaderWrapper*>>
       s_all_requests;
@@ -274,8 +375,14 @@ gin::WrapperInfo SimpleURLLoaderWrapper::kWrapperInfo = {
 SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
     std::unique_ptr<network::ResourceRequest> request,
     network::mojom::URLLoaderFactory* url_loader_factory,
-    int options)
-    : id_(GetAllRequests().Add(this)) {
+    int options,
+    const DownloadOptions& download_options)
+    : id_(GetAllRequests().Add(this)), download_options_(download_options) {
+  // The span ends in Finish() or Cancel(), whichever comes first.
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN2("electron.loader", "SimpleURLLoaderWrapper",
+                                    TRACE_ID_LOCAL(this), "url",
+                                    request->url.spec(), "method",
+                                    request->method);
   // We slightly abuse the |render_frame_id| field in ResourceRequest so that
   // we can correlate any authentication events that arrive with this request.
   request->render_frame_id = id_;
@@ -301,7 +408,21 @@ SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
   loader_->SetOnDownloadProgressCallback(base::BindRepeating(
       &SimpleURLLoaderWrapper::OnDownloadProgress, base::Unretained(this)));
 
-  loader_->DownloadAsStream(url_loader_factory, this);
+  if (!download_options_.file_path.empty()) {
+    loader_->DownloadToFile(
+        url_loader_factory,
+        base::BindOnce(&SimpleURLLoaderWrapper::OnDownloadedToFile,
+                       base::Unretained(this)),
+        download_options_.file_path);
+  } else if (download_options_.to_buffer) {
+    loader_->DownloadToString(
+        url_loader_factory,
+        base::BindOnce(&SimpleURLLoaderWrapper::OnDownloadedToString,
+                       base::Unretained(this)),
+        download_options_.max_buffer_size);
+  } else {
+    loader_->DownloadAsStream(url_loader_factory, this);
+  }
 }
 
 void SimpleURLLoaderWrapper::Pin() {
@@ -357,6 +478,10 @@ void SimpleURLLoaderWrapper::OnAuthRequired(
 }
 
 void SimpleURLLoaderWrapper::Cancel() {
+  if (loader_) {
+    TRACE_EVENT_NESTABLE_ASYNC_END1("electron.loader", "SimpleURLLoaderWrapper",
+                                    TRACE_ID_LOCAL(this), "canceled", true);
+  }
   loader_.reset();
   pinned_wrapper_.Reset();
   pinned_chunk_pipe_getter_.Reset();
@@ -481,9 +606,19 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
     if (body->IsArrayBufferView()) {
       auto buffer_body = body.As<v8::ArrayBufferView>();
       auto backing_store = buffer_body->Buffer()->GetBackingStore();
-      request->request_body = network::ResourceRequestBody::CreateFromBytes(
-          static_cast<char*>(backing_store->Data()) + buffer_body->ByteOffset(),
+      auto buffer_span = base::make_span(
+          static_cast<const char*>(backing_store->Data()) +
+              buffer_body->ByteOffset(),
           buffer_body->ByteLength());
+      request->request_body =
+          base::MakeRefCounted<network::ResourceRequestBody>();
+      if (buffer_span.size() <= kMaxCopiedUploadBodySize) {
+        request->request_body->AppendBytes(
+            buffer_span.data(), static_cast<int>(buffer_span.size()));
+      } else {
+        request->request_body->AppendDataPipe(BufferDataPipeGetter::Create(
+            std::move(backing_store), buffer_span));
+      }
     } else if (body->IsFunction()) {
       auto body_func = body.As<v8::Function>();
 
@@ -498,6 +633,23 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
       request->request_body->SetToChunkedDataPipe(
           std::move(data_pipe_getter),
           network::ResourceRequestBody::ReadOnlyOnce(false));
+    } else if (body->IsObject()) {
+      // { path, offset, length }: the network service reads the file itself,
+      // so the body never passes through this process.
+      gin_helper::Dictionary file_body(args->isolate(), body.As<v8::Object>());
+      base::FilePath path;
+      if (!file_body.Get("path", &path) || path.empty()) {
+        args->ThrowTypeError("Expected body.path to be a string");
+        return gin::Handle<SimpleURLLoaderWrapper>();
+      }
+      uint64_t offset = 0;
+      uint64_t length = std::numeric_limits<uint64_t>::max();
+      file_body.Get("offset", &offset);
+      file_body.Get("length", &length);
+      request->request_body =
+          base::MakeRefCounted<network::ResourceRequestBody>();
+      request->request_body->AppendFileRange(path, offset, length,
+                                             base::Time());
     }
   }
 
@@ -510,12 +662,41 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
       session = Session::FromPartition(args->isolate(), "");
   }
 
+  DownloadOptions download_options;
+  opts.Get("downloadToFile", &download_options.file_path);
+  opts.Get("downloadHash", &download_options.expected_sha256);
+  opts.Get("downloadToBuffer", &download_options.to_buffer);
+  double max_buffer_size =
+      network::SimpleURLLoader::kMaxBoundedStringDownloadSize;
+  if (opts.Get("downloadMaxSize", &max_buffer_size) &&
+      (max_buffer_size <= 0 ||
+       max_buffer_size >
+           network::SimpleURLLoader::kMaxBoundedStringDownloadSize)) {
+    args->ThrowTypeError(base::StringPrintf(
+        "downloadMaxSize must be between 1 and %zu, use downloadToFile for "
+        "larger bodies",
+        network::SimpleURLLoader::kMaxBoundedStringDownloadSize));
+    return gin::Handle<SimpleURLLoaderWrapper>();
+  }
+  download_options.max_buffer_size = static_cast<size_t>(max_buffer_size);
+  double progress_interval_ms = 0;
+  if (opts.Get("progressInterval", &progress_interval_ms) &&
+      progress_interval_ms > 0) {
+    download_options.progress_interval =
+        base::TimeDelta::FromMillisecondsD(progress_interval_ms);
+  }
+  if (!download_options.expected_sha256.empty() &&
+      download_options.file_path.empty()) {
+    args->ThrowTypeError("downloadHash requires downloadToFile");
+    return gin::Handle<SimpleURLLoaderWrapper>();
+  }
+
   auto url_loader_factory = session->browser_context()->GetURLLoaderFactory();
 
   auto ret = gin::CreateHandle(
       args->isolate(),
       new SimpleURLLoaderWrapper(std::move(request), url_loader_factory.get(),
-                                 options));
+                                 options, download_options));
   ret->Pin();
   if (!chunk_pipe_getter.IsEmpty()) {
     ret->PinBodyGetter(chunk_pipe_getter);
@@ -537,10 +718,96 @@ void SimpleURLLoaderWrapper::OnDataReceived(base::StringPiece string_piece,
 
 void SimpleURLLoaderWrapper::OnComplete(bool success) {
   if (success) {
+    // The last update may have been held back by |progress_interval|.
+    if (pending_download_progress_)
+      Emit("download-progress", *pending_download_progress_);
+    pending_download_progress_.reset();
     Emit("complete");
   } else {
     Emit("error", net::ErrorToString(loader_->NetError()));
   }
+  Finish();
+}
+
+void SimpleURLLoaderWrapper::OnDownloadedToFile(base::FilePath path) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // SimpleURLLoader has already deleted the partial file on failure.
+  if (path.empty()) {
+    OnComplete(false);
+    return;
+  }
+  if (download_options_.expected_sha256.empty()) {
+    OnComplete(true);
+    return;
+  }
+  // Verifying the hash means reading the whole file back, which must not
+  // happen on the UI thread. We stay pinned until the reply arrives.
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&ComputeFileSHA256, path),
+      base::BindOnce(&SimpleURLLoaderWrapper::OnFileHashComputed,
+                     weak_factory_.GetWeakPtr(), path));
+}
+
+// static
+void SimpleURLLoaderWrapper::OnFileHashComputed(
+    base::WeakPtr<SimpleURLLoaderWrapper> self,
+    const base::FilePath& path,
+    const std::string& hash) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  bool verified = self && self->loader_ &&
+                  base::EqualsCaseInsensitiveASCII(
+                      hash, self->download_options_.expected_sha256);
+  if (verified) {
+    self->OnComplete(true);
+    return;
+  }
+  // The file is not handed to the caller when the hash doesn't match, could
+  // not be computed, or the request was cancelled while hashing.
+  base::ThreadPool::PostTask(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::BEST_EFFORT},
+      base::BindOnce(base::IgnoreResult(&base::DeleteFile), path));
+  if (!self || !self->loader_)
+    return;
+  self->Emit("error",
+             std::string("Downloaded file does not match downloadHash"));
+  self->Finish();
+}
+
+void SimpleURLLoaderWrapper::OnDownloadedToString(
+    std::unique_ptr<std::string> body) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!body) {
+    if (loader_->NetError() == net::ERR_INSUFFICIENT_RESOURCES) {
+      Emit("error", std::string("Response body exceeds downloadMaxSize"));
+      Finish();
+      return;
+    }
+    OnComplete(false);
+    return;
+  }
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  // Hand the accumulated body to V8 without copying it; the ArrayBuffer takes
+  // ownership of the string and frees it when collected.
+  std::string* data = body.release();
+  auto backing_store = v8::ArrayBuffer::NewBackingStore(
+      data->data(), data->size(),
+      [](void*, size_t, void* deleter_data) {
+        delete static_cast<std::string*>(deleter_data);
+      },
+      data);
+  auto array_buffer = v8::ArrayBuffer::New(isolate, std::move(backing_store));
+  Emit("data", array_buffer);
+  OnComplete(true);
+}
+
+void SimpleURLLoaderWrapper::Finish() {
+  if (loader_) {
+    TRACE_EVENT_NESTABLE_ASYNC_END1("electron.loader", "SimpleURLLoaderWrapper",
+                                    TRACE_ID_LOCAL(this), "net_error",
+                                    loader_->NetError());
+  }
   loader_.reset();
   pinned_wrapper_.Reset();
   pinned_chunk_pipe_getter_.Reset();
@@ -551,6 +818,9 @@ void SimpleURLLoaderWrapper::OnRetry(base::OnceClosure start_retry) {}
 void SimpleURLLoaderWrapper::OnResponseStarted(
     const GURL& final_url,
     const network::mojom::URLResponseHead& response_head) {
+  TRACE_EVENT_NESTABLE_ASYNC_INSTANT1(
+      "electron.loader", "SimpleURLLoaderWrapper::ResponseStarted",
+      TRACE_ID_LOCAL(this), "status", response_head.headers->response_code());
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   gin::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
@@ -578,6 +848,15 @@ void SimpleURLLoaderWrapper::OnUploadProgress(uint64_t position,
 }
 
 void SimpleURLLoaderWrapper::OnDownloadProgress(uint64_t current) {
+  if (!download_options_.progress_interval.is_zero()) {
+    base::TimeTicks now = base::TimeTicks::Now();
+    if (now - last_download_progress_ < download_options_.progress_interval) {
+      pending_download_progress_ = current;
+      return;
+    }
+    last_download_progress_ = now;
+    pending_download_progress_.reset();
+  }
   Emit("download-progress", current);
 }
 
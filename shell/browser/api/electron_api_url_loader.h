@@ -9,7 +9,10 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "base/time/time.h"
 #include "gin/wrappable.h"
 #include "net/base/auth.h"
 #include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
@@ -63,9 +66,26 @@ class SimpleURLLoaderWrapper
   const char* GetTypeName() override;
 
  private:
+  // Controls how the response body is handed back to JS. By default it is
+  // streamed chunk by chunk through "data" events.
+  struct DownloadOptions {
+    // When set, the body is written straight to this file by the network
+    // stack and never crosses into JS.
+    base::FilePath file_path;
+    // Hex encoded SHA-256 the file written to |file_path| must match.
+    std::string expected_sha256;
+    // When true, the body is accumulated natively and emitted as one chunk.
+    bool to_buffer = false;
+    // Largest body accumulated with |to_buffer|, the request fails beyond.
+    size_t max_buffer_size = 0;
+    // Minimum time between two "download-progress" events.
+    base::TimeDelta progress_interval;
+  };
+
   SimpleURLLoaderWrapper(std::unique_ptr<network::ResourceRequest> request,
                          network::mojom::URLLoaderFactory* url_loader_factory,
-                         int options);
+                         int options,
+                         const DownloadOptions& download_options);
 
   // SimpleURLLoaderStreamConsumer:
   void OnDataReceived(base::StringPiece string_piece,
@@ -81,7 +101,13 @@ class SimpleURLLoaderWrapper
                   std::vector<std::string>* removed_headers);
   void OnUploadProgress(uint64_t position, uint64_t total);
   void OnDownloadProgress(uint64_t current);
+  void OnDownloadedToFile(base::FilePath path);
+  static void OnFileHashComputed(base::WeakPtr<SimpleURLLoaderWrapper> self,
+                                 const base::FilePath& path,
+                                 const std::string& hash);
+  void OnDownloadedToString(std::unique_ptr<std::string> body);
 
+  void Finish();
   void Start();
   void Pin();
   void PinBodyGetter(v8::Local<v8::Value>);
@@ -91,6 +117,11 @@ class SimpleURLLoaderWrapper
   v8::Global<v8::Value> pinned_wrapper_;
   v8::Global<v8::Value> pinned_chunk_pipe_getter_;
 
+  DownloadOptions download_options_;
+  base::TimeTicks last_download_progress_;
+  // Progress held back by |progress_interval|, emitted on completion.
+  base::Optional<uint64_t> pending_download_progress_;
+
   base::WeakPtrFactory<SimpleURLLoaderWrapper> weak_factory_{this};
 };
 
@@ -25,6 +25,7 @@
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/ssl/security_state_tab_helper.h"
@@ -69,9 +70,12 @@
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
 #include "mojo/public/cpp/system/platform_handle.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
 #include "ppapi/buildflags/buildflags.h"
 #include "printing/buildflags/buildflags.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
@@ -88,8 +92,11 @@
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/browser/electron_javascript_dialog_manager.h"
 #include "shell/browser/electron_navigation_throttle.h"
+#include "shell/browser/electron_permission_manager.h"
+#include "shell/browser/main_thread_watchdog.h"
 #include "shell/browser/native_window.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/spare_renderer_pool.h"
 #include "shell/browser/ui/drag_util.h"
 #include "shell/browser/ui/file_dialog.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
@@ -120,6 +127,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
 #include "shell/common/process_util.h"
+#include "shell/common/sampling_profiler.h"
 #include "shell/common/v8_value_serializer.h"
 #include "storage/browser/file_system/isolated_context.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
@@ -378,6 +386,12 @@ base::IDMap<WebContents*>& GetAllWebContents() {
   return *s_all_web_contents;
 }
 
+ElectronPermissionManager* GetPermissionManager(
+    content::WebContents* web_contents) {
+  return static_cast<ElectronPermissionManager*>(
+      web_contents->GetBrowserContext()->GetPermissionControllerDelegate());
+}
+
 // Called when CapturePage is done.
 void OnCapturePageDone(gin_helper::Promise<gfx::Image> promise,
                        const SkBitmap& bitmap) {
@@ -588,6 +602,170 @@ bool IsDevToolsFileSystemAdded(content::WebContents* web_contents,
   return file_system_paths.find(file_system_path) != file_system_paths.end();
 }
 
+// Reports the total number of IPC messages and bytes received by the browser
+// as a trace counter. The channel is recorded as an argument of the span that
+// handles each message, so per-channel totals can be derived from the trace
+// without keeping state for every channel name a renderer sends.
+void TraceIPCMessage(const blink::CloneableMessage& message) {
+  bool enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED("electron.ipc", &enabled);
+  if (!enabled)
+    return;
+
+  static int64_t messages = 0;
+  static int64_t bytes = 0;
+  messages++;
+  bytes += message.encoded_message.size();
+  TRACE_COUNTER2("electron.ipc", "IPC", "messages", messages, "bytes", bytes);
+}
+
+// Parses the options of takeHeapSnapshot, returns false when an exception
+// was thrown.
+bool GetHeapSnapshotOptions(gin_helper::ErrorThrower thrower,
+                            gin::Arguments* args,
+                            bool* gzip) {
+  *gzip = false;
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options))
+    return true;
+  std::string compression;
+  if (options.Get("compression", &compression)) {
+    if (compression == "gzip") {
+      *gzip = true;
+    } else if (compression != "none") {
+      thrower.ThrowTypeError("Unsupported compression: " + compression);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Forwards the progress of a heap snapshot taken in the renderer as
+// 'heap-snapshot-progress' events.
+class HeapSnapshotProgressObserver : public mojom::HeapSnapshotObserver {
+ public:
+  explicit HeapSnapshotProgressObserver(base::WeakPtr<WebContents> web_contents)
+      : web_contents_(web_contents) {}
+
+  void OnProgress(uint32_t done, uint32_t total) override {
+    if (web_contents_)
+      web_contents_->Emit("heap-snapshot-progress", done, total);
+  }
+
+ private:
+  base::WeakPtr<WebContents> web_contents_;
+};
+
+mojo::PendingRemote<mojom::HeapSnapshotObserver> CreateHeapSnapshotObserver(
+    base::WeakPtr<WebContents> web_contents) {
+  mojo::PendingRemote<mojom::HeapSnapshotObserver> remote;
+  mojo::MakeSelfOwnedReceiver(
+      std::make_unique<HeapSnapshotProgressObserver>(web_contents),
+      remote.InitWithNewPipeAndPassReceiver());
+  return remote;
+}
+
+// Reads a heap snapshot streamed from the renderer and passes it to JS in
+// chunks. Reading pauses when |callback| returns false, until the resume
+// function it was given is called. Deletes itself once the renderer has
+// replied and the whole stream has been read.
+class HeapSnapshotStreamReader {
+ public:
+  using DataCallback = base::RepeatingCallback<bool(v8::Local<v8::Value>,
+                                                    base::RepeatingClosure)>;
+
+  HeapSnapshotStreamReader(mojo::ScopedDataPipeConsumerHandle consumer,
+                           const DataCallback& callback,
+                           gin_helper::Promise<void> promise)
+      : callback_(callback),
+        promise_(std::move(promise)),
+        consumer_(std::move(consumer)),
+        watcher_(FROM_HERE,
+                 mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+                 base::SequencedTaskRunnerHandle::Get()) {
+    watcher_.Watch(
+        consumer_.get(),
+        MOJO_HANDLE_SIGNAL_READABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+        base::BindRepeating(&HeapSnapshotStreamReader::OnReadable,
+                            base::Unretained(this)));
+    watcher_.ArmOrNotify();
+  }
+
+  void OnSnapshotTaken(bool success) {
+    success_ = success;
+    MaybeFinish();
+  }
+
+ private:
+  void OnReadable(MojoResult result) { ReadData(); }
+
+  void ReadData() {
+    while (true) {
+      const void* buffer = nullptr;
+      uint32_t num_bytes = 0;
+      MojoResult result = consumer_->BeginReadData(&buffer, &num_bytes,
+                                                   MOJO_READ_DATA_FLAG_NONE);
+      if (result == MOJO_RESULT_SHOULD_WAIT) {
+        watcher_.ArmOrNotify();
+        return;
+      }
+      if (result != MOJO_RESULT_OK) {
+        // The renderer has closed its end of the pipe.
+        watcher_.Cancel();
+        data_complete_ = true;
+        MaybeFinish();
+        return;
+      }
+
+      bool wants_more = PushData(buffer, num_bytes);
+      consumer_->EndReadData(num_bytes);
+      if (!wants_more) {
+        paused_ = true;
+        return;
+      }
+    }
+  }
+
+  bool PushData(const void* data, uint32_t num_bytes) {
+    v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+    v8::HandleScope handle_scope(isolate);
+    return callback_.Run(
+        node::Buffer::Copy(isolate, static_cast<const char*>(data), num_bytes)
+            .ToLocalChecked(),
+        base::BindRepeating(&HeapSnapshotStreamReader::Resume,
+                            weak_factory_.GetWeakPtr()));
+  }
+
+  void Resume() {
+    if (!paused_)
+      return;
+    paused_ = false;
+    watcher_.ArmOrNotify();
+  }
+
+  void MaybeFinish() {
+    if (!success_.has_value() || (*success_ && !data_complete_))
+      return;
+    if (*success_)
+      promise_.Resolve();
+    else
+      promise_.RejectWithErrorMessage("takeHeapSnapshot failed");
+    delete this;
+  }
+
+  DataCallback callback_;
+  gin_helper::Promise<void> promise_;
+  mojo::ScopedDataPipeConsumerHandle consumer_;
+  mojo::SimpleWatcher watcher_;
+  base::Optional<bool> success_;
+  bool data_complete_ = false;
+  bool paused_ = false;
+
+  base::WeakPtrFactory<HeapSnapshotStreamReader> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotStreamReader);
+};
+
 }  // namespace
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -730,7 +908,7 @@ WebContents::WebContents(v8::Isolate* isolate,
 #if BUILDFLAG(ENABLE_OSR)
     if (embedder_ && embedder_->IsOffScreen()) {
       auto* view = new OffScreenWebContentsView(
-          false,
+          false, false,
           base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
       params.view = view;
       params.delegate_view = view;
@@ -745,10 +923,12 @@ WebContents::WebContents(v8::Isolate* isolate,
   } else if (IsOffScreen()) {
     bool transparent = false;
     options.Get("transparent", &transparent);
+    bool on_demand_frames = false;
+    options.Get(options::kOnDemandFrames, &on_demand_frames);
 
     content::WebContents::CreateParams params(session->browser_context());
     auto* view = new OffScreenWebContentsView(
-        transparent,
+        transparent, on_demand_frames,
         base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
     params.view = view;
     params.delegate_view = view;
@@ -759,12 +939,48 @@ WebContents::WebContents(v8::Isolate* isolate,
   } else {
     content::WebContents::CreateParams params(session->browser_context());
     params.initially_hidden = !initially_shown_;
+    params.site_instance =
+        TakeSpareRenderer(isolate, session->browser_context(), options);
     web_contents = content::WebContents::Create(params);
   }
 
   InitWithSessionAndOptions(isolate, std::move(web_contents), session, options);
 }
 
+scoped_refptr<content::SiteInstance> WebContents::TakeSpareRenderer(
+    v8::Isolate* isolate,
+    ElectronBrowserContext* browser_context,
+    const gin_helper::Dictionary& options) {
+  creation_time_ = base::TimeTicks::Now();
+  auto* pool = browser_context->GetSpareRendererPool();
+  // Without renderer process reuse every page gets a new renderer when it
+  // navigates, and affinity picks the renderer itself.
+  if (!pool->enabled() || options.Has("affinity") ||
+      !ElectronBrowserClient::Get()->CanUseCustomSiteInstance())
+    return nullptr;
+
+  gin_helper::Dictionary copied(isolate, options.GetHandle()->Clone());
+  // Following fields don't affect the renderer.
+  copied.Delete("embedder");
+  copied.Delete("session");
+  copied.Delete("type");
+  copied.Delete(options::kShow);
+  base::Value web_preferences;
+  if (!gin::ConvertFromV8(isolate, copied.GetHandle(), &web_preferences))
+    return nullptr;
+
+  spare_renderer_profile_ = SpareRendererPool::GetProfile(web_preferences);
+  scoped_refptr<content::SiteInstance> site_instance =
+      pool->Take(spare_renderer_profile_);
+  used_spare_renderer_ = site_instance != nullptr;
+  return site_instance;
+}
+
+void WebContents::ReplenishSpareRenderers() {
+  GetBrowserContext()->GetSpareRendererPool()->Replenish(
+      spare_renderer_profile_, web_contents());
+}
+
 void WebContents::InitZoomController(content::WebContents* web_contents,
                                      const gin_helper::Dictionary& options) {
   WebContentsZoomController::CreateForWebContents(web_contents);
@@ -1410,6 +1626,10 @@ void WebContents::RenderViewDeleted(content::RenderViewHost* render_view_host) {
 }
 
 void WebContents::RenderProcessGone(base::TerminationStatus status) {
+  // The renderer was shut down on purpose.
+  if (discarded_)
+    return;
+
   auto weak_this = GetWeakPtr();
   Emit("crashed", status == base::TERMINATION_STATUS_PROCESS_WAS_KILLED);
 
@@ -1425,6 +1645,25 @@ void WebContents::RenderProcessGone(base::TerminationStatus status) {
   Emit("render-process-gone", details);
 }
 
+void WebContents::OnVisibilityChanged(content::Visibility visibility) {
+  if (visibility != content::Visibility::VISIBLE)
+    return;
+  last_active_time_ = base::Time::Now();
+  if (!discarded_)
+    return;
+
+  // Any navigation recreates the renderer, reload the discarded page.
+  auto& controller = web_contents()->GetController();
+  controller.SetNeedsReload();
+  controller.LoadIfNecessary();
+  OnDiscardedPageRestored();
+}
+
+void WebContents::OnWebContentsFocused(
+    content::RenderWidgetHost* render_widget_host) {
+  last_active_time_ = base::Time::Now();
+}
+
 void WebContents::PluginCrashed(const base::FilePath& plugin_path,
                                 base::ProcessId plugin_pid) {
 #if BUILDFLAG(ENABLE_PLUGINS)
@@ -1542,7 +1781,10 @@ void WebContents::Message(bool internal,
                           const std::string& channel,
                           blink::CloneableMessage arguments,
                           content::RenderFrameHost* render_frame_host) {
-  TRACE_EVENT1("electron", "WebContents::Message", "channel", channel);
+  TRACE_EVENT2("electron.ipc", "WebContents::Message", "channel", channel,
+               "bytes", arguments.encoded_message.size());
+  TraceIPCMessage(arguments);
+  MainThreadWatchdog::ScopedActivity activity("ipc", channel);
   // webContents.emit('-ipc-message', new Event(), internal, channel,
   // arguments);
   EmitWithSender("-ipc-message", render_frame_host,
@@ -1556,7 +1798,10 @@ void WebContents::Invoke(
     blink::CloneableMessage arguments,
     electron::mojom::ElectronBrowser::InvokeCallback callback,
     content::RenderFrameHost* render_frame_host) {
-  TRACE_EVENT1("electron", "WebContents::Invoke", "channel", channel);
+  TRACE_EVENT2("electron.ipc", "WebContents::Invoke", "channel", channel,
+               "bytes", arguments.encoded_message.size());
+  TraceIPCMessage(arguments);
+  MainThreadWatchdog::ScopedActivity activity("ipc", channel);
   // webContents.emit('-ipc-invoke', new Event(), internal, channel, arguments);
   EmitWithSender("-ipc-invoke", render_frame_host, std::move(callback),
                  internal, channel, std::move(arguments));
@@ -1565,6 +1810,16 @@ void WebContents::Invoke(
 void WebContents::OnFirstNonEmptyLayout(
     content::RenderFrameHost* render_frame_host) {
   if (render_frame_host == web_contents()->GetMainFrame()) {
+    if (!spare_renderer_profile_.empty() && !creation_time_.is_null()) {
+      GetBrowserContext()->GetSpareRendererPool()->RecordFirstPaint(
+          used_spare_renderer_, base::TimeTicks::Now() - creation_time_);
+      creation_time_ = base::TimeTicks();
+      // Launch the next spare once the page is up, without competing with it.
+      content::GetUIThreadTaskRunner({base::TaskPriority::BEST_EFFORT})
+          ->PostTask(FROM_HERE,
+                     base::BindOnce(&WebContents::ReplenishSpareRenderers,
+                                    GetWeakPtr()));
+    }
     Emit("ready-to-show");
   }
 }
@@ -1590,7 +1845,10 @@ void WebContents::MessageSync(
     blink::CloneableMessage arguments,
     electron::mojom::ElectronBrowser::MessageSyncCallback callback,
     content::RenderFrameHost* render_frame_host) {
-  TRACE_EVENT1("electron", "WebContents::MessageSync", "channel", channel);
+  TRACE_EVENT2("electron.ipc", "WebContents::MessageSync", "channel", channel,
+               "bytes", arguments.encoded_message.size());
+  TraceIPCMessage(arguments);
+  MainThreadWatchdog::ScopedActivity activity("ipc", channel);
   // webContents.emit('-ipc-message-sync', new Event(sender, message), internal,
   // channel, arguments);
   EmitWithSender("-ipc-message-sync", render_frame_host, std::move(callback),
@@ -1601,7 +1859,9 @@ void WebContents::MessageTo(bool internal,
                             int32_t web_contents_id,
                             const std::string& channel,
                             blink::CloneableMessage arguments) {
-  TRACE_EVENT1("electron", "WebContents::MessageTo", "channel", channel);
+  TRACE_EVENT2("electron.ipc", "WebContents::MessageTo", "channel", channel,
+               "bytes", arguments.encoded_message.size());
+  TraceIPCMessage(arguments);
   auto* target_web_contents = FromID(web_contents_id);
 
   if (target_web_contents) {
@@ -1613,15 +1873,18 @@ void WebContents::MessageTo(bool internal,
         WebFrameMain::From(JavascriptEnvironment::GetIsolate(), frame);
 
     int32_t sender_id = ID();
-    web_frame_main->GetRendererApi()->Message(internal, channel,
-                                              std::move(arguments), sender_id);
+    web_frame_main->SendIPCMessage(internal, channel, std::move(arguments),
+                                   sender_id);
   }
 }
 
 void WebContents::MessageHost(const std::string& channel,
                               blink::CloneableMessage arguments,
                               content::RenderFrameHost* render_frame_host) {
-  TRACE_EVENT1("electron", "WebContents::MessageHost", "channel", channel);
+  TRACE_EVENT2("electron.ipc", "WebContents::MessageHost", "channel", channel,
+               "bytes", arguments.encoded_message.size());
+  TraceIPCMessage(arguments);
+  MainThreadWatchdog::ScopedActivity activity("ipc", channel);
   // webContents.emit('ipc-message-host', new Event(), channel, args);
   EmitWithSender("ipc-message-host", render_frame_host,
                  electron::mojom::ElectronBrowser::InvokeCallback(), channel,
@@ -1639,10 +1902,17 @@ void WebContents::RenderFrameDeleted(
   // A WebFrameMain can outlive its RenderFrameHost so we need to mark it as
   // disposed to prevent access to it.
   WebFrameMain::RenderFrameDeleted(render_frame_host);
+
+  // Permission decisions are cached per frame, don't keep them around for
+  // frames that are gone.
+  GetPermissionManager(web_contents())->ClearPermissionDecisionsForFrame(
+      render_frame_host->GetFrameTreeNodeId());
 }
 
 void WebContents::DidStartNavigation(
     content::NavigationHandle* navigation_handle) {
+  if (navigation_handle->IsInMainFrame())
+    OnDiscardedPageRestored();
   EmitNavigationEvent("did-start-navigation", navigation_handle);
 }
 
@@ -1839,6 +2109,13 @@ content::WebContents* WebContents::GetDevToolsWebContents() const {
 }
 
 void WebContents::WebContentsDestroyed() {
+  // The frames aren't always deleted before the WebContents.
+  auto* permission_manager = GetPermissionManager(web_contents());
+  for (auto* frame : web_contents()->GetAllFrames()) {
+    permission_manager->ClearPermissionDecisionsForFrame(
+        frame->GetFrameTreeNodeId());
+  }
+
   // Clear the pointer stored in wrapper.
   if (GetAllWebContents().Lookup(id_))
     GetAllWebContents().Remove(id_);
@@ -2071,6 +2348,57 @@ void WebContents::ForcefullyCrashRenderer() {
   }
 }
 
+bool WebContents::CanDiscard() const {
+  if (discarded_ || !web_contents() || web_contents()->IsCrashed())
+    return false;
+  // Only pages that can't be seen or heard, and aren't being inspected.
+  if (web_contents()->GetVisibility() == content::Visibility::VISIBLE ||
+      web_contents()->IsCurrentlyAudible() ||
+      web_contents()->IsBeingCaptured())
+    return false;
+  if (IsGuest() || IsOffScreen() || type_ == Type::kBackgroundPage)
+    return false;
+  if (inspectable_web_contents_ &&
+      inspectable_web_contents_->IsDevToolsViewShowing())
+    return false;
+  return web_contents()->GetController().GetLastCommittedEntry() != nullptr;
+}
+
+bool WebContents::Discard() {
+  return DiscardAndNotify(base::OnceClosure());
+}
+
+bool WebContents::DiscardAndNotify(base::OnceClosure on_restored) {
+  if (!CanDiscard())
+    return false;
+
+  // Set before the shutdown, which reports the renderer as gone right away.
+  discarded_ = true;
+  // Only succeeds when the process hosts nothing but this page and the page
+  // has no unload handlers that would have to run.
+  content::RenderProcessHost* process =
+      web_contents()->GetMainFrame()->GetProcess();
+  if (!process->FastShutdownIfPossible(1, false)) {
+    discarded_ = false;
+    return false;
+  }
+
+  on_restored_ = std::move(on_restored);
+  // Lets the page know through document.wasDiscarded once it's reloaded.
+  web_contents()->SetWasDiscarded(true);
+  Emit("discarded");
+  return true;
+}
+
+void WebContents::OnDiscardedPageRestored() {
+  if (!discarded_)
+    return;
+  discarded_ = false;
+  if (on_restored_)
+    std::move(on_restored_).Run();
+  Emit("restored");
+}
+
 void WebContents::SetUserAgent(const std::string& user_agent) {
   web_contents()->SetUserAgentOverride(
       blink::UserAgentOverride::UserAgentOnly(user_agent), false);
@@ -2275,8 +2603,7 @@ void WebContents::InspectServiceWorker() {
 void WebContents::SetIgnoreMenuShortcuts(bool ignore) {
   auto* web_preferences = WebContentsPreferences::From(web_contents());
   DCHECK(web_preferences);
-  web_preferences->preference()->SetKey("ignoreMenuShortcuts",
-                                        base::Value(ignore));
+  web_preferences->SetPreference("ignoreMenuShortcuts", base::Value(ignore));
 }
 
 void WebContents::SetAudioMuted(bool muted) {
@@ -2732,6 +3059,74 @@ void WebContents::EndFrameSubscription() {
   frame_subscriber_.reset();
 }
 
+void WebContents::StartRecording(gin_helper::ErrorThrower thrower,
+                                 gin::Arguments* args) {
+  if (video_recorder_) {
+    thrower.ThrowError("A recording is already in progress");
+    return;
+  }
+
+  VideoRecorder::Options options;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    dict.Get("path", &options.path);
+    std::string codec;
+    if (dict.Get("codec", &codec)) {
+      if (codec == "vp9") {
+        options.codec = media::kCodecVP9;
+      } else if (codec != "vp8") {
+        thrower.ThrowTypeError("Unsupported codec: " + codec);
+        return;
+      }
+    }
+    dict.Get("bitrate", &options.bitrate);
+    dict.Get("frameRate", &options.frame_rate);
+  }
+  if (options.bitrate == 0) {
+    thrower.ThrowRangeError("bitrate must be greater than 0");
+    return;
+  }
+  if (options.frame_rate < 1 || options.frame_rate > 60) {
+    thrower.ThrowRangeError("frameRate must be between 1 and 60");
+    return;
+  }
+
+  video_recorder_ = std::make_unique<VideoRecorder>(
+      web_contents(), options,
+      base::BindRepeating(&WebContents::OnRecordingData, GetWeakPtr()));
+}
+
+v8::Local<v8::Promise> WebContents::StopRecording(v8::Isolate* isolate) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!video_recorder_ || video_recorder_->stopped()) {
+    promise.RejectWithErrorMessage("No recording is in progress");
+    return handle;
+  }
+
+  video_recorder_->Stop(base::BindOnce(&WebContents::OnRecordingStopped,
+                                       GetWeakPtr(), std::move(promise)));
+  return handle;
+}
+
+void WebContents::OnRecordingData(const std::string& chunk) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  Emit("recording-data",
+       node::Buffer::Copy(isolate, chunk.data(), chunk.size())
+           .ToLocalChecked());
+}
+
+void WebContents::OnRecordingStopped(gin_helper::Promise<void> promise,
+                                     const std::string& error) {
+  video_recorder_.reset();
+  if (error.empty())
+    promise.Resolve();
+  else
+    promise.RejectWithErrorMessage(error);
+}
+
 void WebContents::StartDrag(const gin_helper::Dictionary& item,
                             gin::Arguments* args) {
   base::FilePath file;
@@ -2900,6 +3295,40 @@ int WebContents::GetFrameRate() const {
   auto* osr_wcv = GetOffScreenWebContentsView();
   return osr_wcv ? osr_wcv->GetFrameRate() : 0;
 }
+
+void WebContents::RequestFrame() {
+  auto* osr_rwhv = GetOffScreenRenderWidgetHostView();
+  if (osr_rwhv)
+    osr_rwhv->RequestFrame();
+}
+
+void WebContents::SetPaintMode(gin_helper::ErrorThrower thrower,
+                               const std::string& mode) {
+  if (mode != "frame" && mode != "dirty-rects") {
+    thrower.ThrowError("Invalid paint mode: " + mode);
+    return;
+  }
+  auto* osr_wcv = GetOffScreenWebContentsView();
+  if (osr_wcv)
+    osr_wcv->SetPaintDirtyRectsOnly(mode == "dirty-rects");
+}
+
+std::string WebContents::GetPaintMode() const {
+  auto* osr_wcv = GetOffScreenWebContentsView();
+  return osr_wcv && osr_wcv->IsPaintingDirtyRectsOnly() ? "dirty-rects"
+                                                        : "frame";
+}
+
+v8::Local<v8::Value> WebContents::GetPaintStats(v8::Isolate* isolate) const {
+  OffScreenPaintStats stats;
+  auto* osr_wcv = GetOffScreenWebContentsView();
+  if (osr_wcv)
+    stats = osr_wcv->GetPaintStats();
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("deliveredBytes", static_cast<double>(stats.delivered_bytes));
+  dict.Set("fullFrameBytes", static_cast<double>(stats.full_frame_bytes));
+  return dict.GetHandle();
+}
 #endif
 
 void WebContents::Invalidate() {
@@ -3079,11 +3508,16 @@ void WebContents::NotifyUserActivation() {
 }
 
 v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
-    v8::Isolate* isolate,
-    const base::FilePath& file_path) {
-  gin_helper::Promise<void> promise(isolate);
+    gin_helper::ErrorThrower thrower,
+    const base::FilePath& file_path,
+    gin::Arguments* args) {
+  gin_helper::Promise<void> promise(thrower.isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
+  bool gzip;
+  if (!GetHeapSnapshotOptions(thrower, args, &gzip))
+    return handle;
+
   base::ThreadRestrictions::ScopedAllowIO allow_io;
   base::File file(file_path,
                   base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
@@ -3113,6 +3547,7 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
   auto* raw_ptr = electron_renderer.get();
   (*raw_ptr)->TakeHeapSnapshot(
       mojo::WrapPlatformFile(base::ScopedPlatformFile(file.TakePlatformFile())),
+      gzip, CreateHeapSnapshotObserver(GetWeakPtr()),
       base::BindOnce(
           [](mojo::Remote<mojom::ElectronRenderer>* ep,
              gin_helper::Promise<void> promise, bool success) {
@@ -3126,6 +3561,195 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
   return handle;
 }
 
+v8::Local<v8::Promise> WebContents::StreamHeapSnapshot(
+    gin_helper::ErrorThrower thrower,
+    const base::RepeatingCallback<bool(v8::Local<v8::Value>,
+                                       base::RepeatingClosure)>& callback,
+    gin::Arguments* args) {
+  gin_helper::Promise<void> promise(thrower.isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  bool gzip;
+  if (!GetHeapSnapshotOptions(thrower, args, &gzip))
+    return handle;
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameCreated()) {
+    promise.RejectWithErrorMessage("takeHeapSnapshot failed");
+    return handle;
+  }
+
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  if (mojo::CreateDataPipe(nullptr, producer, consumer) != MOJO_RESULT_OK) {
+    promise.RejectWithErrorMessage("takeHeapSnapshot failed");
+    return handle;
+  }
+
+  auto* reader = new HeapSnapshotStreamReader(std::move(consumer), callback,
+                                              std::move(promise));
+  auto electron_renderer =
+      std::make_unique<mojo::Remote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteInterfaces()->GetInterface(
+      electron_renderer->BindNewPipeAndPassReceiver());
+  auto* raw_ptr = electron_renderer.get();
+  // The reply is still needed when the renderer goes away, otherwise the
+  // reader and its promise would be leaked.
+  (*raw_ptr)->StreamHeapSnapshot(
+      std::move(producer), gzip, CreateHeapSnapshotObserver(GetWeakPtr()),
+      mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+          base::BindOnce(
+              [](mojo::Remote<mojom::ElectronRenderer>* ep,
+                 HeapSnapshotStreamReader* reader, bool success) {
+                reader->OnSnapshotTaken(success);
+              },
+              base::Owned(std::move(electron_renderer)),
+              base::Unretained(reader)),
+          false));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StartSamplingHeapProfiler(
+    gin_helper::ErrorThrower thrower,
+    gin::Arguments* args) {
+  gin_helper::Promise<void> promise(thrower.isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  uint64_t sampling_interval = kDefaultHeapSamplingInterval;
+  int stack_depth = kDefaultHeapSamplingStackDepth;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("samplingInterval", &sampling_interval);
+    options.Get("stackDepth", &stack_depth);
+  }
+  if (sampling_interval == 0 || stack_depth <= 0) {
+    thrower.ThrowRangeError(
+        "samplingInterval and stackDepth must be greater than 0");
+    return handle;
+  }
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameCreated()) {
+    promise.RejectWithErrorMessage("The renderer is not running");
+    return handle;
+  }
+
+  WebFrameMain::From(thrower.isolate(), frame_host)
+      ->GetRendererApi()
+      ->StartSamplingHeapProfiler(
+          sampling_interval, stack_depth,
+          mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+              base::BindOnce(
+                  [](gin_helper::Promise<void> promise, bool success) {
+                    if (success) {
+                      promise.Resolve();
+                    } else {
+                      promise.RejectWithErrorMessage(
+                          "The sampling heap profiler is already running");
+                    }
+                  },
+                  std::move(promise)),
+              false));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StopSamplingHeapProfiler(
+    v8::Isolate* isolate) {
+  gin_helper::Promise<std::string> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameCreated()) {
+    promise.RejectWithErrorMessage("The renderer is not running");
+    return handle;
+  }
+
+  WebFrameMain::From(isolate, frame_host)
+      ->GetRendererApi()
+      ->StopSamplingHeapProfiler(mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+          base::BindOnce(
+              [](gin_helper::Promise<std::string> promise,
+                 const base::Optional<std::string>& profile) {
+                if (profile) {
+                  promise.Resolve(*profile);
+                } else {
+                  promise.RejectWithErrorMessage(
+                      "The sampling heap profiler is not running");
+                }
+              },
+              std::move(promise)),
+          base::nullopt));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StartCpuProfile(
+    gin_helper::ErrorThrower thrower,
+    gin::Arguments* args) {
+  gin_helper::Promise<void> promise(thrower.isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  int sampling_interval = kDefaultCpuSamplingInterval;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("samplingInterval", &sampling_interval);
+  if (sampling_interval <= 0) {
+    thrower.ThrowRangeError("samplingInterval must be greater than 0");
+    return handle;
+  }
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameCreated()) {
+    promise.RejectWithErrorMessage("The renderer is not running");
+    return handle;
+  }
+
+  WebFrameMain::From(thrower.isolate(), frame_host)
+      ->GetRendererApi()
+      ->StartCpuProfile(
+          sampling_interval,
+          mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+              base::BindOnce(
+                  [](gin_helper::Promise<void> promise, bool success) {
+                    if (success) {
+                      promise.Resolve();
+                    } else {
+                      promise.RejectWithErrorMessage(
+                          "A CPU profile is already being recorded");
+                    }
+                  },
+                  std::move(promise)),
+              false));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StopCpuProfile(v8::Isolate* isolate) {
+  gin_helper::Promise<std::string> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameCreated()) {
+    promise.RejectWithErrorMessage("The renderer is not running");
+    return handle;
+  }
+
+  WebFrameMain::From(isolate, frame_host)
+      ->GetRendererApi()
+      ->StopCpuProfile(mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+          base::BindOnce(
+              [](gin_helper::Promise<std::string> promise,
+                 const base::Optional<std::string>& profile) {
+                if (profile) {
+                  promise.Resolve(*profile);
+                } else {
+                  promise.RejectWithErrorMessage(
+                      "No CPU profile is being recorded");
+                }
+              },
+              std::move(promise)),
+          base::nullopt));
+  return handle;
+}
+
 void WebContents::UpdatePreferredSize(content::WebContents* web_contents,
                                       const gfx::Size& pref_size) {
   Emit("preferred-size-changed", pref_size);
@@ -3532,6 +4156,8 @@ v8::Local<v8::ObjectTemplate> WebContents::FillObjectTemplate(
       .SetMethod("_goForward", &WebContents::GoForward)
       .SetMethod("_goToOffset", &WebContents::GoToOffset)
       .SetMethod("isCrashed", &WebContents::IsCrashed)
+      .SetMethod("discard", &WebContents::Discard)
+      .SetMethod("isDiscarded", &WebContents::IsDiscarded)
       .SetMethod("forcefullyCrashRenderer",
                  &WebContents::ForcefullyCrashRenderer)
       .SetMethod("setUserAgent", &WebContents::SetUserAgent)
@@ -3567,6 +4193,8 @@ v8::Local<v8::ObjectTemplate> WebContents::FillObjectTemplate(
       .SetMethod("sendInputEvent", &WebContents::SendInputEvent)
       .SetMethod("beginFrameSubscription", &WebContents::BeginFrameSubscription)
       .SetMethod("endFrameSubscription", &WebContents::EndFrameSubscription)
+      .SetMethod("startRecording", &WebContents::StartRecording)
+      .SetMethod("stopRecording", &WebContents::StopRecording)
       .SetMethod("startDrag", &WebContents::StartDrag)
       .SetMethod("attachToIframe", &WebContents::AttachToIframe)
       .SetMethod("detachFromOuterFrame", &WebContents::DetachFromOuterFrame)
@@ -3577,6 +4205,10 @@ v8::Local<v8::ObjectTemplate> WebContents::FillObjectTemplate(
       .SetMethod("isPainting", &WebContents::IsPainting)
       .SetMethod("setFrameRate", &WebContents::SetFrameRate)
       .SetMethod("getFrameRate", &WebContents::GetFrameRate)
+      .SetMethod("requestFrame", &WebContents::RequestFrame)
+      .SetMethod("setPaintMode", &WebContents::SetPaintMode)
+      .SetMethod("getPaintMode", &WebContents::GetPaintMode)
+      .SetMethod("getPaintStats", &WebContents::GetPaintStats)
 #endif
       .SetMethod("invalidate", &WebContents::Invalidate)
       .SetMethod("setZoomLevel", &WebContents::SetZoomLevel)
@@ -3617,6 +4249,13 @@ v8::Local<v8::ObjectTemplate> WebContents::FillObjectTemplate(
                  &WebContents::GetWebRTCIPHandlingPolicy)
       .SetMethod("_grantOriginAccess", &WebContents::GrantOriginAccess)
       .SetMethod("takeHeapSnapshot", &WebContents::TakeHeapSnapshot)
+      .SetMethod("_streamHeapSnapshot", &WebContents::StreamHeapSnapshot)
+      .SetMethod("startSamplingHeapProfiler",
+                 &WebContents::StartSamplingHeapProfiler)
+      .SetMethod("stopSamplingHeapProfiler",
+                 &WebContents::StopSamplingHeapProfiler)
+      .SetMethod("startCpuProfile", &WebContents::StartCpuProfile)
+      .SetMethod("stopCpuProfile", &WebContents::StopCpuProfile)
       .SetProperty("id", &WebContents::ID)
       .SetProperty("session", &WebContents::Session)
       .SetProperty("hostWebContents", &WebContents::HostWebContents)
@@ -3710,6 +4349,16 @@ WebContents* WebContents::FromID(int32_t id) {
   return GetAllWebContents().Lookup(id);
 }
 
+// static
+std::vector<WebContents*> WebContents::GetAll() {
+  std::vector<WebContents*> result;
+  for (base::IDMap<WebContents*>::iterator iter(&GetAllWebContents());
+       !iter.IsAtEnd(); iter.Advance()) {
+    result.push_back(iter.GetCurrentValue());
+  }
+  return result;
+}
+
 // static
 gin::WrapperInfo WebContents::kWrapperInfo = {gin::kEmbedderNativeGin};
 
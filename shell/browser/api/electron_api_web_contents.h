@@ -14,6 +14,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
+#include "base/time/time.h"
 #include "chrome/browser/devtools/devtools_file_system_indexer.h"
 #include "content/common/cursors/webcursor.h"
 #include "content/common/frame.mojom.h"
@@ -23,6 +24,7 @@
 #include "content/public/browser/web_contents.h"
 #include "content/public/browser/web_contents_delegate.h"
 #include "content/public/browser/web_contents_observer.h"
+#include "content/public/common/child_process_host.h"
 #include "electron/buildflags/buildflags.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "gin/handle.h"
@@ -32,6 +34,7 @@
 #include "services/service_manager/public/cpp/binder_registry.h"
 #include "shell/browser/api/frame_subscriber.h"
 #include "shell/browser/api/save_page_handler.h"
+#include "shell/browser/api/video_recorder.h"
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/browser/extended_web_contents_observer.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
@@ -124,6 +127,7 @@ class WebContents : public gin::Wrappable<WebContents>,
   // if there is no associated wrapper.
   static WebContents* From(content::WebContents* web_contents);
   static WebContents* FromID(int32_t id);
+  static std::vector<WebContents*> GetAll();
 
   // Get the V8 wrapper of the |web_contents|, or create one if not existed.
   //
@@ -169,6 +173,16 @@ class WebContents : public gin::Wrappable<WebContents>,
   void SetWebRTCIPHandlingPolicy(const std::string& webrtc_ip_handling_policy);
   bool IsCrashed() const;
   void ForcefullyCrashRenderer();
+
+  // Discarding tears down the renderer of a hidden page while keeping its
+  // navigation state, the page is reloaded the next time it is shown.
+  bool CanDiscard() const;
+  bool Discard();
+  // |on_restored| runs when the discarded page is loaded again.
+  bool DiscardAndNotify(base::OnceClosure on_restored);
+  bool IsDiscarded() const { return discarded_; }
+  // The last time the page was shown or focused.
+  base::Time last_active_time() const { return last_active_time_; }
   void SetUserAgent(const std::string& user_agent);
   std::string GetUserAgent();
   void InsertCSS(const std::string& css);
@@ -243,6 +257,10 @@ class WebContents : public gin::Wrappable<WebContents>,
   void BeginFrameSubscription(gin::Arguments* args);
   void EndFrameSubscription();
 
+  // Encode the captured frames to WebM.
+  void StartRecording(gin_helper::ErrorThrower thrower, gin::Arguments* args);
+  v8::Local<v8::Promise> StopRecording(v8::Isolate* isolate);
+
   // Dragging native items.
   void StartDrag(const gin_helper::Dictionary& item, gin::Arguments* args);
 
@@ -265,6 +283,10 @@ class WebContents : public gin::Wrappable<WebContents>,
   bool IsPainting() const;
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
+  void RequestFrame();
+  void SetPaintMode(gin_helper::ErrorThrower thrower, const std::string& mode);
+  std::string GetPaintMode() const;
+  v8::Local<v8::Value> GetPaintStats(v8::Isolate* isolate) const;
 #endif
   void Invalidate();
   gfx::Size GetSizeForNewRenderView(content::WebContents*) override;
@@ -306,8 +328,26 @@ class WebContents : public gin::Wrappable<WebContents>,
   // Notifies the web page that there is user interaction.
   void NotifyUserActivation();
 
-  v8::Local<v8::Promise> TakeHeapSnapshot(v8::Isolate* isolate,
-                                          const base::FilePath& file_path);
+  v8::Local<v8::Promise> TakeHeapSnapshot(gin_helper::ErrorThrower thrower,
+                                          const base::FilePath& file_path,
+                                          gin::Arguments* args);
+  // Streams the snapshot to |callback| in chunks instead of writing a file.
+  // Reading pauses while |callback| returns false, until the closure passed
+  // along with the chunk is run.
+  v8::Local<v8::Promise> StreamHeapSnapshot(
+      gin_helper::ErrorThrower thrower,
+      const base::RepeatingCallback<bool(v8::Local<v8::Value>,
+                                         base::RepeatingClosure)>& callback,
+      gin::Arguments* args);
+
+  // Control the sampling profilers of the renderer process.
+  v8::Local<v8::Promise> StartSamplingHeapProfiler(
+      gin_helper::ErrorThrower thrower,
+      gin::Arguments* args);
+  v8::Local<v8::Promise> StopSamplingHeapProfiler(v8::Isolate* isolate);
+  v8::Local<v8::Promise> StartCpuProfile(gin_helper::ErrorThrower thrower,
+                                         gin::Arguments* args);
+  v8::Local<v8::Promise> StopCpuProfile(v8::Isolate* isolate);
 
   // Properties.
   int32_t ID() const { return id_; }
@@ -376,6 +416,12 @@ class WebContents : public gin::Wrappable<WebContents>,
 
   bool is_html_fullscreen() const { return html_fullscreen_; }
 
+  bool used_spare_renderer() const { return used_spare_renderer_; }
+
+  // The renderer the session's sharing policy placed the page in.
+  int shared_renderer_id() const { return shared_renderer_id_; }
+  void set_shared_renderer_id(int id) { shared_renderer_id_ = id; }
+
   void set_fullscreen_frame(content::RenderFrameHost* rfh) {
     fullscreen_frame_ = rfh;
   }
@@ -435,6 +481,10 @@ class WebContents : public gin::Wrappable<WebContents>,
       gin::Handle<class Session> session,
       const gin_helper::Dictionary& options);
 
+  void OnRecordingData(const std::string& chunk);
+  void OnRecordingStopped(gin_helper::Promise<void> promise,
+                          const std::string& error);
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   void InitWithExtensionView(v8::Isolate* isolate,
                              content::WebContents* web_contents,
@@ -537,6 +587,9 @@ class WebContents : public gin::Wrappable<WebContents>,
   void RenderFrameCreated(content::RenderFrameHost* render_frame_host) override;
   void RenderViewDeleted(content::RenderViewHost*) override;
   void RenderProcessGone(base::TerminationStatus status) override;
+  void OnVisibilityChanged(content::Visibility visibility) override;
+  void OnWebContentsFocused(
+      content::RenderWidgetHost* render_widget_host) override;
   void RenderFrameDeleted(content::RenderFrameHost* render_frame_host) override;
   void DOMContentLoaded(content::RenderFrameHost* render_frame_host) override;
   void DidFinishLoad(content::RenderFrameHost* render_frame_host,
@@ -602,6 +655,14 @@ class WebContents : public gin::Wrappable<WebContents>,
   void InitZoomController(content::WebContents* web_contents,
                           const gin_helper::Dictionary& options);
 
+  // Returns a renderer launched ahead of time for webContents created with
+  // |options|, if the session keeps spare renderers.
+  scoped_refptr<content::SiteInstance> TakeSpareRenderer(
+      v8::Isolate* isolate,
+      ElectronBrowserContext* browser_context,
+      const gin_helper::Dictionary& options);
+  void ReplenishSpareRenderers();
+
   // content::WebContentsDelegate:
   bool CanOverscrollContent() override;
   content::ColorChooser* OpenColorChooser(
@@ -673,6 +734,9 @@ class WebContents : public gin::Wrappable<WebContents>,
   // Set fullscreen mode triggered by html api.
   void SetHtmlApiFullscreen(bool enter_fullscreen);
 
+  // Called when a discarded page starts loading again.
+  void OnDiscardedPageRestored();
+
   v8::Global<v8::Value> session_;
   v8::Global<v8::Value> devtools_web_contents_;
   v8::Global<v8::Value> debugger_;
@@ -680,6 +744,22 @@ class WebContents : public gin::Wrappable<WebContents>,
   std::unique_ptr<ElectronJavaScriptDialogManager> dialog_manager_;
   std::unique_ptr<WebViewGuestDelegate> guest_delegate_;
   std::unique_ptr<FrameSubscriber> frame_subscriber_;
+  std::unique_ptr<VideoRecorder> video_recorder_;
+
+  // Whether the renderer was torn down by Discard() and the page has not been
+  // loaded again yet.
+  bool discarded_ = false;
+  base::OnceClosure on_restored_;
+  base::Time last_active_time_;
+
+  // The spare renderer profile of the webPreferences, empty when the session
+  // doesn't keep spare renderers.
+  std::string spare_renderer_profile_;
+  bool used_spare_renderer_ = false;
+  // Stays set after the page moves to another renderer, compare it with the
+  // current one.
+  int shared_renderer_id_ = content::ChildProcessHost::kInvalidUniqueID;
+  base::TimeTicks creation_time_;
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   std::unique_ptr<extensions::ScriptExecutor> script_executor_;
@@ -136,12 +136,30 @@ void WebFrameMain::Send(v8::Isolate* isolate,
   if (!CheckRenderFrame())
     return;
 
-  GetRendererApi()->Message(internal, channel, std::move(message),
-                            0 /* sender_id */);
+  SendIPCMessage(internal, channel, std::move(message), 0 /* sender_id */);
+}
+
+void WebFrameMain::SendIPCMessage(bool internal,
+                                  const std::string& channel,
+                                  blink::CloneableMessage arguments,
+                                  int32_t sender_id) {
+  const auto& renderer_api = GetRendererApi();
+  uint32_t channel_id;
+  bool is_new;
+  if (!renderer_channels_.Intern(channel, &channel_id, &is_new)) {
+    renderer_api->Message(internal, mojom::IPCChannel::NewName(channel),
+                          std::move(arguments), sender_id);
+    return;
+  }
+  if (is_new)
+    renderer_api->RegisterChannel(channel_id, channel);
+  renderer_api->Message(internal, mojom::IPCChannel::NewId(channel_id),
+                        std::move(arguments), sender_id);
 }
 
 const mojo::Remote<mojom::ElectronRenderer>& WebFrameMain::GetRendererApi() {
   if (!renderer_api_) {
+    renderer_channels_.Clear();
     pending_receiver_ = renderer_api_.BindNewPipeAndPassReceiver();
     if (render_frame_->IsRenderFrameCreated()) {
       render_frame_->GetRemoteInterfaces()->GetInterface(
@@ -15,6 +15,8 @@
 #include "gin/wrappable.h"
 #include "shell/common/gin_helper/constructible.h"
 #include "shell/common/gin_helper/pinnable.h"
+#include "shell/common/ipc_channel_table.h"
+#include "third_party/blink/public/common/messaging/cloneable_message.h"
 
 class GURL;
 
@@ -60,6 +62,13 @@ class WebFrameMain : public gin::Wrappable<WebFrameMain>,
 
   const mojo::Remote<mojom::ElectronRenderer>& GetRendererApi();
 
+  // Emits |channel| on the frame's ipcRenderer, registering the channel with
+  // the renderer the first time it is used on the current connection.
+  void SendIPCMessage(bool internal,
+                      const std::string& channel,
+                      blink::CloneableMessage arguments,
+                      int32_t sender_id);
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   static v8::Local<v8::ObjectTemplate> FillObjectTemplate(
@@ -106,6 +115,9 @@ class WebFrameMain : public gin::Wrappable<WebFrameMain>,
   mojo::Remote<mojom::ElectronRenderer> renderer_api_;
   mojo::PendingReceiver<mojom::ElectronRenderer> pending_receiver_;
 
+  // Channels registered with the renderer on |renderer_api_|.
+  IPCChannelTable renderer_channels_;
+
   content::RenderFrameHost* render_frame_ = nullptr;
 
   // Whether the RenderFrameHost has been removed and that it should no longer
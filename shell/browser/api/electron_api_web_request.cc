@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "base/stl_util.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "extensions/browser/api/web_request/web_request_resource_type.h"
 #include "gin/converter.h"
@@ -439,6 +440,8 @@ void WebRequest::HandleSimpleEvent(SimpleEvent event,
   if (!MatchesFilterCondition(request_info, info.url_patterns))
     return;
 
+  TRACE_EVENT2("electron.webrequest", "WebRequest::HandleSimpleEvent", "event",
+               GetEventName(event), "url", request_info->url.spec());
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   gin::Dictionary details(isolate, v8::Object::New(isolate));
@@ -462,6 +465,12 @@ int WebRequest::HandleResponseEvent(ResponseEvent event,
 
   callbacks_[request_info->id] = std::move(callback);
 
+  // The span ends in OnListenerResult once the listener calls back.
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN2(
+      "electron.webrequest", "WebRequest::HandleResponseEvent",
+      TRACE_ID_LOCAL(request_info->id), "event", GetEventName(event), "url",
+      request_info->url.spec());
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   gin::Dictionary details(isolate, v8::Object::New(isolate));
@@ -500,6 +509,41 @@ void WebRequest::OnListenerResult(uint64_t id,
   base::SequencedTaskRunnerHandle::Get()->PostTask(
       FROM_HERE, base::BindOnce(std::move(callbacks_[id]), result));
   callbacks_.erase(iter);
+  TRACE_EVENT_NESTABLE_ASYNC_END1("electron.webrequest",
+                                  "WebRequest::HandleResponseEvent",
+                                  TRACE_ID_LOCAL(id), "result", result);
+}
+
+// static
+const char* WebRequest::GetEventName(SimpleEvent event) {
+  switch (event) {
+    case SimpleEvent::kOnSendHeaders:
+      return "onSendHeaders";
+    case SimpleEvent::kOnBeforeRedirect:
+      return "onBeforeRedirect";
+    case SimpleEvent::kOnResponseStarted:
+      return "onResponseStarted";
+    case SimpleEvent::kOnCompleted:
+      return "onCompleted";
+    case SimpleEvent::kOnErrorOccurred:
+      return "onErrorOccurred";
+  }
+  NOTREACHED();
+  return "";
+}
+
+// static
+const char* WebRequest::GetEventName(ResponseEvent event) {
+  switch (event) {
+    case ResponseEvent::kOnBeforeRequest:
+      return "onBeforeRequest";
+    case ResponseEvent::kOnBeforeSendHeaders:
+      return "onBeforeSendHeaders";
+    case ResponseEvent::kOnHeadersReceived:
+      return "onHeadersReceived";
+  }
+  NOTREACHED();
+  return "";
 }
 
 // static
@@ -125,6 +125,10 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   template <typename T>
   void OnListenerResult(uint64_t id, T out, v8::Local<v8::Value> response);
 
+  // Names used when tracing listener invocations.
+  static const char* GetEventName(SimpleEvent event);
+  static const char* GetEventName(ResponseEvent event);
+
   struct SimpleListenerInfo {
     std::set<URLPattern> url_patterns;
     SimpleListener listener;
@@ -0,0 +1,152 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/renderer_memory_manager.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/stl_util.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/global_memory_dump.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
+#include "shell/browser/api/electron_api_web_contents.h"
+
+namespace electron {
+
+namespace api {
+
+RendererMemoryManager::RendererMemoryManager(
+    content::BrowserContext* browser_context,
+    const Options& options)
+    : browser_context_(browser_context), options_(options) {
+  timer_.Start(FROM_HERE, options_.interval, this,
+               &RendererMemoryManager::RequestMemoryDump);
+  memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+      FROM_HERE, base::BindRepeating(&RendererMemoryManager::OnMemoryPressure,
+                                     base::Unretained(this)));
+}
+
+RendererMemoryManager::~RendererMemoryManager() = default;
+
+// static
+std::vector<WebContents*> RendererMemoryManager::SelectLeastRecentlyActive(
+    const std::vector<Candidate>& candidates,
+    uint64_t excess_kb) {
+  std::vector<const Candidate*> sorted;
+  for (const auto& candidate : candidates)
+    sorted.push_back(&candidate);
+  std::sort(sorted.begin(), sorted.end(),
+            [](const Candidate* a, const Candidate* b) {
+              return a->last_active_time < b->last_active_time;
+            });
+
+  std::vector<WebContents*> result;
+  uint64_t freed_kb = 0;
+  for (const auto* candidate : sorted) {
+    if (freed_kb >= excess_kb)
+      break;
+    result.push_back(candidate->web_contents);
+    freed_kb += candidate->private_memory_kb;
+  }
+  return result;
+}
+
+void RendererMemoryManager::RequestMemoryDump() {
+  auto* instrumentation =
+      memory_instrumentation::MemoryInstrumentation::GetInstance();
+  if (dump_pending_ || !instrumentation)
+    return;
+  dump_pending_ = true;
+  instrumentation->RequestPrivateMemoryFootprint(
+      base::kNullProcessId,
+      base::BindOnce(&RendererMemoryManager::OnMemoryDump,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void RendererMemoryManager::OnMemoryDump(
+    bool success,
+    std::unique_ptr<memory_instrumentation::GlobalMemoryDump> dump) {
+  dump_pending_ = false;
+  if (!success || !dump)
+    return;
+
+  std::map<base::ProcessId, uint64_t> footprints;
+  for (const auto& process_dump : dump->process_dumps()) {
+    footprints[process_dump.pid()] =
+        process_dump.os_dump().private_footprint_kb;
+  }
+
+  // Processes can be shared between pages, count each of them once.
+  std::set<base::ProcessId> counted;
+  uint64_t usage_kb = 0;
+  std::vector<Candidate> candidates;
+  for (auto* web_contents : WebContents::GetAll()) {
+    if (!web_contents->web_contents() ||
+        web_contents->GetBrowserContext() != browser_context_)
+      continue;
+    content::RenderProcessHost* process =
+        web_contents->web_contents()->GetMainFrame()->GetProcess();
+    if (!process->IsReady())
+      continue;
+    auto it = footprints.find(process->GetProcess().Pid());
+    if (it == footprints.end())
+      continue;
+    if (counted.insert(it->first).second)
+      usage_kb += it->second;
+    // Discarding shuts the process down, which only works for pages that
+    // have their process to themselves.
+    if (web_contents->CanDiscard() && process->GetActiveViewCount() <= 1) {
+      candidates.push_back(
+          {web_contents, it->second, web_contents->last_active_time()});
+    }
+  }
+
+  metrics_.usage_kb = usage_kb;
+  if (usage_kb <= options_.budget_kb)
+    return;
+  metrics_.pressure_events++;
+  if (candidates.empty())
+    return;
+
+  uint64_t excess_kb = usage_kb - options_.budget_kb;
+  auto weak_this = weak_factory_.GetWeakPtr();
+  std::vector<WebContents*> selected =
+      options_.policy ? options_.policy.Run(candidates, excess_kb)
+                      : SelectLeastRecentlyActive(candidates, excess_kb);
+  // The policy may have changed the budget or closed pages.
+  if (!weak_this)
+    return;
+
+  std::vector<WebContents*> live = WebContents::GetAll();
+  for (auto* web_contents : selected) {
+    if (!base::Contains(live, web_contents) ||
+        web_contents->GetBrowserContext() != browser_context_)
+      continue;
+    if (web_contents->DiscardAndNotify(base::BindOnce(
+            &RendererMemoryManager::OnRestored, weak_factory_.GetWeakPtr())))
+      metrics_.discards++;
+  }
+}
+
+void RendererMemoryManager::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  if (level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+    return;
+  metrics_.system_pressure_events++;
+  RequestMemoryDump();
+}
+
+void RendererMemoryManager::OnRestored() {
+  metrics_.restores++;
+}
+
+}  // namespace api
+
+}  // namespace electron
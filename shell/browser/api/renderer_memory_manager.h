@@ -0,0 +1,107 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_RENDERER_MEMORY_MANAGER_H_
+#define SHELL_BROWSER_API_RENDERER_MEMORY_MANAGER_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace content {
+class BrowserContext;
+}
+
+namespace memory_instrumentation {
+class GlobalMemoryDump;
+}
+
+namespace electron {
+
+namespace api {
+
+class WebContents;
+
+// Keeps the renderers of a session's webContents within a memory budget.
+// Their private memory footprints are sampled periodically, and whenever they
+// add up to more than the budget, hidden webContents are discarded until
+// enough memory would be freed. Discarded pages are reloaded when they are
+// shown again.
+class RendererMemoryManager {
+ public:
+  struct Candidate {
+    WebContents* web_contents;
+    // Footprint of the renderer process hosting the page.
+    uint64_t private_memory_kb;
+    base::Time last_active_time;
+  };
+
+  // Returns the candidates to discard, in order, given how far over the
+  // budget the renderers are.
+  using Policy = base::RepeatingCallback<std::vector<WebContents*>(
+      const std::vector<Candidate>& candidates,
+      uint64_t excess_kb)>;
+
+  struct Options {
+    uint64_t budget_kb = 0;
+    base::TimeDelta interval = base::TimeDelta::FromSeconds(10);
+    // The least recently shown or focused pages are discarded first when no
+    // policy is set.
+    Policy policy;
+  };
+
+  struct Metrics {
+    // Renderer footprint at the last sample.
+    uint64_t usage_kb = 0;
+    // Number of samples that were over the budget.
+    uint64_t pressure_events = 0;
+    // Number of memory pressure notifications from the system.
+    uint64_t system_pressure_events = 0;
+    uint64_t discards = 0;
+    uint64_t restores = 0;
+  };
+
+  RendererMemoryManager(content::BrowserContext* browser_context,
+                        const Options& options);
+  ~RendererMemoryManager();
+
+  static std::vector<WebContents*> SelectLeastRecentlyActive(
+      const std::vector<Candidate>& candidates,
+      uint64_t excess_kb);
+
+  const Options& options() const { return options_; }
+  const Metrics& metrics() const { return metrics_; }
+
+ private:
+  void RequestMemoryDump();
+  void OnMemoryDump(
+      bool success,
+      std::unique_ptr<memory_instrumentation::GlobalMemoryDump> dump);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+  void OnRestored();
+
+  content::BrowserContext* browser_context_;
+  const Options options_;
+  Metrics metrics_;
+
+  base::RepeatingTimer timer_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+  bool dump_pending_ = false;
+
+  base::WeakPtrFactory<RendererMemoryManager> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(RendererMemoryManager);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_API_RENDERER_MEMORY_MANAGER_H_
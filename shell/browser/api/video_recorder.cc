@@ -0,0 +1,357 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/video_recorder.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/bind_post_task.h"
+#include "base/files/file.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "content/public/browser/render_view_host.h"
+#include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/render_widget_host_view.h"
+#include "media/base/video_encoder.h"
+#include "media/base/video_frame.h"
+#include "media/capture/mojom/video_capture_types.mojom.h"
+#include "media/muxers/webm_muxer.h"
+#include "media/video/vpx_video_encoder.h"
+#include "ui/gfx/geometry/size_conversions.h"
+
+namespace electron {
+
+namespace api {
+
+namespace {
+
+// Frames are dropped rather than queued once the encoder is this far behind,
+// which keeps the memory used by a slow recording bounded.
+constexpr int kMaxPendingFrames = 3;
+
+// Emit a key frame every couple of seconds so that streamed recordings can be
+// joined mid-way and files stay seekable.
+constexpr int kKeyFrameIntervalSeconds = 2;
+
+gfx::Size GetViewPixelSize(content::RenderWidgetHostView* view) {
+  gfx::Size size = gfx::ToRoundedSize(gfx::ScaleSize(
+      gfx::SizeF(view->GetViewBounds().size()), view->GetDeviceScaleFactor()));
+  // I420 frames must have even dimensions.
+  return gfx::Size(size.width() & ~1, size.height() & ~1);
+}
+
+}  // namespace
+
+// Owns the libvpx encoder, the WebM muxer and the output file. Constructed on
+// the UI thread but otherwise only used on the encoder sequence.
+class VideoRecorder::Encoder {
+ public:
+  Encoder(const Options& options,
+          const DataCallback& data_callback,
+          const base::RepeatingClosure& frame_done_callback)
+      : options_(options),
+        data_callback_(data_callback),
+        frame_done_callback_(frame_done_callback) {}
+
+  ~Encoder() = default;
+
+  void Encode(scoped_refptr<media::VideoFrame> frame) {
+    if (!encoder_ && error_.empty())
+      Initialize(frame->visible_rect().size());
+    if (!error_.empty()) {
+      frame_done_callback_.Run();
+      return;
+    }
+
+    // Key frames are placed by libvpx according to |keyframe_interval|.
+    encoder_->Encode(std::move(frame), false /* key_frame */,
+                     base::BindOnce(&Encoder::OnEncodeDone,
+                                    weak_ptr_factory_.GetWeakPtr()));
+  }
+
+  void Finish(StopCallback callback) {
+    if (!encoder_) {
+      Finalize(std::move(callback));
+      return;
+    }
+    encoder_->Flush(base::BindOnce(&Encoder::OnFlushed,
+                                   weak_ptr_factory_.GetWeakPtr(),
+                                   std::move(callback)));
+  }
+
+ private:
+  void Initialize(const gfx::Size& frame_size) {
+    frame_size_ = frame_size;
+
+    if (!options_.path.empty()) {
+      file_.Initialize(options_.path, base::File::FLAG_CREATE_ALWAYS |
+                                          base::File::FLAG_WRITE);
+      if (!file_.IsValid()) {
+        error_ = "Failed to open " + options_.path.AsUTF8Unsafe() + ": " +
+                 base::File::ErrorToString(file_.error_details());
+        return;
+      }
+    }
+
+    muxer_ = std::make_unique<media::WebmMuxer>(
+        media::kUnknownAudioCodec, true /* has_video */, false /* has_audio */,
+        base::BindRepeating(&Encoder::OnMuxedData, base::Unretained(this)));
+
+    media::VideoEncoder::Options encoder_options;
+    encoder_options.bitrate = options_.bitrate;
+    encoder_options.framerate = options_.frame_rate;
+    encoder_options.frame_size = frame_size_;
+    encoder_options.keyframe_interval =
+        options_.frame_rate * kKeyFrameIntervalSeconds;
+
+    encoder_ = std::make_unique<media::VpxVideoEncoder>();
+    encoder_->Initialize(
+        options_.codec == media::kCodecVP9 ? media::VP9PROFILE_PROFILE0
+                                           : media::VP8PROFILE_ANY,
+        encoder_options,
+        base::BindRepeating(&Encoder::OnEncoderOutput,
+                            weak_ptr_factory_.GetWeakPtr()),
+        base::BindOnce(&Encoder::OnStatus, weak_ptr_factory_.GetWeakPtr()));
+  }
+
+  void OnStatus(media::Status status) {
+    if (!status.is_ok() && error_.empty())
+      error_ = "Video encoder error: " + status.message();
+  }
+
+  void OnEncodeDone(media::Status status) {
+    OnStatus(std::move(status));
+    frame_done_callback_.Run();
+  }
+
+  void OnEncoderOutput(
+      media::VideoEncoderOutput output,
+      base::Optional<media::VideoEncoder::CodecDescription> description) {
+    if (!error_.empty())
+      return;
+    media::WebmMuxer::VideoParameters params(frame_size_, options_.frame_rate,
+                                             options_.codec, base::nullopt);
+    std::string data(reinterpret_cast<const char*>(output.data.get()),
+                     output.size);
+    if (!muxer_->OnEncodedVideo(params, std::move(data), std::string(),
+                                base::TimeTicks() + output.timestamp,
+                                output.key_frame)) {
+      error_ = "Failed to mux encoded video";
+      return;
+    }
+    FlushMuxedData();
+  }
+
+  void OnFlushed(StopCallback callback, media::Status status) {
+    OnStatus(std::move(status));
+    Finalize(std::move(callback));
+  }
+
+  void Finalize(StopCallback callback) {
+    if (muxer_ && error_.empty()) {
+      muxer_->Flush();
+      FlushMuxedData();
+    }
+    muxer_.reset();
+    encoder_.reset();
+    file_.Close();
+    std::move(callback).Run(error_);
+  }
+
+  // The muxer writes many small pieces per frame, batch them up so that each
+  // encoded frame results in a single write or chunk.
+  void OnMuxedData(base::StringPiece data) {
+    data.AppendToString(&muxed_data_);
+  }
+
+  void FlushMuxedData() {
+    if (muxed_data_.empty())
+      return;
+    if (file_.IsValid()) {
+      if (file_.WriteAtCurrentPos(muxed_data_.data(), muxed_data_.size()) !=
+          static_cast<int>(muxed_data_.size())) {
+        error_ = "Failed to write to " + options_.path.AsUTF8Unsafe();
+      }
+    } else {
+      data_callback_.Run(muxed_data_);
+    }
+    muxed_data_.clear();
+  }
+
+  const Options options_;
+  // Both post to the UI thread.
+  DataCallback data_callback_;
+  base::RepeatingClosure frame_done_callback_;
+
+  gfx::Size frame_size_;
+  std::string error_;
+  std::string muxed_data_;
+
+  base::File file_;
+  std::unique_ptr<media::WebmMuxer> muxer_;
+  std::unique_ptr<media::VpxVideoEncoder> encoder_;
+
+  base::WeakPtrFactory<Encoder> weak_ptr_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(Encoder);
+};
+
+VideoRecorder::VideoRecorder(content::WebContents* web_contents,
+                             const Options& options,
+                             const DataCallback& data_callback)
+    : content::WebContentsObserver(web_contents),
+      options_(options),
+      encoder_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      encoder_(nullptr, base::OnTaskRunnerDeleter(encoder_task_runner_)) {
+  scoped_refptr<base::SequencedTaskRunner> ui_task_runner =
+      base::SequencedTaskRunnerHandle::Get();
+  encoder_.reset(new Encoder(
+      options, base::BindPostTask(ui_task_runner, data_callback),
+      base::BindPostTask(ui_task_runner,
+                         base::BindRepeating(&VideoRecorder::OnFrameEncoded,
+                                             weak_ptr_factory_.GetWeakPtr()))));
+
+  content::RenderViewHost* rvh = web_contents->GetRenderViewHost();
+  if (rvh)
+    AttachToHost(rvh->GetWidget());
+}
+
+VideoRecorder::~VideoRecorder() = default;
+
+void VideoRecorder::Stop(StopCallback callback) {
+  DCHECK(!stopped_);
+  stopped_ = true;
+  DetachFromHost();
+  encoder_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&Encoder::Finish, base::Unretained(encoder_.get()),
+                     base::BindPostTask(base::SequencedTaskRunnerHandle::Get(),
+                                        std::move(callback))));
+}
+
+void VideoRecorder::AttachToHost(content::RenderWidgetHost* host) {
+  host_ = host;
+
+  // The view can be null if the renderer process has crashed.
+  if (!host_->GetView())
+    return;
+
+  // The encoder is configured with the size of the first frame, so keep
+  // capturing at that size even if the view is resized or swapped.
+  if (frame_size_.IsEmpty())
+    frame_size_ = GetViewPixelSize(host_->GetView());
+  if (frame_size_.IsEmpty())
+    return;
+
+  video_capturer_ = host_->GetView()->CreateVideoCapturer();
+  video_capturer_->SetResolutionConstraints(frame_size_, frame_size_, true);
+  video_capturer_->SetAutoThrottlingEnabled(false);
+  video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
+  video_capturer_->SetFormat(media::PIXEL_FORMAT_I420,
+                             gfx::ColorSpace::CreateREC709());
+  video_capturer_->SetMinCapturePeriod(base::TimeDelta::FromSeconds(1) /
+                                       options_.frame_rate);
+  video_capturer_->Start(this);
+}
+
+void VideoRecorder::DetachFromHost() {
+  if (!host_)
+    return;
+  video_capturer_.reset();
+  host_ = nullptr;
+}
+
+void VideoRecorder::RenderFrameCreated(
+    content::RenderFrameHost* render_frame_host) {
+  if (!host_ && !stopped_)
+    AttachToHost(render_frame_host->GetRenderWidgetHost());
+}
+
+void VideoRecorder::RenderViewDeleted(content::RenderViewHost* host) {
+  if (host->GetWidget() == host_)
+    DetachFromHost();
+}
+
+void VideoRecorder::RenderViewHostChanged(content::RenderViewHost* old_host,
+                                          content::RenderViewHost* new_host) {
+  if (stopped_)
+    return;
+  if ((old_host && old_host->GetWidget() == host_) || (!old_host && !host_)) {
+    DetachFromHost();
+    AttachToHost(new_host->GetWidget());
+  }
+}
+
+void VideoRecorder::OnFrameCaptured(
+    base::ReadOnlySharedMemoryRegion data,
+    ::media::mojom::VideoFrameInfoPtr info,
+    const gfx::Rect& content_rect,
+    mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+        callbacks) {
+  // Dropping |callbacks| tells the capturer that the frame can be recycled.
+  if (stopped_ || !data.IsValid() || pending_frames_ >= kMaxPendingFrames ||
+      info->visible_rect.size() != frame_size_) {
+    return;
+  }
+
+  base::ReadOnlySharedMemoryMapping mapping = data.Map();
+  if (!mapping.IsValid()) {
+    DLOG(ERROR) << "Shared memory mapping failed.";
+    return;
+  }
+  if (mapping.size() <
+      media::VideoFrame::AllocationSize(info->pixel_format, info->coded_size)) {
+    DLOG(ERROR) << "Shared memory size was less than expected.";
+    return;
+  }
+
+  // Timestamps restart whenever the capturer is recreated, so derive them from
+  // the capture time instead to keep them increasing across view swaps.
+  base::TimeTicks reference_time =
+      info->metadata.reference_time.value_or(base::TimeTicks::Now());
+  if (start_time_.is_null())
+    start_time_ = reference_time;
+
+  // The frame only reads the pixels, but WrapExternalData() requires a
+  // non-const pointer. So, cast away the const.
+  scoped_refptr<media::VideoFrame> frame = media::VideoFrame::WrapExternalData(
+      info->pixel_format, info->coded_size, info->visible_rect,
+      info->visible_rect.size(),
+      static_cast<uint8_t*>(const_cast<void*>(mapping.memory())),
+      mapping.size(), reference_time - start_time_);
+  if (!frame)
+    return;
+  frame->set_color_space(info->color_space);
+
+  // Keep the shared memory mapped, and prevent FrameSinkVideoCapturer from
+  // recycling it, until the encoder has released the frame. Unlike a Remote
+  // the PendingRemote may be dropped on the encoder sequence.
+  frame->AddDestructionObserver(base::BindOnce(
+      [](base::ReadOnlySharedMemoryMapping mapping,
+         mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+             callbacks) {},
+      std::move(mapping), std::move(callbacks)));
+
+  ++pending_frames_;
+  encoder_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&Encoder::Encode,
+                                base::Unretained(encoder_.get()),
+                                std::move(frame)));
+}
+
+void VideoRecorder::OnStopped() {}
+
+void VideoRecorder::OnLog(const std::string& message) {}
+
+void VideoRecorder::OnFrameEncoded() {
+  DCHECK_GT(pending_frames_, 0);
+  --pending_frames_;
+}
+
+}  // namespace api
+
+}  // namespace electron
@@ -0,0 +1,105 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_VIDEO_RECORDER_H_
+#define SHELL_BROWSER_API_VIDEO_RECORDER_H_
+
+#include <memory>
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "components/viz/host/client_frame_sink_video_capturer.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "media/base/video_codecs.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+
+namespace electron {
+
+namespace api {
+
+// Captures the frames of a WebContents and encodes them to WebM with the
+// bundled libvpx software encoder. Frames are captured as I420 straight from
+// the compositor and handed to a dedicated encoder sequence, so neither the
+// raw pixels nor the encoding work ever touch the main thread's isolate.
+class VideoRecorder : public content::WebContentsObserver,
+                      public viz::mojom::FrameSinkVideoConsumer {
+ public:
+  struct Options {
+    // When empty the encoded WebM stream is passed to the |data_callback|.
+    base::FilePath path;
+    media::VideoCodec codec = media::kCodecVP8;
+    uint32_t bitrate = 2500000;
+    int frame_rate = 30;
+  };
+
+  // Both run on the UI thread.
+  using DataCallback = base::RepeatingCallback<void(const std::string& chunk)>;
+  using StopCallback = base::OnceCallback<void(const std::string& error)>;
+
+  VideoRecorder(content::WebContents* web_contents,
+                const Options& options,
+                const DataCallback& data_callback);
+  ~VideoRecorder() override;
+
+  // Flushes the encoder and finalizes the output; |callback| receives an
+  // empty string on success. No frames are captured after this is called.
+  void Stop(StopCallback callback);
+
+  bool stopped() const { return stopped_; }
+
+ private:
+  class Encoder;
+
+  void AttachToHost(content::RenderWidgetHost* host);
+  void DetachFromHost();
+
+  void RenderFrameCreated(content::RenderFrameHost* render_frame_host) override;
+  void RenderViewDeleted(content::RenderViewHost* host) override;
+  void RenderViewHostChanged(content::RenderViewHost* old_host,
+                             content::RenderViewHost* new_host) override;
+
+  // viz::mojom::FrameSinkVideoConsumer implementation.
+  void OnFrameCaptured(
+      base::ReadOnlySharedMemoryRegion data,
+      ::media::mojom::VideoFrameInfoPtr info,
+      const gfx::Rect& content_rect,
+      mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+          callbacks) override;
+  void OnStopped() override;
+  void OnLog(const std::string& message) override;
+
+  void OnFrameEncoded();
+
+  const Options options_;
+  // The size of the first captured view; the capturer letterboxes later
+  // frames into it since the encoder cannot change resolution mid-stream.
+  gfx::Size frame_size_;
+  base::TimeTicks start_time_;
+  // Number of frames handed to the encoder that it has not finished with,
+  // frames are dropped instead of queued once the encoder falls behind.
+  int pending_frames_ = 0;
+  bool stopped_ = false;
+
+  content::RenderWidgetHost* host_ = nullptr;
+  std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
+
+  scoped_refptr<base::SequencedTaskRunner> encoder_task_runner_;
+  // Lives on |encoder_task_runner_| and is deleted there after all of the
+  // tasks that were posted to it have run.
+  std::unique_ptr<Encoder, base::OnTaskRunnerDeleter> encoder_;
+
+  base::WeakPtrFactory<VideoRecorder> weak_ptr_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(VideoRecorder);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_API_VIDEO_RECORDER_H_
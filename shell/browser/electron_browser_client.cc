@@ -8,7 +8,10 @@
 #include <shlobj.h>
 #endif
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <set>
 #include <utility>
 
 #include "base/base_switches.h"
@@ -518,6 +521,84 @@ content::SiteInstance* ElectronBrowserClient::GetSiteInstanceFromAffinity(
   return nullptr;
 }
 
+content::SiteInstance* ElectronBrowserClient::GetSiteInstanceFromSharingPolicy(
+    content::BrowserContext* browser_context,
+    const GURL& url,
+    content::RenderFrameHost* current_rfh,
+    content::RenderFrameHost* speculative_rfh) const {
+  auto* session_preferences =
+      SessionPreferences::FromBrowserContext(browser_context);
+  if (!session_preferences ||
+      !session_preferences->renderer_sharing_policy().enabled())
+    return nullptr;
+  if (url.SchemeIs(url::kJavaScriptScheme) || url.IsAboutBlank())
+    return nullptr;
+
+  auto* web_contents = content::WebContents::FromRenderFrameHost(current_rfh);
+  auto* web_preferences = WebContentsPreferences::From(web_contents);
+  if (!web_preferences)
+    return nullptr;
+
+  // Same-site navigations of a page stay in its renderer, and so does the
+  // first page of a webContents that was handed a spare renderer.
+  content::RenderProcessHost* current_process = current_rfh->GetProcess();
+  if (current_process->IsUnused()) {
+    auto* api_web_contents = api::WebContents::From(web_contents);
+    if (api_web_contents && api_web_contents->used_spare_renderer())
+      return nullptr;
+  } else if (IsSameWebSite(browser_context, current_rfh->GetSiteInstance(),
+                           url)) {
+    return nullptr;
+  }
+
+  // Renderers hosting the session's other pages, and the pages hosted by each
+  // renderer that could also host this one.
+  std::set<int> renderers;
+  std::map<int, int> compatible_pages;
+  std::map<int, content::SiteInstance*> compatible_site_instances;
+  for (auto* preferences : WebContentsPreferences::instances_) {
+    content::WebContents* other = preferences->web_contents_;
+    if (other == web_contents || other->GetBrowserContext() != browser_context)
+      continue;
+    content::RenderFrameHost* main_frame = other->GetMainFrame();
+    content::RenderProcessHost* process = main_frame->GetProcess();
+    if (!process->IsInitializedAndNotDead())
+      continue;
+    renderers.insert(process->GetID());
+    content::SiteInstance* site_instance = main_frame->GetSiteInstance();
+    if (preferences->IsRendererCompatibleWith(*web_preferences) &&
+        IsSameWebSite(browser_context, site_instance, url)) {
+      compatible_pages[process->GetID()]++;
+      compatible_site_instances.emplace(process->GetID(), site_instance);
+    }
+  }
+  if (compatible_pages.empty())
+    return nullptr;
+
+  // The decision is taken when the navigation starts, later calls keep it.
+  if (speculative_rfh) {
+    int process_id = speculative_rfh->GetProcess()->GetID();
+    return base::Contains(compatible_pages, process_id)
+               ? speculative_rfh->GetSiteInstance()
+               : nullptr;
+  }
+
+  const auto& policy = session_preferences->renderer_sharing_policy();
+  bool over_limit =
+      policy.max_renderers && renderers.size() >= policy.max_renderers;
+  bool over_threshold = policy.sharing_threshold &&
+                        compatible_pages.size() >= policy.sharing_threshold;
+  if (!over_limit && !over_threshold)
+    return nullptr;
+
+  // Use the renderer hosting the fewest pages, which is the first one when
+  // several host as many.
+  auto least_used = std::min_element(
+      compatible_pages.begin(), compatible_pages.end(),
+      [](const auto& a, const auto& b) { return a.second < b.second; });
+  return compatible_site_instances[least_used->first];
+}
+
 void ElectronBrowserClient::ConsiderSiteInstanceForAffinity(
     content::RenderFrameHost* rfh,
     content::SiteInstance* site_instance) {
@@ -527,6 +608,19 @@ void ElectronBrowserClient::ConsiderSiteInstanceForAffinity(
   }
 }
 
+void ElectronBrowserClient::RecordSharedNavigation(
+    content::RenderFrameHost* rfh,
+    int process_id) {
+  auto* web_contents = content::WebContents::FromRenderFrameHost(rfh);
+  auto* session_preferences =
+      SessionPreferences::FromBrowserContext(web_contents->GetBrowserContext());
+  if (session_preferences)
+    session_preferences->RecordSharedNavigation();
+  auto* api_web_contents = api::WebContents::From(web_contents);
+  if (api_web_contents)
+    api_web_contents->set_shared_renderer_id(process_id);
+}
+
 bool ElectronBrowserClient::IsRendererSubFrame(int process_id) const {
   return base::Contains(renderer_is_subframe_, process_id);
 }
@@ -554,12 +648,11 @@ void ElectronBrowserClient::RenderProcessWillLaunch(
   auto* web_preferences =
       WebContentsPreferences::From(GetWebContentsFromProcessID(process_id));
   if (web_preferences) {
-    prefs.sandbox = web_preferences->IsEnabled(options::kSandbox);
-    prefs.native_window_open =
-        web_preferences->IsEnabled(options::kNativeWindowOpen);
-    prefs.disable_popups = web_preferences->IsEnabled("disablePopups");
-    prefs.web_security = web_preferences->IsEnabled(options::kWebSecurity,
-                                                    true /* default value */);
+    const auto& parsed = web_preferences->parsed();
+    prefs.sandbox = parsed.sandbox;
+    prefs.native_window_open = parsed.native_window_open;
+    prefs.disable_popups = parsed.disable_popups;
+    prefs.web_security = parsed.web_security;
     prefs.browser_context = host->GetBrowserContext();
   }
 
@@ -631,6 +724,24 @@ bool ElectronBrowserClient::CanUseCustomSiteInstance() {
   return disable_process_restart_tricks_;
 }
 
+bool ElectronBrowserClient::LaunchSpareRenderer(
+    content::SiteInstance* site_instance,
+    content::WebContents* web_contents) {
+  content::RenderProcessHost* process = site_instance->GetProcess();
+  if (process->IsInitializedAndNotDead())
+    return false;
+
+  // The launch reads the preferences through GetWebContentsFromProcessID(),
+  // afterwards they come from the page the renderer ends up hosting.
+  int process_id = process->GetID();
+  pending_processes_[process_id] = web_contents;
+  spare_processes_.insert(process_id);
+  bool launched = process->Init();
+  pending_processes_.erase(process_id);
+  spare_processes_.erase(process_id);
+  return launched;
+}
+
 content::ContentBrowserClient::SiteInstanceForNavigationType
 ElectronBrowserClient::ShouldOverrideSiteInstanceForNavigation(
     content::RenderFrameHost* current_rfh,
@@ -640,11 +751,35 @@ ElectronBrowserClient::ShouldOverrideSiteInstanceForNavigation(
     bool has_navigation_started,
     bool has_response_started,
     content::SiteInstance** affinity_site_instance) const {
+  pending_shared_navigations_.erase(current_rfh->GetFrameTreeNodeId());
+
+  // History navigations go back to the SiteInstance of their entry.
   if (g_suppress_renderer_process_restart) {
     g_suppress_renderer_process_restart = false;
     return SiteInstanceForNavigationType::ASK_CHROMIUM;
   }
 
+  // When renderers are reused Chromium picks them, unless the session's
+  // sharing policy places the page in an existing one. The page still gets
+  // its own SiteInstance, so it doesn't join the BrowsingInstance of the
+  // pages it shares the renderer with.
+  if (disable_process_restart_tricks_) {
+    content::SiteInstance* shared_site_instance =
+        GetSiteInstanceFromSharingPolicy(browser_context, url, current_rfh,
+                                         speculative_rfh);
+    if (!shared_site_instance)
+      return SiteInstanceForNavigationType::ASK_CHROMIUM;
+    *affinity_site_instance = shared_site_instance;
+    if (speculative_rfh &&
+        speculative_rfh->GetSiteInstance() == shared_site_instance)
+      return SiteInstanceForNavigationType::FORCE_AFFINITY;
+    // Chromium may still decide the renderer isn't suitable, the navigation
+    // is counted once its SiteInstance is registered.
+    pending_shared_navigations_[current_rfh->GetFrameTreeNodeId()] =
+        shared_site_instance->GetProcess()->GetID();
+    return SiteInstanceForNavigationType::FORCE_NEW_IN_AFFINITY_PROCESS;
+  }
+
   // Do we have an affinity site to manage ?
   content::SiteInstance* site_instance_from_affinity =
       GetSiteInstanceFromAffinity(browser_context, url, current_rfh);
@@ -688,6 +823,15 @@ void ElectronBrowserClient::RegisterPendingSiteInstance(
   // Do we have an affinity site to manage?
   ConsiderSiteInstanceForAffinity(rfh, pending_site_instance);
 
+  auto shared = pending_shared_navigations_.find(rfh->GetFrameTreeNodeId());
+  if (shared != pending_shared_navigations_.end()) {
+    if (pending_site_instance->HasProcess() &&
+        pending_site_instance->GetProcess()->GetID() == shared->second) {
+      RecordSharedNavigation(rfh, shared->second);
+    }
+    pending_shared_navigations_.erase(shared);
+  }
+
   // Remember the original web contents for the pending renderer process.
   auto* web_contents = content::WebContents::FromRenderFrameHost(rfh);
   auto* pending_process = pending_site_instance->GetProcess();
@@ -769,7 +913,8 @@ void ElectronBrowserClient::AppendExtraCommandLineSwitches(
         switches::kSecureSchemes,        switches::kBypassCSPSchemes,
         switches::kCORSSchemes,          switches::kFetchSchemes,
         switches::kServiceWorkerSchemes, switches::kEnableApiFilteringLogging,
-        switches::kStreamingSchemes};
+        switches::kStreamingSchemes,     switches::kNodeLoopTimeSlice,
+        switches::kNodeLoopMaxPasses};
     command_line->CopySwitchesFrom(*base::CommandLine::ForCurrentProcess(),
                                    kCommonSwitchNames,
                                    base::size(kCommonSwitchNames));
@@ -808,12 +953,16 @@ void ElectronBrowserClient::AppendExtraCommandLineSwitches(
 
     content::WebContents* web_contents =
         GetWebContentsFromProcessID(process_id);
+    bool is_spare = base::Contains(spare_processes_, process_id);
     if (web_contents) {
       auto* web_preferences = WebContentsPreferences::From(web_contents);
       if (web_preferences)
         web_preferences->AppendCommandLineSwitches(
-            command_line, IsRendererSubFrame(process_id));
+            command_line, IsRendererSubFrame(process_id), is_spare);
     }
+
+    if (is_spare)
+      command_line->AppendSwitch(switches::kSpareRenderer);
   }
 }
 
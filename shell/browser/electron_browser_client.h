@@ -89,6 +89,12 @@ class ElectronBrowserClient : public content::ContentBrowserClient,
 
   void SetCanUseCustomSiteInstance(bool should_disable);
   bool CanUseCustomSiteInstance() override;
+
+  // Launches the renderer of |site_instance| ahead of its first navigation,
+  // configured with the preferences of |web_contents|. Returns false if the
+  // SiteInstance was given a renderer that is already running.
+  bool LaunchSpareRenderer(content::SiteInstance* site_instance,
+                           content::WebContents* web_contents);
   content::SerialDelegate* GetSerialDelegate() override;
 
   content::BluetoothDelegate* GetBluetoothDelegate() override;
@@ -314,8 +320,20 @@ class ElectronBrowserClient : public content::ContentBrowserClient,
       content::BrowserContext* browser_context,
       const GURL& url,
       content::RenderFrameHost* rfh) const;
+  // Returns a SiteInstance of an existing renderer to host |url| in, when
+  // the session's renderer sharing policy applies to the navigation. Once the
+  // navigation has a speculative frame in that renderer, returns its own
+  // SiteInstance.
+  content::SiteInstance* GetSiteInstanceFromSharingPolicy(
+      content::BrowserContext* browser_context,
+      const GURL& url,
+      content::RenderFrameHost* current_rfh,
+      content::RenderFrameHost* speculative_rfh) const;
   void ConsiderSiteInstanceForAffinity(content::RenderFrameHost* rfh,
                                        content::SiteInstance* site_instance);
+  // Counts a navigation of |rfh| that the sharing policy placed in the
+  // renderer |process_id|.
+  void RecordSharedNavigation(content::RenderFrameHost* rfh, int process_id);
 
   bool IsRendererSubFrame(int process_id) const;
 
@@ -324,6 +342,13 @@ class ElectronBrowserClient : public content::ContentBrowserClient,
 
   std::set<int> renderer_is_subframe_;
 
+  // frame tree node => renderer the sharing policy chose for its navigation,
+  // until the navigation's SiteInstance is registered.
+  mutable std::map<int, int> pending_shared_navigations_;
+
+  // Renderers being launched by LaunchSpareRenderer().
+  std::set<int> spare_processes_;
+
   // list of site per affinity. weak_ptr to prevent instance locking
   std::map<std::string, content::SiteInstance*> site_per_affinities_;
 
@@ -46,6 +46,7 @@
 #include "shell/browser/net/resolve_proxy_helper.h"
 #include "shell/browser/pref_store_delegate.h"
 #include "shell/browser/protocol_registry.h"
+#include "shell/browser/spare_renderer_pool.h"
 #include "shell/browser/special_storage_policy.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
 #include "shell/browser/web_view_manager.h"
@@ -156,6 +157,7 @@ ElectronBrowserContext::ElectronBrowserContext(const std::string& partition,
 
 ElectronBrowserContext::~ElectronBrowserContext() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  spare_renderer_pool_.reset();
   NotifyWillBeDestroyed(this);
   // Notify any keyed services of browser context destruction.
   BrowserContextDependencyManager::GetInstance()->DestroyBrowserContextServices(
@@ -438,6 +440,12 @@ ResolveProxyHelper* ElectronBrowserContext::GetResolveProxyHelper() {
   return resolve_proxy_helper_.get();
 }
 
+SpareRendererPool* ElectronBrowserContext::GetSpareRendererPool() {
+  if (!spare_renderer_pool_)
+    spare_renderer_pool_ = std::make_unique<SpareRendererPool>(this);
+  return spare_renderer_pool_.get();
+}
+
 network::mojom::SSLConfigPtr ElectronBrowserContext::GetSSLConfig() {
   return ssl_config_.Clone();
 }
@@ -44,6 +44,7 @@ class ElectronDownloadManagerDelegate;
 class ElectronPermissionManager;
 class CookieChangeNotifier;
 class ResolveProxyHelper;
+class SpareRendererPool;
 class SpecialStoragePolicy;
 class WebViewManager;
 class ProtocolRegistry;
@@ -88,6 +89,7 @@ class ElectronBrowserContext
   bool CanUseHttpCache() const;
   int GetMaxCacheSize() const;
   ResolveProxyHelper* GetResolveProxyHelper();
+  SpareRendererPool* GetSpareRendererPool();
   predictors::PreconnectManager* GetPreconnectManager();
   scoped_refptr<network::SharedURLLoaderFactory> GetURLLoaderFactory();
 
@@ -168,6 +170,7 @@ class ElectronBrowserContext
   std::unique_ptr<ElectronPermissionManager> permission_manager_;
   std::unique_ptr<MediaDeviceIDSalt> media_device_id_salt_;
   scoped_refptr<ResolveProxyHelper> resolve_proxy_helper_;
+  std::unique_ptr<SpareRendererPool> spare_renderer_pool_;
   scoped_refptr<storage::SpecialStoragePolicy> storage_policy_;
   std::unique_ptr<predictors::PreconnectManager> preconnect_manager_;
   std::unique_ptr<ProtocolRegistry> protocol_registry_;
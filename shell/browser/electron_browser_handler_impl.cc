@@ -38,22 +38,34 @@ void ElectronBrowserHandlerImpl::OnConnectionError() {
   delete this;
 }
 
+void ElectronBrowserHandlerImpl::RegisterChannel(uint32_t channel_id,
+                                                 const std::string& channel) {
+  if (!channels_.Register(channel_id, channel))
+    receiver_.ReportBadMessage("Out of order IPC channel id");
+}
+
 void ElectronBrowserHandlerImpl::Message(bool internal,
-                                         const std::string& channel,
+                                         mojom::IPCChannelPtr ipc_channel,
                                          blink::CloneableMessage arguments) {
+  const std::string* channel = GetChannel(*ipc_channel);
+  if (!channel)
+    return;
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
-    api_web_contents->Message(internal, channel, std::move(arguments),
+    api_web_contents->Message(internal, *channel, std::move(arguments),
                               GetRenderFrameHost());
   }
 }
 void ElectronBrowserHandlerImpl::Invoke(bool internal,
-                                        const std::string& channel,
+                                        mojom::IPCChannelPtr ipc_channel,
                                         blink::CloneableMessage arguments,
                                         InvokeCallback callback) {
+  const std::string* channel = GetChannel(*ipc_channel);
+  if (!channel)
+    return;
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
-    api_web_contents->Invoke(internal, channel, std::move(arguments),
+    api_web_contents->Invoke(internal, *channel, std::move(arguments),
                              std::move(callback), GetRenderFrameHost());
   }
 }
@@ -76,12 +88,15 @@ void ElectronBrowserHandlerImpl::ReceivePostMessage(
 }
 
 void ElectronBrowserHandlerImpl::MessageSync(bool internal,
-                                             const std::string& channel,
+                                             mojom::IPCChannelPtr ipc_channel,
                                              blink::CloneableMessage arguments,
                                              MessageSyncCallback callback) {
+  const std::string* channel = GetChannel(*ipc_channel);
+  if (!channel)
+    return;
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
-    api_web_contents->MessageSync(internal, channel, std::move(arguments),
+    api_web_contents->MessageSync(internal, *channel, std::move(arguments),
                                   std::move(callback), GetRenderFrameHost());
   }
 }
@@ -134,6 +149,15 @@ content::RenderFrameHost* ElectronBrowserHandlerImpl::GetRenderFrameHost() {
   return content::RenderFrameHost::FromID(render_process_id_, render_frame_id_);
 }
 
+const std::string* ElectronBrowserHandlerImpl::GetChannel(
+    const mojom::IPCChannel& ipc_channel) {
+  const std::string* channel = channels_.Resolve(ipc_channel);
+  // Resetting the receiver also releases any pending reply callbacks.
+  if (!channel)
+    receiver_.ReportBadMessage("Unknown IPC channel id");
+  return channel;
+}
+
 // static
 void ElectronBrowserHandlerImpl::Create(
     content::RenderFrameHost* frame_host,
@@ -13,6 +13,7 @@
 #include "content/public/browser/web_contents_observer.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "shell/browser/api/electron_api_web_contents.h"
+#include "shell/common/ipc_channel_table.h"
 
 namespace content {
 class RenderFrameHost;
@@ -30,18 +31,20 @@ class ElectronBrowserHandlerImpl : public mojom::ElectronBrowser,
                      mojo::PendingReceiver<mojom::ElectronBrowser> receiver);
 
   // mojom::ElectronBrowser:
+  void RegisterChannel(uint32_t channel_id,
+                       const std::string& channel) override;
   void Message(bool internal,
-               const std::string& channel,
+               mojom::IPCChannelPtr ipc_channel,
                blink::CloneableMessage arguments) override;
   void Invoke(bool internal,
-              const std::string& channel,
+              mojom::IPCChannelPtr ipc_channel,
               blink::CloneableMessage arguments,
               InvokeCallback callback) override;
   void OnFirstNonEmptyLayout() override;
   void ReceivePostMessage(const std::string& channel,
                           blink::TransferableMessage message) override;
   void MessageSync(bool internal,
-                   const std::string& channel,
+                   mojom::IPCChannelPtr ipc_channel,
                    blink::CloneableMessage arguments,
                    MessageSyncCallback callback) override;
   void MessageTo(bool internal,
@@ -69,11 +72,17 @@ class ElectronBrowserHandlerImpl : public mojom::ElectronBrowser,
 
   content::RenderFrameHost* GetRenderFrameHost();
 
+  // Resolves |channel|, reporting a bad message when it is unknown.
+  const std::string* GetChannel(const mojom::IPCChannel& channel);
+
   const int render_process_id_;
   const int render_frame_id_;
 
   mojo::Receiver<mojom::ElectronBrowser> receiver_{this};
 
+  // Channels registered by the renderer on |receiver_|.
+  IPCChannelTable channels_;
+
   base::WeakPtrFactory<ElectronBrowserHandlerImpl> weak_factory_{this};
 
   DISALLOW_COPY_AND_ASSIGN(ElectronBrowserHandlerImpl);
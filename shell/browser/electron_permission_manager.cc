@@ -8,6 +8,9 @@
 #include <utility>
 #include <vector>
 
+#include "base/json/json_writer.h"
+#include "base/stl_util.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/child_process_security_policy.h"
 #include "content/public/browser/permission_controller.h"
 #include "content/public/browser/permission_type.h"
@@ -109,9 +112,31 @@ void ElectronPermissionManager::SetPermissionRequestHandler(
 
 void ElectronPermissionManager::SetPermissionCheckHandler(
     const CheckHandler& handler) {
+  // Decisions made by the previous handler no longer apply.
+  ClearPermissionDecisions();
   check_handler_ = handler;
 }
 
+void ElectronPermissionManager::ClearPermissionDecisions() {
+  decisions_.clear();
+}
+
+void ElectronPermissionManager::ClearPermissionDecisionsForFrame(
+    int frame_tree_node_id) {
+  base::EraseIf(decisions_, [frame_tree_node_id](const auto& decision) {
+    return std::get<1>(decision.first) == frame_tree_node_id;
+  });
+}
+
+ElectronPermissionManager::DecisionStats
+ElectronPermissionManager::GetPermissionDecisionStats() const {
+  DecisionStats stats;
+  stats.hits = decision_hits_;
+  stats.misses = decision_misses_;
+  stats.entries = decisions_.size();
+  return stats;
+}
+
 int ElectronPermissionManager::RequestPermission(
     content::PermissionType permission,
     content::RenderFrameHost* render_frame_host,
@@ -247,10 +272,39 @@ bool ElectronPermissionManager::CheckPermissionWithDetails(
     content::PermissionType permission,
     content::RenderFrameHost* render_frame_host,
     const GURL& requesting_origin,
-    const base::DictionaryValue* details) const {
+    const base::DictionaryValue* details) {
   if (check_handler_.is_null()) {
     return true;
   }
+
+  // Answers depend on who asks and on the details, e.g. the media type, so
+  // they are only reused for the same frame and the same details.
+  std::string serialized_details;
+  if (details)
+    base::JSONWriter::Write(*details, &serialized_details);
+  DecisionKey key(
+      permission,
+      render_frame_host ? render_frame_host->GetFrameTreeNodeId() : -1,
+      url::Origin::Create(requesting_origin),
+      render_frame_host
+          ? render_frame_host->GetMainFrame()->GetLastCommittedOrigin()
+          : url::Origin(),
+      serialized_details);
+  auto it = decisions_.find(key);
+  if (it != decisions_.end()) {
+    if (it->second.expiry.is_max() ||
+        it->second.expiry > base::TimeTicks::Now()) {
+      ++decision_hits_;
+      TRACE_COUNTER2("electron.permission", "PermissionDecisions", "hits",
+                     decision_hits_, "misses", decision_misses_);
+      return it->second.granted;
+    }
+    decisions_.erase(it);
+  }
+  ++decision_misses_;
+  TRACE_COUNTER2("electron.permission", "PermissionDecisions", "hits",
+                 decision_hits_, "misses", decision_misses_);
+
   auto* web_contents =
       render_frame_host
           ? content::WebContents::FromRenderFrameHost(render_frame_host)
@@ -274,8 +328,15 @@ bool ElectronPermissionManager::CheckPermissionWithDetails(
     default:
       break;
   }
-  return check_handler_.Run(web_contents, permission, requesting_origin,
-                            mutable_details);
+  CheckResult result = check_handler_.Run(web_contents, permission,
+                                          requesting_origin, mutable_details);
+  if (!result.cache_lifetime.is_zero()) {
+    base::TimeTicks expiry = result.cache_lifetime.is_max()
+                                 ? base::TimeTicks::Max()
+                                 : base::TimeTicks::Now() + result.cache_lifetime;
+    decisions_[key] = CachedDecision{result.granted, expiry};
+  }
+  return result.granted;
 }
 
 blink::mojom::PermissionStatus
@@ -7,12 +7,17 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "base/callback.h"
 #include "base/containers/id_map.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/permission_controller_delegate.h"
+#include "url/origin.h"
 
 namespace content {
 class WebContents;
@@ -33,15 +38,38 @@ class ElectronPermissionManager : public content::PermissionControllerDelegate {
                                              content::PermissionType,
                                              StatusCallback,
                                              const base::Value&)>;
-  using CheckHandler = base::Callback<bool(content::WebContents*,
-                                           content::PermissionType,
-                                           const GURL& requesting_origin,
-                                           const base::Value&)>;
+
+  // The answer of a permission check handler. A non-zero |cache_lifetime|
+  // asks for the decision to be remembered for the same check, i.e. the same
+  // permission, frame, requesting and embedding origins and details,
+  // base::TimeDelta::Max() meaning until explicitly cleared.
+  struct CheckResult {
+    bool granted = false;
+    base::TimeDelta cache_lifetime;
+  };
+
+  // Hit/miss counters of the permission decision table.
+  struct DecisionStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    size_t entries = 0;
+  };
+
+  using CheckHandler = base::Callback<CheckResult(content::WebContents*,
+                                                  content::PermissionType,
+                                                  const GURL& requesting_origin,
+                                                  const base::Value&)>;
 
   // Handler to dispatch permission requests in JS.
   void SetPermissionRequestHandler(const RequestHandler& handler);
   void SetPermissionCheckHandler(const CheckHandler& handler);
 
+  // Forgets all the decisions cached from the check handler.
+  void ClearPermissionDecisions();
+  // Forgets the decisions cached for a frame that goes away.
+  void ClearPermissionDecisionsForFrame(int frame_tree_node_id);
+  DecisionStats GetPermissionDecisionStats() const;
+
   // content::PermissionControllerDelegate:
   int RequestPermission(content::PermissionType permission,
                         content::RenderFrameHost* render_frame_host,
@@ -75,7 +103,7 @@ class ElectronPermissionManager : public content::PermissionControllerDelegate {
   bool CheckPermissionWithDetails(content::PermissionType permission,
                                   content::RenderFrameHost* render_frame_host,
                                   const GURL& requesting_origin,
-                                  const base::DictionaryValue* details) const;
+                                  const base::DictionaryValue* details);
 
  protected:
   void OnPermissionResponse(int request_id,
@@ -102,11 +130,30 @@ class ElectronPermissionManager : public content::PermissionControllerDelegate {
   class PendingRequest;
   using PendingRequestsMap = base::IDMap<std::unique_ptr<PendingRequest>>;
 
+  struct CachedDecision {
+    bool granted;
+    base::TimeTicks expiry;
+  };
+  // (permission, frame tree node id, requesting origin, embedding origin,
+  // serialized details). The frame is -1 for checks without one.
+  using DecisionKey = std::tuple<content::PermissionType,
+                                 int,
+                                 url::Origin,
+                                 url::Origin,
+                                 std::string>;
+  using DecisionMap = std::map<DecisionKey, CachedDecision>;
+
   RequestHandler request_handler_;
   CheckHandler check_handler_;
 
   PendingRequestsMap pending_requests_;
 
+  // Decisions returned by |check_handler_| with a cache lifetime, consulted
+  // before calling into JS.
+  DecisionMap decisions_;
+  uint64_t decision_hits_ = 0;
+  uint64_t decision_misses_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(ElectronPermissionManager);
 };
 
@@ -9,6 +9,7 @@
 
 #include "gin/object_template_builder.h"
 #include "shell/browser/javascript_environment.h"
+#include "shell/browser/main_thread_watchdog.h"
 #include "shell/common/gin_helper/event_emitter.h"
 
 namespace gin_helper {
@@ -24,6 +25,7 @@ class EventEmitterMixin {
   // Returns true if event.preventDefault() was called during processing.
   template <typename... Args>
   bool Emit(base::StringPiece name, Args&&... args) {
+    electron::MainThreadWatchdog::ScopedActivity activity("event", name);
     v8::Isolate* isolate = electron::JavascriptEnvironment::GetIsolate();
     v8::Locker locker(isolate);
     v8::HandleScope handle_scope(isolate);
@@ -40,6 +42,7 @@ class EventEmitterMixin {
   bool EmitCustomEvent(base::StringPiece name,
                        v8::Local<v8::Object> custom_event,
                        Args&&... args) {
+    electron::MainThreadWatchdog::ScopedActivity activity("event", name);
     v8::Isolate* isolate = electron::JavascriptEnvironment::GetIsolate();
     v8::HandleScope scope(isolate);
     v8::Local<v8::Object> wrapper;
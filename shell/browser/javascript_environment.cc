@@ -9,8 +9,10 @@
 #include <unordered_set>
 #include <utility>
 
+#include "base/allocator/buildflags.h"
 #include "base/allocator/partition_allocator/partition_alloc.h"
 #include "base/command_line.h"
+#include "base/logging.h"
 #include "base/task/current_thread.h"
 #include "base/task/thread_pool/initialization_util.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -21,6 +23,7 @@
 #include "shell/browser/microtasks_runner.h"
 #include "shell/common/gin_helper/cleaned_up_at_exit.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/options_switches.h"
 #include "tracing/trace_event.h"
 
 namespace {
@@ -71,14 +74,30 @@ class ArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
   enum InitializationPolicy { kZeroInitialize, kDontInitialize };
 
   ArrayBufferAllocator() {
+    auto thread_cache = base::PartitionOptions::ThreadCache::kDisabled;
+    if (base::CommandLine::ForCurrentProcess()->HasSwitch(
+            switches::kEnableArrayBufferThreadCache)) {
+#if BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+      // Only one partition can have a thread cache, and malloc's owns it.
+      LOG(WARNING) << "The ArrayBuffer thread cache is not available when "
+                      "PartitionAlloc is used as malloc";
+#else
+      thread_cache = base::PartitionOptions::ThreadCache::kEnabled;
+#endif
+    }
+
     // Ref.
     // https://source.chromium.org/chromium/chromium/src/+/master:third_party/blink/renderer/platform/wtf/allocator/partitions.cc;l=94;drc=062c315a858a87f834e16a144c2c8e9591af2beb
-    allocator_->init({base::PartitionOptions::Alignment::kRegular,
-                      base::PartitionOptions::ThreadCache::kDisabled,
+    allocator_->init({base::PartitionOptions::Alignment::kRegular, thread_cache,
                       base::PartitionOptions::Quarantine::kAllowed,
                       base::PartitionOptions::RefCount::kDisabled});
   }
 
+  static void DumpStats(base::PartitionStatsDumper* dumper) {
+    allocator_->root()->DumpStats("array_buffer", false /* is_light_dump */,
+                                  dumper);
+  }
+
   // Allocate() methods return null to signal allocation failure to V8, which
   // should respond by throwing a RangeError, per
   // http://www.ecma-international.org/ecma-262/6.0/#sec-createbytedatablock.
@@ -344,6 +363,12 @@ v8::Isolate* JavascriptEnvironment::Initialize(uv_loop_t* event_loop) {
   return isolate;
 }
 
+// static
+void JavascriptEnvironment::DumpArrayBufferAllocatorStats(
+    base::PartitionStatsDumper* dumper) {
+  ArrayBufferAllocator::DumpStats(dumper);
+}
+
 // static
 v8::Isolate* JavascriptEnvironment::GetIsolate() {
   CHECK(g_isolate);
@@ -11,6 +11,10 @@
 #include "gin/public/isolate_holder.h"
 #include "uv.h"  // NOLINT(build/include_directory)
 
+namespace base {
+class PartitionStatsDumper;
+}
+
 namespace node {
 class Environment;
 class MultiIsolatePlatform;
@@ -36,6 +40,10 @@ class JavascriptEnvironment {
 
   static v8::Isolate* GetIsolate();
 
+  // Reports the PartitionAlloc statistics of the main process' ArrayBuffer
+  // allocator, including the per-bucket ones.
+  static void DumpArrayBufferAllocatorStats(base::PartitionStatsDumper* dumper);
+
  private:
   v8::Isolate* Initialize(uv_loop_t* event_loop);
   // Leaked on exit.
@@ -0,0 +1,209 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/main_thread_watchdog.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/memory/ref_counted.h"
+#include "base/sequenced_task_runner.h"
+#include "base/single_thread_task_runner.h"
+#include "base/strings/strcat.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron {
+
+namespace {
+
+// Only read and written on the main thread.
+MainThreadWatchdog::ScopedActivity* g_current_activity = nullptr;
+
+constexpr int kMaxStackFrames = 16;
+constexpr base::TimeDelta kMinCheckInterval =
+    base::TimeDelta::FromMilliseconds(10);
+
+std::string CaptureJavaScriptStack(v8::Isolate* isolate) {
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::StackTrace> trace =
+      v8::StackTrace::CurrentStackTrace(isolate, kMaxStackFrames);
+  std::string stack;
+  for (int i = 0; i < trace->GetFrameCount(); ++i) {
+    v8::Local<v8::StackFrame> frame = trace->GetFrame(isolate, i);
+    v8::String::Utf8Value function(isolate, frame->GetFunctionName());
+    v8::String::Utf8Value script(isolate, frame->GetScriptName());
+    base::StringAppendF(&stack, "    at %s (%s:%d:%d)\n",
+                        function.length() ? *function : "<anonymous>",
+                        script.length() ? *script : "<unknown>",
+                        frame->GetLineNumber(), frame->GetColumn());
+  }
+  return stack;
+}
+
+}  // namespace
+
+class MainThreadWatchdog::Monitor
+    : public base::RefCountedThreadSafe<MainThreadWatchdog::Monitor> {
+ public:
+  Monitor(v8::Isolate* isolate,
+          base::TimeDelta threshold,
+          StallCallback callback)
+      : isolate_(isolate),
+        threshold_(threshold),
+        interval_(std::max(threshold / 4, kMinCheckInterval)),
+        callback_(std::move(callback)),
+        main_task_runner_(base::ThreadTaskRunnerHandle::Get()),
+        watchdog_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+            {base::TaskPriority::USER_BLOCKING,
+             base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN})) {}
+
+  void Start() {
+    watchdog_task_runner_->PostDelayedTask(
+        FROM_HERE, base::BindOnce(&Monitor::Check, this), interval_);
+  }
+
+  // Check() only interrupts the isolate while holding |lock_| and after
+  // testing |stopped_|, so no new interrupt is requested once this returns.
+  void Stop() {
+    base::AutoLock auto_lock(lock_);
+    stopped_ = true;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Monitor>;
+  ~Monitor() = default;
+
+  // Runs on the watchdog sequence.
+  void Check() {
+    base::TimeTicks now = base::TimeTicks::Now();
+    {
+      base::AutoLock auto_lock(lock_);
+      if (stopped_)
+        return;
+      if (!heartbeat_pending_) {
+        heartbeat_pending_ = true;
+        interrupt_requested_ = false;
+        heartbeat_sent_ = now;
+        main_task_runner_->PostTask(
+            FROM_HERE, base::BindOnce(&Monitor::Heartbeat, this, now));
+      } else if (!interrupt_requested_ && now - heartbeat_sent_ >= threshold_) {
+        // The interrupt only runs if the main thread is executing JavaScript,
+        // which is what we want to attribute the stall to.
+        interrupt_requested_ = true;
+        isolate_->RequestInterrupt(&Monitor::OnInterrupt,
+                                   new scoped_refptr<Monitor>(this));
+      }
+    }
+    watchdog_task_runner_->PostDelayedTask(
+        FROM_HERE, base::BindOnce(&Monitor::Check, this), interval_);
+  }
+
+  // Runs on the main thread.
+  void Heartbeat(base::TimeTicks sent) {
+    Stall stall;
+    {
+      base::AutoLock auto_lock(lock_);
+      heartbeat_pending_ = false;
+      if (stopped_)
+        return;
+      stall.duration = base::TimeTicks::Now() - sent;
+      if (stall.duration < threshold_)
+        return;
+      stall.stack = std::move(stack_);
+      stall.activity = std::move(activity_);
+      stack_.clear();
+      activity_.clear();
+    }
+
+    TRACE_EVENT_INSTANT2("electron.watchdog", "MainThreadWatchdog::Stall",
+                         TRACE_EVENT_SCOPE_THREAD, "duration_ms",
+                         stall.duration.InMilliseconds(), "activity",
+                         stall.activity);
+    callback_.Run(stall);
+  }
+
+  // Runs on the main thread while it is executing JavaScript.
+  static void OnInterrupt(v8::Isolate* isolate, void* data) {
+    std::unique_ptr<scoped_refptr<Monitor>> monitor(
+        static_cast<scoped_refptr<Monitor>*>(data));
+    (*monitor)->CaptureStall(isolate);
+  }
+
+  void CaptureStall(v8::Isolate* isolate) {
+    {
+      base::AutoLock auto_lock(lock_);
+      if (stopped_)
+        return;
+    }
+    std::string stack = CaptureJavaScriptStack(isolate);
+    std::string activity =
+        g_current_activity ? g_current_activity->ToString() : std::string();
+
+    base::AutoLock auto_lock(lock_);
+    // Ignore interrupts that were delivered after the stall was reported.
+    if (!heartbeat_pending_ || !interrupt_requested_)
+      return;
+    stack_ = std::move(stack);
+    activity_ = std::move(activity);
+  }
+
+  v8::Isolate* isolate_;
+  const base::TimeDelta threshold_;
+  const base::TimeDelta interval_;
+  StallCallback callback_;
+  scoped_refptr<base::SingleThreadTaskRunner> main_task_runner_;
+  scoped_refptr<base::SequencedTaskRunner> watchdog_task_runner_;
+
+  base::Lock lock_;
+  bool stopped_ = false;
+  bool heartbeat_pending_ = false;
+  bool interrupt_requested_ = false;
+  base::TimeTicks heartbeat_sent_;
+  std::string stack_;
+  std::string activity_;
+
+  DISALLOW_COPY_AND_ASSIGN(Monitor);
+};
+
+MainThreadWatchdog::ScopedActivity::ScopedActivity(base::StringPiece kind,
+                                                   base::StringPiece name)
+    : kind_(kind), name_(name), previous_(g_current_activity) {
+  g_current_activity = this;
+}
+
+MainThreadWatchdog::ScopedActivity::~ScopedActivity() {
+  g_current_activity = previous_;
+}
+
+std::string MainThreadWatchdog::ScopedActivity::ToString() const {
+  // Outermost first, e.g. "ipc my-channel > event -ipc-message".
+  std::string result = base::StrCat({kind_, " ", name_});
+  for (const ScopedActivity* outer = previous_; outer;
+       outer = outer->previous_) {
+    result = base::StrCat({outer->kind_, " ", outer->name_, " > ", result});
+  }
+  return result;
+}
+
+MainThreadWatchdog::MainThreadWatchdog(v8::Isolate* isolate,
+                                       base::TimeDelta threshold,
+                                       StallCallback callback)
+    : threshold_(threshold),
+      monitor_(base::MakeRefCounted<Monitor>(isolate,
+                                             threshold,
+                                             std::move(callback))) {
+  monitor_->Start();
+}
+
+MainThreadWatchdog::~MainThreadWatchdog() {
+  monitor_->Stop();
+}
+
+}  // namespace electron
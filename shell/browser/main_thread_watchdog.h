@@ -0,0 +1,74 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_MAIN_THREAD_WATCHDOG_H_
+#define SHELL_BROWSER_MAIN_THREAD_WATCHDOG_H_
+
+#include <string>
+
+#include "base/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/strings/string_piece.h"
+#include "base/time/time.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+// Watches the responsiveness of the browser main thread from a ThreadPool
+// sequence. The sequence periodically posts a heartbeat task to the main
+// thread; when the heartbeat has not run within the threshold it interrupts
+// the isolate to capture the JavaScript stack and the activity (IPC channel
+// or event name) the main thread is busy with. Once the main thread catches
+// up the stall is reported on the main thread.
+class MainThreadWatchdog {
+ public:
+  struct Stall {
+    base::TimeDelta duration;
+    // Both are empty when the main thread was not running JavaScript during
+    // the stall.
+    std::string stack;
+    std::string activity;
+  };
+
+  using StallCallback = base::RepeatingCallback<void(const Stall&)>;
+
+  // Labels what the main thread is currently doing, nested scopes are
+  // reported together with their enclosing ones. Only touched on the main
+  // thread, so it is cheap enough to wrap every IPC message and emitted event.
+  class ScopedActivity {
+   public:
+    ScopedActivity(base::StringPiece kind, base::StringPiece name);
+    ~ScopedActivity();
+
+    std::string ToString() const;
+
+   private:
+    base::StringPiece kind_;
+    base::StringPiece name_;
+    ScopedActivity* previous_;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedActivity);
+  };
+
+  MainThreadWatchdog(v8::Isolate* isolate,
+                     base::TimeDelta threshold,
+                     StallCallback callback);
+  // Stops monitoring. Once this returns the watchdog no longer interrupts the
+  // isolate or reports stalls, so the isolate can be torn down.
+  ~MainThreadWatchdog();
+
+  base::TimeDelta threshold() const { return threshold_; }
+
+ private:
+  class Monitor;
+
+  base::TimeDelta threshold_;
+  scoped_refptr<Monitor> monitor_;
+
+  DISALLOW_COPY_AND_ASSIGN(MainThreadWatchdog);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_MAIN_THREAD_WATCHDOG_H_
@@ -10,6 +10,7 @@
 
 #include "base/guid.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
@@ -199,6 +200,8 @@ void ElectronURLLoaderFactory::CreateLoaderAndStart(
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     const net::MutableNetworkTrafficAnnotationTag& traffic_annotation) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  TRACE_EVENT1("electron.protocol", "ElectronURLLoaderFactory::RunHandler",
+               "url", request.url.spec());
   mojo::PendingRemote<network::mojom::URLLoaderFactory> proxy_factory;
   handler_.Run(request, base::BindOnce(&ElectronURLLoaderFactory::StartLoading,
                                        std::move(loader), routing_id,
@@ -231,6 +234,8 @@ void ElectronURLLoaderFactory::StartLoading(
     mojo::PendingRemote<network::mojom::URLLoaderFactory> proxy_factory,
     ProtocolType type,
     gin::Arguments* args) {
+  TRACE_EVENT2("electron.protocol", "ElectronURLLoaderFactory::StartLoading",
+               "url", request.url.spec(), "type", static_cast<int>(type));
   // Send network error when there is no argument passed.
   //
   // Note that we should not throw JS error in the callback no matter what is
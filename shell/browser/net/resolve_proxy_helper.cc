@@ -4,84 +4,239 @@
 
 #include "shell/browser/net/resolve_proxy_helper.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/bind.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver.h"
 #include "net/proxy_resolution/proxy_info.h"
 #include "services/network/public/mojom/network_context.mojom.h"
+#include "services/network/public/mojom/proxy_lookup_client.mojom.h"
 #include "shell/browser/electron_browser_context.h"
+#include "url/scheme_host_port.h"
 
 using content::BrowserThread;
 
 namespace electron {
 
+// A single LookUpProxyForURL call to the network service, answering every
+// request that was made for the same key while it was in progress.
+class ResolveProxyHelper::ProxyLookup
+    : public network::mojom::ProxyLookupClient {
+ public:
+  ProxyLookup(ResolveProxyHelper* helper, std::string key, uint64_t generation)
+      : helper_(helper),
+        key_(std::move(key)),
+        generation_(generation),
+        start_time_(base::TimeTicks::Now()) {}
+  ~ProxyLookup() override = default;
+
+  void Start(network::mojom::NetworkContext* network_context, const GURL& url) {
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN1("electron.proxy",
+                                      "ResolveProxyHelper::Lookup",
+                                      TRACE_ID_LOCAL(this), "key", key_);
+    mojo::PendingRemote<network::mojom::ProxyLookupClient> proxy_lookup_client =
+        receiver_.BindNewPipeAndPassRemote();
+    receiver_.set_disconnect_handler(
+        base::BindOnce(&ProxyLookup::OnProxyLookupComplete,
+                       base::Unretained(this), net::ERR_ABORTED, base::nullopt));
+    network_context->LookUpProxyForURL(url, net::NetworkIsolationKey::Todo(),
+                                       std::move(proxy_lookup_client));
+  }
+
+  void AddCallback(ResolveProxyCallback callback) {
+    callbacks_.push_back(std::move(callback));
+  }
+
+  const std::string& key() const { return key_; }
+  uint64_t generation() const { return generation_; }
+  base::TimeTicks start_time() const { return start_time_; }
+
+  std::vector<ResolveProxyCallback> TakeCallbacks() {
+    return std::move(callbacks_);
+  }
+
+ private:
+  // network::mojom::ProxyLookupClient implementation.
+  void OnProxyLookupComplete(
+      int32_t net_error,
+      const base::Optional<net::ProxyInfo>& proxy_info) override {
+    TRACE_EVENT_NESTABLE_ASYNC_END1("electron.proxy",
+                                    "ResolveProxyHelper::Lookup",
+                                    TRACE_ID_LOCAL(this), "net_error",
+                                    net_error);
+    receiver_.reset();
+    base::Optional<std::string> proxy;
+    if (proxy_info)
+      proxy = proxy_info->ToPacString();
+    // Deletes |this|.
+    helper_->OnProxyLookupComplete(this, net_error, proxy);
+  }
+
+  ResolveProxyHelper* helper_;
+  std::string key_;
+  uint64_t generation_;
+  base::TimeTicks start_time_;
+  std::vector<ResolveProxyCallback> callbacks_;
+  mojo::Receiver<network::mojom::ProxyLookupClient> receiver_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(ProxyLookup);
+};
+
 ResolveProxyHelper::ResolveProxyHelper(ElectronBrowserContext* browser_context)
     : browser_context_(browser_context) {}
 
 ResolveProxyHelper::~ResolveProxyHelper() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  DCHECK(!owned_self_);
-  DCHECK(!receiver_.is_bound());
   // Clear all pending requests if the ProxyService is still alive.
   pending_requests_.clear();
+  lookups_.clear();
+  stale_lookups_.clear();
 }
 
 void ResolveProxyHelper::ResolveProxy(const GURL& url,
                                       ResolveProxyCallback callback) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  std::string key = GetCacheKey(url);
+
+  std::string proxy;
+  if (GetCachedResult(key, &proxy)) {
+    stats_.cache_hits++;
+    std::move(callback).Run(proxy);
+    return;
+  }
+
+  // Join a lookup that is already in progress for the same key.
+  auto it = lookups_.find(key);
+  if (it != lookups_.end()) {
+    it->second->AddCallback(std::move(callback));
+    return;
+  }
+
   // Enqueue the pending request.
   pending_requests_.emplace_back(url, std::move(callback));
+  StartPendingRequests();
+}
 
-  // If nothing is in progress, start.
-  if (!receiver_.is_bound()) {
-    DCHECK_EQ(1u, pending_requests_.size());
-    StartPendingRequest();
-  }
+void ResolveProxyHelper::SetOptions(const Options& options) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  options_ = options;
+  options_.max_concurrent_lookups =
+      std::max<size_t>(1, options_.max_concurrent_lookups);
+  ClearCache();
+  StartPendingRequests();
 }
 
-void ResolveProxyHelper::StartPendingRequest() {
+void ResolveProxyHelper::ClearCache() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  DCHECK(!receiver_.is_bound());
-  DCHECK(!pending_requests_.empty());
-
-  // Start the request.
-  mojo::PendingRemote<network::mojom::ProxyLookupClient> proxy_lookup_client =
-      receiver_.BindNewPipeAndPassRemote();
-  receiver_.set_disconnect_handler(
-      base::BindOnce(&ResolveProxyHelper::OnProxyLookupComplete,
-                     base::Unretained(this), net::ERR_ABORTED, base::nullopt));
-  content::BrowserContext::GetDefaultStoragePartition(browser_context_)
-      ->GetNetworkContext()
-      ->LookUpProxyForURL(pending_requests_.front().url,
-                          net::NetworkIsolationKey::Todo(),
-                          std::move(proxy_lookup_client));
+  cache_.clear();
+  // Results of lookups that started with the previous configuration must not
+  // end up in the cache, or be shared with new requests.
+  generation_++;
+  for (auto& lookup : lookups_)
+    stale_lookups_.push_back(std::move(lookup.second));
+  lookups_.clear();
+}
+
+void ResolveProxyHelper::StartPendingRequests() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  while (!pending_requests_.empty() &&
+         lookups_.size() + stale_lookups_.size() <
+             options_.max_concurrent_lookups) {
+    PendingRequest request = std::move(pending_requests_.front());
+    pending_requests_.pop_front();
+
+    std::string key = GetCacheKey(request.url);
+    std::string proxy;
+    if (GetCachedResult(key, &proxy)) {
+      stats_.cache_hits++;
+      std::move(request.callback).Run(proxy);
+      continue;
+    }
+
+    auto it = lookups_.find(key);
+    if (it != lookups_.end()) {
+      it->second->AddCallback(std::move(request.callback));
+      continue;
+    }
+
+    auto lookup = std::make_unique<ProxyLookup>(this, key, generation_);
+    auto* lookup_ptr = lookup.get();
+    lookup->AddCallback(std::move(request.callback));
+    lookups_[key] = std::move(lookup);
+    lookup_ptr->Start(
+        content::BrowserContext::GetDefaultStoragePartition(browser_context_)
+            ->GetNetworkContext(),
+        request.url);
+  }
+  stats_.pending = pending_requests_.size();
+  stats_.in_flight = lookups_.size() + stale_lookups_.size();
 }
 
 void ResolveProxyHelper::OnProxyLookupComplete(
+    ProxyLookup* lookup,
     int32_t net_error,
-    const base::Optional<net::ProxyInfo>& proxy_info) {
+    const base::Optional<std::string>& proxy) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  DCHECK(!pending_requests_.empty());
+  std::unique_ptr<ProxyLookup> completed_lookup;
+  bool stale = lookup->generation() != generation_;
+  if (!stale) {
+    auto it = lookups_.find(lookup->key());
+    DCHECK(it != lookups_.end());
+    completed_lookup = std::move(it->second);
+    lookups_.erase(it);
+  } else {
+    auto stale_it = std::find_if(
+        stale_lookups_.begin(), stale_lookups_.end(),
+        [lookup](const auto& stale_lookup) {
+          return stale_lookup.get() == lookup;
+        });
+    DCHECK(stale_it != stale_lookups_.end());
+    completed_lookup = std::move(*stale_it);
+    stale_lookups_.erase(stale_it);
+  }
 
-  receiver_.reset();
+  base::TimeDelta latency = base::TimeTicks::Now() - lookup->start_time();
+  stats_.lookups++;
+  stats_.total_latency += latency;
+  stats_.max_latency = std::max(stats_.max_latency, latency);
 
-  // Clear the current (completed) request.
-  PendingRequest completed_request = std::move(pending_requests_.front());
-  pending_requests_.pop_front();
+  std::string result = proxy.value_or(std::string());
+  if (proxy && !stale && !options_.cache_ttl.is_zero()) {
+    cache_[lookup->key()] =
+        CachedResult{result, base::TimeTicks::Now() + options_.cache_ttl};
+  }
 
-  std::string proxy;
-  if (proxy_info)
-    proxy = proxy_info->ToPacString();
+  // Start the next requests before running the callbacks, they may re-enter.
+  StartPendingRequests();
 
-  if (!completed_request.callback.is_null())
-    std::move(completed_request.callback).Run(proxy);
+  for (auto& callback : completed_lookup->TakeCallbacks()) {
+    if (!callback.is_null())
+      std::move(callback).Run(result);
+  }
+}
+
+bool ResolveProxyHelper::GetCachedResult(const std::string& key,
+                                         std::string* proxy) {
+  auto it = cache_.find(key);
+  if (it == cache_.end())
+    return false;
+  if (it->second.expiry <= base::TimeTicks::Now()) {
+    cache_.erase(it);
+    return false;
+  }
+  *proxy = it->second.proxy;
+  return true;
+}
 
-  // Start the next request.
-  if (!pending_requests_.empty())
-    StartPendingRequest();
+std::string ResolveProxyHelper::GetCacheKey(const GURL& url) const {
+  if (options_.cache_ttl.is_zero())
+    return url.spec();
+  return url::SchemeHostPort(url).Serialize();
 }
 
 ResolveProxyHelper::PendingRequest::PendingRequest(
@@ -6,12 +6,14 @@
 #define SHELL_BROWSER_NET_RESOLVE_PROXY_HELPER_H_
 
 #include <deque>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "base/memory/ref_counted.h"
 #include "base/optional.h"
-#include "mojo/public/cpp/bindings/receiver.h"
-#include "services/network/public/mojom/proxy_lookup_client.mojom.h"
+#include "base/time/time.h"
 #include "url/gurl.h"
 
 namespace electron {
@@ -19,21 +21,51 @@ namespace electron {
 class ElectronBrowserContext;
 
 class ResolveProxyHelper
-    : public base::RefCountedThreadSafe<ResolveProxyHelper>,
-      network::mojom::ProxyLookupClient {
+    : public base::RefCountedThreadSafe<ResolveProxyHelper> {
  public:
   using ResolveProxyCallback = base::OnceCallback<void(std::string)>;
 
+  struct Options {
+    // Maximum number of lookups in flight in the network service.
+    size_t max_concurrent_lookups = 8;
+    // How long a result is reused for the same scheme, host and port, zero
+    // disables the cache.
+    base::TimeDelta cache_ttl;
+  };
+
+  struct Stats {
+    uint64_t lookups = 0;
+    uint64_t cache_hits = 0;
+    size_t pending = 0;
+    size_t in_flight = 0;
+    base::TimeDelta total_latency;
+    base::TimeDelta max_latency;
+  };
+
   explicit ResolveProxyHelper(ElectronBrowserContext* browser_context);
 
   void ResolveProxy(const GURL& url, ResolveProxyCallback callback);
 
+  void SetOptions(const Options& options);
+  const Options& options() const { return options_; }
+
+  // Drops all the cached results, must be called whenever the proxy
+  // configuration of the context changes. Lookups already in progress still
+  // answer their requests, but neither cache their result nor answer later
+  // requests.
+  void ClearCache();
+
+  const Stats& stats() const { return stats_; }
+
  protected:
-  ~ResolveProxyHelper() override;
+  ~ResolveProxyHelper();
 
  private:
   friend class base::RefCountedThreadSafe<ResolveProxyHelper>;
-  // A PendingRequest is a resolve request that is in progress, or queued.
+  class ProxyLookup;
+
+  // A PendingRequest is a resolve request that is waiting for a free lookup
+  // slot.
   struct PendingRequest {
    public:
     PendingRequest(const GURL& url, ResolveProxyCallback callback);
@@ -49,20 +81,36 @@ class ResolveProxyHelper
     DISALLOW_COPY_AND_ASSIGN(PendingRequest);
   };
 
-  // Starts the first pending request.
-  void StartPendingRequest();
+  struct CachedResult {
+    std::string proxy;
+    base::TimeTicks expiry;
+  };
+
+  // Starts as many pending requests as the concurrency limit allows.
+  void StartPendingRequests();
+
+  // Called by a ProxyLookup once the network service answered.
+  void OnProxyLookupComplete(ProxyLookup* lookup,
+                             int32_t net_error,
+                             const base::Optional<std::string>& proxy);
 
-  // network::mojom::ProxyLookupClient implementation.
-  void OnProxyLookupComplete(
-      int32_t net_error,
-      const base::Optional<net::ProxyInfo>& proxy_info) override;
+  bool GetCachedResult(const std::string& key, std::string* proxy);
 
-  // Self-reference. Owned as long as there's an outstanding proxy lookup.
-  scoped_refptr<ResolveProxyHelper> owned_self_;
+  // Results are shared per scheme, host and port when the cache is enabled,
+  // and per URL otherwise.
+  std::string GetCacheKey(const GURL& url) const;
 
   std::deque<PendingRequest> pending_requests_;
-  // Receiver for the currently in-progress request, if any.
-  mojo::Receiver<network::mojom::ProxyLookupClient> receiver_{this};
+  // Lookups currently in progress, keyed by cache key so that concurrent
+  // requests for the same host share one lookup.
+  std::map<std::string, std::unique_ptr<ProxyLookup>> lookups_;
+  // Lookups started before the last ClearCache(), from an older generation.
+  std::vector<std::unique_ptr<ProxyLookup>> stale_lookups_;
+  uint64_t generation_ = 0;
+  std::map<std::string, CachedResult> cache_;
+
+  Options options_;
+  Stats stats_;
 
   // Weak Ref
   ElectronBrowserContext* browser_context_;
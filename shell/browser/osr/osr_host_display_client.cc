@@ -79,8 +79,11 @@ void LayeredWindowUpdater::Draw(const gfx::Rect& damage_rect,
 
 OffScreenHostDisplayClient::OffScreenHostDisplayClient(
     gfx::AcceleratedWidget widget,
-    OnPaintCallback callback)
-    : viz::HostDisplayClient(widget), callback_(callback) {}
+    OnPaintCallback callback,
+    OnNeedsBeginFramesCallback needs_begin_frames_callback)
+    : viz::HostDisplayClient(widget),
+      callback_(callback),
+      needs_begin_frames_callback_(std::move(needs_begin_frames_callback)) {}
 OffScreenHostDisplayClient::~OffScreenHostDisplayClient() = default;
 
 void OffScreenHostDisplayClient::SetActive(bool active) {
@@ -97,6 +100,12 @@ void OffScreenHostDisplayClient::CreateLayeredWindowUpdater(
   layered_window_updater_->SetActive(active_);
 }
 
+void OffScreenHostDisplayClient::OnNeedsExternalBeginFrames(
+    bool needs_begin_frames) {
+  if (needs_begin_frames_callback_)
+    needs_begin_frames_callback_.Run(needs_begin_frames);
+}
+
 #if defined(OS_LINUX) && !defined(OS_CHROMEOS)
 void OffScreenHostDisplayClient::DidCompleteSwapWithNewSize(
     const gfx::Size& size) {}
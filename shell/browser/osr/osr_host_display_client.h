@@ -18,6 +18,7 @@
 namespace electron {
 
 typedef base::Callback<void(const gfx::Rect&, const SkBitmap&)> OnPaintCallback;
+typedef base::RepeatingCallback<void(bool)> OnNeedsBeginFramesCallback;
 
 class LayeredWindowUpdater : public viz::mojom::LayeredWindowUpdater {
  public:
@@ -48,8 +49,10 @@ class LayeredWindowUpdater : public viz::mojom::LayeredWindowUpdater {
 
 class OffScreenHostDisplayClient : public viz::HostDisplayClient {
  public:
-  explicit OffScreenHostDisplayClient(gfx::AcceleratedWidget widget,
-                                      OnPaintCallback callback);
+  OffScreenHostDisplayClient(
+      gfx::AcceleratedWidget widget,
+      OnPaintCallback callback,
+      OnNeedsBeginFramesCallback needs_begin_frames_callback);
   ~OffScreenHostDisplayClient() override;
 
   void SetActive(bool active);
@@ -64,12 +67,15 @@ class OffScreenHostDisplayClient : public viz::HostDisplayClient {
       mojo::PendingReceiver<viz::mojom::LayeredWindowUpdater> receiver)
       override;
 
+  void OnNeedsExternalBeginFrames(bool needs_begin_frames) override;
+
 #if defined(OS_LINUX) && !defined(OS_CHROMEOS)
   void DidCompleteSwapWithNewSize(const gfx::Size& size) override;
 #endif
 
   std::unique_ptr<LayeredWindowUpdater> layered_window_updater_;
   OnPaintCallback callback_;
+  OnNeedsBeginFramesCallback needs_begin_frames_callback_;
   bool active_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(OffScreenHostDisplayClient);
@@ -5,6 +5,7 @@
 #include "shell/browser/osr/osr_render_widget_host_view.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -15,6 +16,7 @@
 #include "base/optional.h"
 #include "base/single_thread_task_runner.h"
 #include "base/task/post_task.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
 #include "components/viz/common/features.h"
 #include "components/viz/common/frame_sinks/begin_frame_args.h"
@@ -46,6 +48,7 @@
 #include "ui/gfx/image/image_skia.h"
 #include "ui/gfx/native_widget_types.h"
 #include "ui/gfx/skbitmap_operations.h"
+#include "ui/gfx/skia_util.h"
 #include "ui/latency/latency_info.h"
 
 namespace electron {
@@ -54,6 +57,15 @@ namespace {
 
 const float kDefaultScaleFactor = 1.0;
 
+// In dirty-rects mode, damage that fragments into more than kMaxPaintRects
+// rectangles is merged per kPaintTileSize tile.
+const int kPaintTileSize = 128;
+const size_t kMaxPaintRects = 8;
+
+// BeginFrames issued after showing, resizing or navigating in on-demand mode,
+// enough for the new surface to make it through to the display.
+const int kOnDemandBeginFrames = 4;
+
 ui::MouseEvent UiMouseEventFromWebMouseEvent(blink::WebMouseEvent event) {
   ui::EventType type = ui::EventType::ET_UNKNOWN;
   switch (event.GetType()) {
@@ -171,6 +183,7 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
     bool transparent,
     bool painting,
     int frame_rate,
+    bool on_demand_frames,
     const OnPaintCallback& callback,
     content::RenderWidgetHost* host,
     OffScreenRenderWidgetHostView* parent_host_view,
@@ -181,6 +194,7 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
       transparent_(transparent),
       callback_(callback),
       frame_rate_(frame_rate),
+      on_demand_frames_(on_demand_frames),
       size_(initial_size),
       painting_(painting),
       cursor_manager_(new content::CursorManager(this)),
@@ -213,7 +227,7 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
   compositor_ = std::make_unique<ui::Compositor>(
       context_factory->AllocateFrameSinkId(), context_factory,
       base::ThreadTaskRunnerHandle::Get(), false /* enable_pixel_canvas */,
-      false /* use_external_begin_frame_control */);
+      on_demand_frames_ /* use_external_begin_frame_control */);
   compositor_->SetAcceleratedWidget(gfx::kNullAcceleratedWidget);
   compositor_->SetDelegate(this);
   compositor_->SetRootLayer(root_layer_.get());
@@ -301,6 +315,8 @@ void OffScreenRenderWidgetHostView::Show() {
 
   if (render_widget_host_)
     render_widget_host_->WasShown({});
+
+  RequestBeginFrames();
 }
 
 void OffScreenRenderWidgetHostView::Hide() {
@@ -535,7 +551,7 @@ OffScreenRenderWidgetHostView::CreateViewForWidget(
   }
 
   return new OffScreenRenderWidgetHostView(
-      transparent_, true, embedder_host_view->GetFrameRate(), callback_,
+      transparent_, true, embedder_host_view->GetFrameRate(), false, callback_,
       render_widget_host, embedder_host_view, size());
 }
 
@@ -547,6 +563,7 @@ void OffScreenRenderWidgetHostView::DidNavigate() {
   ResizeRootLayer(true);
   if (delegated_frame_host_)
     delegated_frame_host_->DidNavigate();
+  RequestBeginFrames();
 }
 
 bool OffScreenRenderWidgetHostView::TransformPointToCoordSpaceForView(
@@ -621,6 +638,8 @@ OffScreenRenderWidgetHostView::CreateHostDisplayClient(
   host_display_client_ = new OffScreenHostDisplayClient(
       gfx::kNullAcceleratedWidget,
       base::BindRepeating(&OffScreenRenderWidgetHostView::OnPaint,
+                          weak_ptr_factory_.GetWeakPtr()),
+      base::BindRepeating(&OffScreenRenderWidgetHostView::OnNeedsBeginFrames,
                           weak_ptr_factory_.GetWeakPtr()));
   host_display_client_->SetActive(IsPainting());
   return base::WrapUnique(host_display_client_);
@@ -652,9 +671,10 @@ bool OffScreenRenderWidgetHostView::UpdateNSViewAndDisplay() {
 
 void OffScreenRenderWidgetHostView::OnPaint(const gfx::Rect& damage_rect,
                                             const SkBitmap& bitmap) {
-  backing_ = std::make_unique<SkBitmap>();
-  backing_->allocN32Pixels(bitmap.width(), bitmap.height(), !transparent_);
-  bitmap.readPixels(backing_->pixmap());
+  CopyToBacking(damage_rect, bitmap);
+
+  // A paint satisfies an explicit frame request.
+  frame_requested_ = false;
 
   if (IsPopupWidget() && parent_callback_) {
     parent_callback_.Run(this->popup_position_);
@@ -663,6 +683,29 @@ void OffScreenRenderWidgetHostView::OnPaint(const gfx::Rect& damage_rect,
   }
 }
 
+void OffScreenRenderWidgetHostView::CopyToBacking(const gfx::Rect& damage_rect,
+                                                  const SkBitmap& bitmap) {
+  // Full frames are handed out without copying the backing, so every frame
+  // needs a fresh one.
+  if (!dirty_rects_only_ || backing_->width() != bitmap.width() ||
+      backing_->height() != bitmap.height()) {
+    backing_ = std::make_unique<SkBitmap>();
+    backing_->allocN32Pixels(bitmap.width(), bitmap.height(), !transparent_);
+    bitmap.readPixels(backing_->pixmap());
+    return;
+  }
+
+  // Dirty rects are copied out of the backing before being delivered, so it
+  // can be updated in place.
+  gfx::Rect rect = gfx::IntersectRects(
+      damage_rect, gfx::Rect(bitmap.width(), bitmap.height()));
+  SkPixmap damaged_pixels;
+  if (!rect.IsEmpty() && backing_->pixmap().extractSubset(
+                             &damaged_pixels, gfx::RectToSkIRect(rect))) {
+    bitmap.readPixels(damaged_pixels, rect.x(), rect.y());
+  }
+}
+
 gfx::Size OffScreenRenderWidgetHostView::SizeInPixels() {
   if (IsPopupWidget()) {
     return gfx::ToFlooredSize(gfx::ConvertSizeToPixels(
@@ -675,6 +718,11 @@ gfx::Size OffScreenRenderWidgetHostView::SizeInPixels() {
 
 void OffScreenRenderWidgetHostView::CompositeFrame(
     const gfx::Rect& damage_rect) {
+  if (dirty_rects_only_) {
+    AddDamage(damage_rect);
+    return;
+  }
+
   HoldResize();
 
   gfx::Size size_in_pixels = SizeInPixels();
@@ -711,6 +759,9 @@ void OffScreenRenderWidgetHostView::CompositeFrame(
     }
   }
 
+  paint_stats_.delivered_bytes += frame.computeByteSize();
+  paint_stats_.full_frame_bytes += frame.computeByteSize();
+
   paint_callback_running_ = true;
   callback_.Run(gfx::IntersectRects(gfx::Rect(size_in_pixels), damage_rect),
                 frame);
@@ -719,6 +770,107 @@ void OffScreenRenderWidgetHostView::CompositeFrame(
   ReleaseResize();
 }
 
+void OffScreenRenderWidgetHostView::AddDamage(const gfx::Rect& damage_rect) {
+  pending_damage_.op(gfx::RectToSkIRect(damage_rect), SkRegion::kUnion_Op);
+  if (damage_flush_pending_)
+    return;
+
+  // Damage reported by this view, its popup and its proxy views before the
+  // flush runs is merged and delivered together.
+  damage_flush_pending_ = true;
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&OffScreenRenderWidgetHostView::FlushDamage,
+                                weak_ptr_factory_.GetWeakPtr()));
+}
+
+void OffScreenRenderWidgetHostView::FlushDamage() {
+  damage_flush_pending_ = false;
+  if (!dirty_rects_only_ || GetBacking().drawsNothing()) {
+    pending_damage_.setEmpty();
+    return;
+  }
+
+  gfx::Size size_in_pixels = SizeInPixels();
+  pending_damage_.op(gfx::RectToSkIRect(gfx::Rect(size_in_pixels)),
+                     SkRegion::kIntersect_Op);
+  std::vector<gfx::Rect> rects = GetCoalescedDamage();
+  pending_damage_.setEmpty();
+  if (rects.empty())
+    return;
+
+  paint_stats_.full_frame_bytes +=
+      static_cast<uint64_t>(size_in_pixels.GetArea()) *
+      GetBacking().bytesPerPixel();
+
+  HoldResize();
+
+  auto weak_this = weak_ptr_factory_.GetWeakPtr();
+  for (const gfx::Rect& rect : rects) {
+    SkBitmap tile = CompositeRect(rect);
+    paint_stats_.delivered_bytes += tile.computeByteSize();
+
+    paint_callback_running_ = true;
+    callback_.Run(rect, tile);
+    // The paint handler may have destroyed the view.
+    if (!weak_this)
+      return;
+    paint_callback_running_ = false;
+  }
+
+  ReleaseResize();
+}
+
+std::vector<gfx::Rect> OffScreenRenderWidgetHostView::GetCoalescedDamage()
+    const {
+  std::vector<gfx::Rect> rects;
+  for (SkRegion::Iterator it(pending_damage_); !it.done(); it.next())
+    rects.push_back(gfx::SkIRectToRect(it.rect()));
+  if (rects.size() <= kMaxPaintRects)
+    return rects;
+
+  // Many small uploads cost more than a few slightly larger ones, so merge
+  // the rects starting in the same tile.
+  std::map<std::pair<int, int>, gfx::Rect> tiles;
+  for (const gfx::Rect& rect : rects) {
+    tiles[{rect.x() / kPaintTileSize, rect.y() / kPaintTileSize}].Union(
+        rect);
+  }
+  if (tiles.size() > kMaxPaintRects)
+    return {gfx::SkIRectToRect(pending_damage_.getBounds())};
+
+  rects.clear();
+  for (const auto& tile : tiles)
+    rects.push_back(tile.second);
+  return rects;
+}
+
+SkBitmap OffScreenRenderWidgetHostView::CompositeRect(const gfx::Rect& rect) {
+  SkBitmap tile;
+  tile.allocN32Pixels(rect.width(), rect.height(), !transparent_);
+
+  SkCanvas canvas(tile);
+  canvas.writePixels(GetBacking(), -rect.x(), -rect.y());
+
+  if (popup_host_view_ && !popup_host_view_->GetBacking().drawsNothing()) {
+    gfx::Point origin_in_pixels = gfx::ToFlooredPoint(gfx::ConvertPointToPixels(
+        popup_host_view_->popup_position_.origin(),
+        current_device_scale_factor()));
+    canvas.writePixels(popup_host_view_->GetBacking(),
+                       origin_in_pixels.x() - rect.x(),
+                       origin_in_pixels.y() - rect.y());
+  }
+
+  for (auto* proxy_view : proxy_views_) {
+    gfx::Point origin_in_pixels = gfx::ToFlooredPoint(gfx::ConvertPointToPixels(
+        proxy_view->GetBounds().origin(), current_device_scale_factor()));
+    canvas.writePixels(*proxy_view->GetBitmap(),
+                       origin_in_pixels.x() - rect.x(),
+                       origin_in_pixels.y() - rect.y());
+  }
+
+  return tile;
+}
+
 void OffScreenRenderWidgetHostView::OnPopupPaint(const gfx::Rect& damage_rect) {
   InvalidateBounds(gfx::ToEnclosingRect(
       gfx::ConvertRectToPixels(damage_rect, current_device_scale_factor())));
@@ -896,6 +1048,9 @@ void OffScreenRenderWidgetHostView::SetPainting(bool painting) {
   } else if (host_display_client_) {
     host_display_client_->SetActive(IsPainting());
   }
+
+  if (painting)
+    RequestBeginFrames();
 }
 
 bool OffScreenRenderWidgetHostView::IsPainting() const {
@@ -927,6 +1082,30 @@ void OffScreenRenderWidgetHostView::SetFrameRate(int frame_rate) {
     guest_host_view->SetFrameRate(frame_rate);
 }
 
+void OffScreenRenderWidgetHostView::SetPaintDirtyRectsOnly(
+    bool dirty_rects_only) {
+  if (dirty_rects_only_ == dirty_rects_only)
+    return;
+
+  dirty_rects_only_ = dirty_rects_only;
+  if (!dirty_rects_only_)
+    return;
+
+  // The backing may still be referenced by the last full frame, take a
+  // private copy before updating it in place.
+  if (!GetBacking().drawsNothing()) {
+    auto backing = std::make_unique<SkBitmap>();
+    backing->allocN32Pixels(backing_->width(), backing_->height(),
+                            !transparent_);
+    backing_->readPixels(backing->pixmap());
+    backing_ = std::move(backing);
+  }
+
+  // Start with the whole frame so the consumer has something to apply the
+  // following dirty rects to.
+  AddDamage(gfx::Rect(SizeInPixels()));
+}
+
 int OffScreenRenderWidgetHostView::GetFrameRate() const {
   return frame_rate_;
 }
@@ -962,6 +1141,78 @@ void OffScreenRenderWidgetHostView::SetupFrameRate(bool force) {
   }
 }
 
+void OffScreenRenderWidgetHostView::RequestFrame() {
+  if (!on_demand_frames_) {
+    Invalidate();
+    return;
+  }
+
+  frame_requested_ = true;
+  RequestBeginFrames();
+}
+
+void OffScreenRenderWidgetHostView::RequestBeginFrames() {
+  if (!on_demand_frames_)
+    return;
+
+  remaining_begin_frames_ = kOnDemandBeginFrames;
+  ScheduleBeginFrame();
+}
+
+void OffScreenRenderWidgetHostView::OnNeedsBeginFrames(
+    bool needs_begin_frames) {
+  needs_begin_frames_ = needs_begin_frames;
+  if (needs_begin_frames_)
+    ScheduleBeginFrame();
+}
+
+void OffScreenRenderWidgetHostView::ScheduleBeginFrame() {
+  if (begin_frame_pending_)
+    return;
+
+  // Never exceed the configured frame rate.
+  base::TimeDelta delay =
+      last_begin_frame_time_ +
+      base::TimeDelta::FromMicroseconds(frame_rate_threshold_us_) -
+      base::TimeTicks::Now();
+  begin_frame_pending_ = true;
+  base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&OffScreenRenderWidgetHostView::IssueBeginFrame,
+                     weak_ptr_factory_.GetWeakPtr()),
+      std::max(delay, base::TimeDelta()));
+}
+
+void OffScreenRenderWidgetHostView::IssueBeginFrame() {
+  begin_frame_pending_ = false;
+  if (!compositor_ || !IsPainting())
+    return;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  base::TimeDelta interval =
+      base::TimeDelta::FromMicroseconds(frame_rate_threshold_us_);
+  viz::BeginFrameArgs args = viz::BeginFrameArgs::Create(
+      BEGINFRAME_FROM_HERE, viz::BeginFrameArgs::kManualSourceId,
+      begin_frame_number_++, now, now + interval, interval,
+      viz::BeginFrameArgs::NORMAL);
+  compositor_->IssueExternalBeginFrame(args, frame_requested_,
+                                       base::DoNothing());
+  last_begin_frame_time_ = now;
+
+  if (remaining_begin_frames_ > 0)
+    --remaining_begin_frames_;
+  if (needs_begin_frames_ || remaining_begin_frames_ > 0) {
+    ScheduleBeginFrame();
+    return;
+  }
+
+  // Nothing changed, hand out the current frame for an explicit request.
+  if (frame_requested_) {
+    frame_requested_ = false;
+    Invalidate();
+  }
+}
+
 void OffScreenRenderWidgetHostView::Invalidate() {
   InvalidateBounds(gfx::Rect(GetRequestedRendererSize()));
 }
@@ -1017,6 +1268,8 @@ void OffScreenRenderWidgetHostView::ResizeRootLayer(bool force) {
   if (render_widget_host_) {
     render_widget_host_->SynchronizeVisualProperties();
   }
+
+  RequestBeginFrames();
 }
 
 viz::FrameSinkId OffScreenRenderWidgetHostView::AllocateFrameSinkId() {
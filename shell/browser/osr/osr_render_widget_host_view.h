@@ -29,6 +29,7 @@
 #include "shell/browser/osr/osr_view_proxy.h"
 #include "third_party/blink/public/platform/web_vector.h"
 #include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkRegion.h"
 #include "ui/base/ime/text_input_client.h"
 #include "ui/compositor/compositor.h"
 #include "ui/compositor/layer_delegate.h"
@@ -55,6 +56,13 @@ class ElectronDelegatedFrameHostClient;
 typedef base::Callback<void(const gfx::Rect&, const SkBitmap&)> OnPaintCallback;
 typedef base::Callback<void(const gfx::Rect&)> OnPopupPaintCallback;
 
+// Number of pixel bytes handed to the paint callback, compared with what
+// delivering the whole frame every time would have cost.
+struct OffScreenPaintStats {
+  uint64_t delivered_bytes = 0;
+  uint64_t full_frame_bytes = 0;
+};
+
 class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
                                       public ui::CompositorDelegate,
                                       public OffscreenViewProxyObserver {
@@ -62,6 +70,7 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   OffScreenRenderWidgetHostView(bool transparent,
                                 bool painting,
                                 int frame_rate,
+                                bool on_demand_frames,
                                 const OnPaintCallback& callback,
                                 content::RenderWidgetHost* render_widget_host,
                                 OffScreenRenderWidgetHostView* parent_host_view,
@@ -189,6 +198,20 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
 
+  // When enabled only the damaged pixels are copied into the backing store,
+  // and the paint callback receives the damaged sub-rectangles (coalesced
+  // into tiles) instead of the full frame.
+  void SetPaintDirtyRectsOnly(bool dirty_rects_only);
+  bool IsPaintingDirtyRectsOnly() const { return dirty_rects_only_; }
+  const OffScreenPaintStats& paint_stats() const { return paint_stats_; }
+
+  // In on-demand mode BeginFrames are only issued, at most at the frame rate,
+  // while the display compositor reports that something needs them, and for a
+  // few frames after showing, resizing or navigating. RequestFrame()
+  // additionally guarantees a paint even when nothing changed.
+  void RequestFrame();
+  bool on_demand_frames() const { return on_demand_frames_; }
+
   ui::Compositor* GetCompositor() const;
   ui::Layer* GetRootLayer() const;
 
@@ -215,6 +238,17 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void SetupFrameRate(bool force);
   void ResizeRootLayer(bool force);
 
+  void RequestBeginFrames();
+  void OnNeedsBeginFrames(bool needs_begin_frames);
+  void ScheduleBeginFrame();
+  void IssueBeginFrame();
+
+  void CopyToBacking(const gfx::Rect& damage_rect, const SkBitmap& bitmap);
+  void AddDamage(const gfx::Rect& damage_rect);
+  void FlushDamage();
+  std::vector<gfx::Rect> GetCoalescedDamage() const;
+  SkBitmap CompositeRect(const gfx::Rect& rect);
+
   viz::FrameSinkId AllocateFrameSinkId();
 
   // Applies background color without notifying the RenderWidget about
@@ -237,6 +271,14 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   int frame_rate_ = 0;
   int frame_rate_threshold_us_ = 0;
 
+  const bool on_demand_frames_;
+  bool needs_begin_frames_ = false;
+  bool frame_requested_ = false;
+  bool begin_frame_pending_ = false;
+  int remaining_begin_frames_ = 0;
+  uint64_t begin_frame_number_ = viz::BeginFrameArgs::kStartingFrameNumber;
+  base::TimeTicks last_begin_frame_time_;
+
   base::Time last_time_ = base::Time::Now();
 
   gfx::Vector2dF last_scroll_offset_;
@@ -252,6 +294,11 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
 
   bool paint_callback_running_ = false;
 
+  bool dirty_rects_only_ = false;
+  bool damage_flush_pending_ = false;
+  SkRegion pending_damage_;
+  OffScreenPaintStats paint_stats_;
+
   viz::LocalSurfaceId delegated_frame_host_surface_id_;
   viz::ParentLocalSurfaceIdAllocator delegated_frame_host_allocator_;
 
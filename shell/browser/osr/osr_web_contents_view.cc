@@ -13,8 +13,11 @@ namespace electron {
 
 OffScreenWebContentsView::OffScreenWebContentsView(
     bool transparent,
+    bool on_demand_frames,
     const OnPaintCallback& callback)
-    : transparent_(transparent), callback_(callback) {
+    : transparent_(transparent),
+      on_demand_frames_(on_demand_frames),
+      callback_(callback) {
 #if defined(OS_MAC)
   PlatformCreate();
 #endif
@@ -118,9 +121,11 @@ OffScreenWebContentsView::CreateViewForWidget(
         render_widget_host->GetView());
   }
 
-  return new OffScreenRenderWidgetHostView(
-      transparent_, painting_, GetFrameRate(), callback_, render_widget_host,
-      nullptr, GetSize());
+  auto* view = new OffScreenRenderWidgetHostView(
+      transparent_, painting_, GetFrameRate(), on_demand_frames_, callback_,
+      render_widget_host, nullptr, GetSize());
+  view->SetPaintDirtyRectsOnly(dirty_rects_only_);
+  return view;
 }
 
 content::RenderWidgetHostViewBase*
@@ -134,9 +139,9 @@ OffScreenWebContentsView::CreateViewForChildWidget(
           ? web_contents_impl->GetOuterWebContents()->GetRenderWidgetHostView()
           : web_contents_impl->GetRenderWidgetHostView());
 
-  return new OffScreenRenderWidgetHostView(transparent_, painting_,
-                                           view->GetFrameRate(), callback_,
-                                           render_widget_host, view, GetSize());
+  return new OffScreenRenderWidgetHostView(
+      transparent_, painting_, view->GetFrameRate(), false, callback_,
+      render_widget_host, view, GetSize());
 }
 
 void OffScreenWebContentsView::SetPageTitle(const std::u16string& title) {}
@@ -207,6 +212,23 @@ int OffScreenWebContentsView::GetFrameRate() const {
   }
 }
 
+void OffScreenWebContentsView::SetPaintDirtyRectsOnly(bool dirty_rects_only) {
+  auto* view = GetView();
+  dirty_rects_only_ = dirty_rects_only;
+  if (view != nullptr) {
+    view->SetPaintDirtyRectsOnly(dirty_rects_only);
+  }
+}
+
+bool OffScreenWebContentsView::IsPaintingDirtyRectsOnly() const {
+  return dirty_rects_only_;
+}
+
+OffScreenPaintStats OffScreenWebContentsView::GetPaintStats() const {
+  auto* view = GetView();
+  return view ? view->paint_stats() : OffScreenPaintStats();
+}
+
 OffScreenRenderWidgetHostView* OffScreenWebContentsView::GetView() const {
   if (web_contents_) {
     return static_cast<OffScreenRenderWidgetHostView*>(
@@ -28,7 +28,9 @@ class OffScreenWebContentsView : public content::WebContentsView,
                                  public content::RenderViewHostDelegateView,
                                  public NativeWindowObserver {
  public:
-  OffScreenWebContentsView(bool transparent, const OnPaintCallback& callback);
+  OffScreenWebContentsView(bool transparent,
+                           bool on_demand_frames,
+                           const OnPaintCallback& callback);
   ~OffScreenWebContentsView() override;
 
   void SetWebContents(content::WebContents*);
@@ -79,6 +81,9 @@ class OffScreenWebContentsView : public content::WebContentsView,
   bool IsPainting() const;
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
+  void SetPaintDirtyRectsOnly(bool dirty_rects_only);
+  bool IsPaintingDirtyRectsOnly() const;
+  OffScreenPaintStats GetPaintStats() const;
 
  private:
 #if defined(OS_MAC)
@@ -91,8 +96,10 @@ class OffScreenWebContentsView : public content::WebContentsView,
   NativeWindow* native_window_ = nullptr;
 
   const bool transparent_;
+  const bool on_demand_frames_;
   bool painting_ = true;
   int frame_rate_ = 60;
+  bool dirty_rects_only_ = false;
   OnPaintCallback callback_;
 
   // Weak refs.
@@ -15,6 +15,19 @@ namespace electron {
 
 class SessionPreferences : public base::SupportsUserData::Data {
  public:
+  // Lets pages of the same site share renderers, see
+  // ses.setRendererSharingPolicy().
+  struct RendererSharingPolicy {
+    // Number of renderers the session's pages can use before new pages are
+    // placed in existing renderers. 0 means no limit.
+    size_t max_renderers = 0;
+    // Number of renderers a site can use before its new pages are placed in
+    // them. 0 means sites only share renderers over |max_renderers|.
+    size_t sharing_threshold = 0;
+
+    bool enabled() const { return max_renderers || sharing_threshold; }
+  };
+
   static SessionPreferences* FromBrowserContext(
       content::BrowserContext* context);
   static std::vector<base::FilePath> GetValidPreloads(
@@ -28,11 +41,24 @@ class SessionPreferences : public base::SupportsUserData::Data {
   }
   const std::vector<base::FilePath>& preloads() const { return preloads_; }
 
+  void set_renderer_sharing_policy(const RendererSharingPolicy& policy) {
+    renderer_sharing_policy_ = policy;
+  }
+  const RendererSharingPolicy& renderer_sharing_policy() const {
+    return renderer_sharing_policy_;
+  }
+
+  // Navigations that were placed in an existing renderer by the policy.
+  void RecordSharedNavigation() { shared_navigations_++; }
+  uint64_t shared_navigations() const { return shared_navigations_; }
+
  private:
   // The user data key.
   static int kLocatorKey;
 
   std::vector<base::FilePath> preloads_;
+  RendererSharingPolicy renderer_sharing_policy_;
+  uint64_t shared_navigations_ = 0;
 };
 
 }  // namespace electron
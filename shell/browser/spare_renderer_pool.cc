@@ -0,0 +1,151 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/spare_renderer_pool.h"
+
+#include <algorithm>
+
+#include "base/json/json_writer.h"
+#include "base/values.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/site_instance.h"
+#include "shell/browser/electron_browser_client.h"
+
+namespace electron {
+
+SpareRendererPool::Profile::Profile() = default;
+SpareRendererPool::Profile::Profile(const Profile&) = default;
+SpareRendererPool::Profile::~Profile() = default;
+
+SpareRendererPool::SpareRendererPool(content::BrowserContext* browser_context)
+    : browser_context_(browser_context) {}
+
+SpareRendererPool::~SpareRendererPool() {
+  for (auto& profile : profiles_)
+    Release(&profile);
+}
+
+// static
+std::string SpareRendererPool::GetProfile(const base::Value& web_preferences) {
+  // Dictionary keys are written in order, so equal preferences give equal
+  // profiles.
+  std::string profile;
+  base::JSONWriter::Write(web_preferences, &profile);
+  return profile;
+}
+
+void SpareRendererPool::SetOptions(size_t count, size_t max_profiles) {
+  count_ = count;
+  max_profiles_ = std::max<size_t>(max_profiles, 1);
+  size_t kept = count_ ? max_profiles_ : 0;
+  while (profiles_.size() > kept) {
+    Release(&profiles_.back());
+    profiles_.pop_back();
+  }
+  for (auto& profile : profiles_) {
+    while (profile.spares.size() > count_) {
+      if (IsUnused(profile.spares.back().get()))
+        profile.spares.back()->GetProcess()->Cleanup();
+      profile.spares.pop_back();
+    }
+  }
+}
+
+scoped_refptr<content::SiteInstance> SpareRendererPool::Take(
+    const std::string& profile_key) {
+  Profile* profile = Touch(profile_key);
+  while (!profile->spares.empty()) {
+    scoped_refptr<content::SiteInstance> site_instance =
+        std::move(profile->spares.front());
+    profile->spares.erase(profile->spares.begin());
+    if (IsUnused(site_instance.get())) {
+      metrics_.hits++;
+      return site_instance;
+    }
+    metrics_.discarded++;
+  }
+  metrics_.misses++;
+  return nullptr;
+}
+
+void SpareRendererPool::Replenish(const std::string& profile_key,
+                                  content::WebContents* web_contents) {
+  if (!enabled())
+    return;
+  Profile* profile = Touch(profile_key);
+  auto& spares = profile->spares;
+  spares.erase(std::remove_if(spares.begin(), spares.end(),
+                              [this](const auto& site_instance) {
+                                if (IsUnused(site_instance.get()))
+                                  return false;
+                                metrics_.discarded++;
+                                return true;
+                              }),
+               spares.end());
+
+  auto* browser_client = ElectronBrowserClient::Get();
+  while (spares.size() < count_) {
+    scoped_refptr<content::SiteInstance> site_instance =
+        content::SiteInstance::Create(browser_context_);
+    if (!browser_client->LaunchSpareRenderer(site_instance.get(),
+                                             web_contents))
+      break;
+    metrics_.launched++;
+    spares.push_back(std::move(site_instance));
+  }
+}
+
+void SpareRendererPool::RecordFirstPaint(bool used_spare,
+                                         base::TimeDelta time) {
+  if (used_spare) {
+    metrics_.first_paint_with_spare += time;
+    metrics_.first_paints_with_spare++;
+  } else {
+    metrics_.first_paint_without_spare += time;
+    metrics_.first_paints_without_spare++;
+  }
+}
+
+size_t SpareRendererPool::GetSpareCount() const {
+  size_t count = 0;
+  for (const auto& profile : profiles_)
+    count += profile.spares.size();
+  return count;
+}
+
+SpareRendererPool::Profile* SpareRendererPool::Touch(const std::string& key) {
+  auto it = std::find_if(profiles_.begin(), profiles_.end(),
+                         [&key](const Profile& p) { return p.key == key; });
+  if (it != profiles_.end()) {
+    profiles_.splice(profiles_.begin(), profiles_, it);
+  } else {
+    profiles_.emplace_front();
+    profiles_.front().key = key;
+    while (profiles_.size() > max_profiles_) {
+      Release(&profiles_.back());
+      profiles_.pop_back();
+    }
+  }
+  return &profiles_.front();
+}
+
+void SpareRendererPool::Release(Profile* profile) {
+  // Shut down the renderers that were never used, like Chromium does with its
+  // own spare renderer.
+  for (auto& site_instance : profile->spares) {
+    if (IsUnused(site_instance.get()))
+      site_instance->GetProcess()->Cleanup();
+  }
+  profile->spares.clear();
+}
+
+// static
+bool SpareRendererPool::IsUnused(content::SiteInstance* site_instance) {
+  if (!site_instance->HasProcess())
+    return false;
+  content::RenderProcessHost* process = site_instance->GetProcess();
+  return process->IsInitializedAndNotDead() && process->IsUnused();
+}
+
+}  // namespace electron
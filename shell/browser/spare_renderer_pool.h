@@ -0,0 +1,108 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_SPARE_RENDERER_POOL_H_
+#define SHELL_BROWSER_SPARE_RENDERER_POOL_H_
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/time/time.h"
+
+namespace base {
+class Value;
+}
+
+namespace content {
+class BrowserContext;
+class SiteInstance;
+class WebContents;
+}  // namespace content
+
+namespace electron {
+
+// Keeps renderer processes of a session launched ahead of time, so that new
+// webContents don't wait for a renderer to start before their first
+// navigation. Renderers are launched with command line switches derived from
+// webPreferences, so spares are grouped by profile: a spare is modelled on
+// the last webContents created with a given set of webPreferences, and is
+// handed to the next one created with the same set.
+class SpareRendererPool {
+ public:
+  struct Metrics {
+    uint64_t launched = 0;
+    // webContents that were given a spare renderer.
+    uint64_t hits = 0;
+    // webContents that had to launch their own renderer.
+    uint64_t misses = 0;
+    // Spares that were dropped before being handed out, either because their
+    // renderer exited or because another page was placed in it.
+    uint64_t discarded = 0;
+    // Time from creating a webContents to its first paint.
+    base::TimeDelta first_paint_with_spare;
+    uint64_t first_paints_with_spare = 0;
+    base::TimeDelta first_paint_without_spare;
+    uint64_t first_paints_without_spare = 0;
+  };
+
+  explicit SpareRendererPool(content::BrowserContext* browser_context);
+  ~SpareRendererPool();
+
+  // Returns the key grouping webContents created with |web_preferences|.
+  static std::string GetProfile(const base::Value& web_preferences);
+
+  // |count| spares are kept for each of the |max_profiles| most recently used
+  // profiles. A |count| of 0 disables the pool and shuts the spares down.
+  void SetOptions(size_t count, size_t max_profiles);
+  bool enabled() const { return count_ > 0; }
+  size_t count() const { return count_; }
+  size_t max_profiles() const { return max_profiles_; }
+
+  // Returns a SiteInstance whose renderer was launched for |profile|, or
+  // nullptr if there is none left.
+  scoped_refptr<content::SiteInstance> Take(const std::string& profile);
+
+  // Launches the missing spares of |profile| with the preferences of
+  // |web_contents|.
+  void Replenish(const std::string& profile,
+                 content::WebContents* web_contents);
+
+  void RecordFirstPaint(bool used_spare, base::TimeDelta time);
+
+  size_t GetSpareCount() const;
+  const Metrics& metrics() const { return metrics_; }
+
+ private:
+  struct Profile {
+    Profile();
+    Profile(const Profile&);
+    ~Profile();
+
+    std::string key;
+    std::vector<scoped_refptr<content::SiteInstance>> spares;
+  };
+
+  // Moves |key| to the front of |profiles_|, dropping the least recently used
+  // profiles over |max_profiles_|.
+  Profile* Touch(const std::string& key);
+  void Release(Profile* profile);
+  // Whether |site_instance|'s renderer is running and has never hosted a page.
+  static bool IsUnused(content::SiteInstance* site_instance);
+
+  content::BrowserContext* browser_context_;
+  size_t count_ = 0;
+  size_t max_profiles_ = 1;
+  // Most recently used first.
+  std::list<Profile> profiles_;
+  Metrics metrics_;
+
+  DISALLOW_COPY_AND_ASSIGN(SpareRendererPool);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_SPARE_RENDERER_POOL_H_
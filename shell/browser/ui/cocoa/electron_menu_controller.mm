@@ -13,6 +13,7 @@
 #include "base/strings/sys_string_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/mac/url_conversions.h"
@@ -231,6 +232,8 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
 // Creates a NSMenu from the given model. If the model has submenus, this can
 // be invoked recursively.
 - (NSMenu*)menuFromModel:(electron::ElectronMenuModel*)model {
+  TRACE_EVENT1("electron.menu", "ElectronMenuController::menuFromModel",
+               "items", model->GetItemCount());
   NSMenu* menu = [[[NSMenu alloc] initWithTitle:@""] autorelease];
 
   const int count = model->GetItemCount();
@@ -16,6 +16,12 @@ ElectronMenuModel::SharingItem::SharingItem(SharingItem&&) = default;
 ElectronMenuModel::SharingItem::~SharingItem() = default;
 #endif
 
+ElectronMenuModel::ItemState::ItemState() = default;
+ElectronMenuModel::ItemState::ItemState(const ItemState&) = default;
+ElectronMenuModel::ItemState& ElectronMenuModel::ItemState::operator=(
+    const ItemState&) = default;
+ElectronMenuModel::ItemState::~ItemState() = default;
+
 bool ElectronMenuModel::Delegate::GetAcceleratorForCommandId(
     int command_id,
     ui::Accelerator* accelerator) const {
@@ -72,6 +78,22 @@ bool ElectronMenuModel::GetAcceleratorAtWithParams(
   return false;
 }
 
+void ElectronMenuModel::SetItemState(int command_id,
+                                     const ItemState& state) {
+  item_states_[command_id] = state;
+}
+
+const ElectronMenuModel::ItemState* ElectronMenuModel::GetItemState(
+    int command_id) const {
+  const auto iter = item_states_.find(command_id);
+  return iter == std::end(item_states_) ? nullptr : &iter->second;
+}
+
+void ElectronMenuModel::Clear() {
+  ui::SimpleMenuModel::Clear();
+  item_states_.clear();
+}
+
 bool ElectronMenuModel::ShouldRegisterAcceleratorAt(int index) const {
   if (delegate_) {
     return delegate_->ShouldRegisterAcceleratorForCommandId(
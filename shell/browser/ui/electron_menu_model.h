@@ -14,6 +14,7 @@
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
 #include "base/optional.h"
+#include "ui/base/accelerators/accelerator.h"
 #include "ui/base/models/simple_menu_model.h"
 #include "url/gurl.h"
 
@@ -34,6 +35,24 @@ class ElectronMenuModel : public ui::SimpleMenuModel {
   };
 #endif
 
+  // Snapshot of the per-item state the delegate would otherwise be queried
+  // for. It is kept up to date by whoever owns the items, so that showing a
+  // menu or matching an accelerator doesn't have to ask the delegate.
+  struct ItemState {
+    ItemState();
+    ItemState(const ItemState&);
+    ItemState& operator=(const ItemState&);
+    ~ItemState();
+
+    bool checked = false;
+    bool enabled = true;
+    bool visible = true;
+    bool works_when_hidden = true;
+    bool register_accelerator = true;
+    base::Optional<ui::Accelerator> accelerator;
+    base::Optional<ui::Accelerator> default_accelerator;
+  };
+
   class Delegate : public ui::SimpleMenuModel::Delegate {
    public:
     ~Delegate() override {}
@@ -87,6 +106,12 @@ class ElectronMenuModel : public ui::SimpleMenuModel {
                                   bool use_default_accelerator,
                                   ui::Accelerator* accelerator) const;
   bool ShouldRegisterAcceleratorAt(int index) const;
+  // Set/Get the cached state of the item with |command_id|. Items without a
+  // cached state are answered by the delegate.
+  void SetItemState(int command_id, const ItemState& state);
+  const ItemState* GetItemState(int command_id) const;
+  // Removes all items along with their cached state.
+  void Clear();
   bool WorksWhenHiddenAt(int index) const;
 #if defined(OS_MAC)
   // Return the SharingItem of menu item.
@@ -117,6 +142,7 @@ class ElectronMenuModel : public ui::SimpleMenuModel {
   std::map<int, std::u16string> toolTips_;   // command id -> tooltip
   std::map<int, std::u16string> roles_;      // command id -> role
   std::map<int, std::u16string> sublabels_;  // command id -> sublabel
+  std::map<int, ItemState> item_states_;     // command id -> state
   base::ObserverList<Observer> observers_;
 
   base::WeakPtrFactory<ElectronMenuModel> weak_factory_{this};
@@ -11,6 +11,7 @@
 
 #include "base/command_line.h"
 #include "base/memory/ptr_util.h"
+#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "cc/base/switches.h"
@@ -116,6 +117,15 @@ namespace electron {
 // static
 std::vector<WebContentsPreferences*> WebContentsPreferences::instances_;
 
+// static
+std::unordered_map<int, WebContentsPreferences*>
+    WebContentsPreferences::process_index_;
+
+WebContentsPreferences::ParsedPreferences::ParsedPreferences() = default;
+WebContentsPreferences::ParsedPreferences::ParsedPreferences(
+    const ParsedPreferences&) = default;
+WebContentsPreferences::ParsedPreferences::~ParsedPreferences() = default;
+
 WebContentsPreferences::WebContentsPreferences(
     content::WebContents* web_contents,
     const gin_helper::Dictionary& web_preferences)
@@ -190,6 +200,8 @@ WebContentsPreferences::WebContentsPreferences(
 WebContentsPreferences::~WebContentsPreferences() {
   instances_.erase(std::remove(instances_.begin(), instances_.end(), this),
                    instances_.end());
+  base::EraseIf(process_index_,
+                [this](const auto& entry) { return entry.second == this; });
 }
 
 void WebContentsPreferences::SetDefaults() {
@@ -198,6 +210,142 @@ void WebContentsPreferences::SetDefaults() {
   }
 
   last_preference_ = preference_.Clone();
+  ParsePreferences();
+}
+
+void WebContentsPreferences::ParsePreferences() {
+  ParsedPreferences parsed;
+
+  parsed.experimental_features = IsEnabled(options::kExperimentalFeatures);
+  parsed.sandbox = IsEnabled(options::kSandbox);
+  parsed.offscreen = IsEnabled(options::kOffscreen);
+#if defined(OS_MAC)
+  parsed.scroll_bounce = IsEnabled(options::kScrollBounce);
+#endif
+  parsed.disable_popups = IsEnabled("disablePopups");
+
+  parsed.javascript = IsEnabled(options::kJavaScript, true);
+  parsed.images = IsEnabled(options::kImages, true);
+  parsed.text_areas_are_resizable =
+      IsEnabled(options::kTextAreasAreResizable, true);
+  parsed.navigate_on_drag_drop = IsEnabled(options::kNavigateOnDragDrop);
+  GetAsAutoplayPolicy(&preference_, "autoplayPolicy", &parsed.autoplay_policy);
+  parsed.webgl = IsEnabled(options::kWebGL, true);
+  parsed.web_security = IsEnabled(options::kWebSecurity, true);
+  parsed.allow_running_insecure_content = IsEnabled(
+      options::kAllowRunningInsecureContent, !parsed.web_security);
+  parsed.context_isolation = IsEnabled(options::kContextIsolation, true);
+  parsed.native_window_open = IsEnabled(options::kNativeWindowOpen);
+  parsed.node_integration = IsEnabled(options::kNodeIntegration);
+  parsed.node_integration_in_worker =
+      IsEnabled(options::kNodeIntegrationInWorker);
+  parsed.node_integration_in_sub_frames =
+      IsEnabled(options::kNodeIntegrationInSubFrames);
+#if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
+  parsed.spellcheck = IsEnabled(options::kSpellcheck);
+#endif
+  parsed.plugins = IsEnabled(options::kPlugins);
+  parsed.webview_tag = IsEnabled(options::kWebviewTag);
+  parsed.enable_websql = IsEnabled(options::kEnableWebSQL);
+
+  std::string s;
+  if (GetAsString(&preference_, options::kEnableBlinkFeatures, &s))
+    parsed.enable_blink_features = s;
+  if (GetAsString(&preference_, options::kDisableBlinkFeatures, &s))
+    parsed.disable_blink_features = s;
+  if (GetAsString(&preference_, "defaultEncoding", &s))
+    parsed.default_encoding = s;
+  if (GetAsString(&preference_, options::kBackgroundColor, &s))
+    parsed.background_color = s;
+  if (GetAsString(&preference_, "v8CacheOptions", &s)) {
+    if (s == "none") {
+      parsed.v8_cache_options = blink::mojom::V8CacheOptions::kNone;
+    } else if (s == "code") {
+      parsed.v8_cache_options = blink::mojom::V8CacheOptions::kCode;
+    } else if (s == "bypassHeatCheck") {
+      parsed.v8_cache_options =
+          blink::mojom::V8CacheOptions::kCodeWithoutHeatCheck;
+    } else if (s == "bypassHeatCheckAndEagerCompile") {
+      parsed.v8_cache_options =
+          blink::mojom::V8CacheOptions::kFullCodeWithoutHeatCheck;
+    } else {
+      parsed.v8_cache_options = blink::mojom::V8CacheOptions::kDefault;
+    }
+  }
+
+  auto* fonts_dict = preference_.FindKeyOfType("defaultFontFamily",
+                                               base::Value::Type::DICTIONARY);
+  if (fonts_dict) {
+    std::u16string font;
+    if (GetAsString(fonts_dict, "standard", &font))
+      parsed.standard_font_family = font;
+    if (GetAsString(fonts_dict, "serif", &font))
+      parsed.serif_font_family = font;
+    if (GetAsString(fonts_dict, "sansSerif", &font))
+      parsed.sans_serif_font_family = font;
+    if (GetAsString(fonts_dict, "monospace", &font))
+      parsed.monospace_font_family = font;
+    if (GetAsString(fonts_dict, "cursive", &font))
+      parsed.cursive_font_family = font;
+    if (GetAsString(fonts_dict, "fantasy", &font))
+      parsed.fantasy_font_family = font;
+  }
+
+  int i;
+  if (GetAsInteger(&preference_, "defaultFontSize", &i))
+    parsed.default_font_size = i;
+  if (GetAsInteger(&preference_, "defaultMonospaceFontSize", &i))
+    parsed.default_monospace_font_size = i;
+  if (GetAsInteger(&preference_, "minimumFontSize", &i))
+    parsed.minimum_font_size = i;
+  if (GetAsInteger(&preference_, options::kOpenerID, &i))
+    parsed.opener_id = i;
+  if (GetAsInteger(&preference_, options::kGuestInstanceID, &i))
+    parsed.guest_instance_id = i;
+
+  auto* custom_args =
+      preference_.FindKeyOfType(options::kCustomArgs, base::Value::Type::LIST);
+  if (custom_args) {
+    for (const auto& custom_arg : custom_args->GetList()) {
+      if (custom_arg.is_string())
+        parsed.custom_args.push_back(custom_arg.GetString());
+    }
+  }
+
+  auto* switches =
+      preference_.FindKeyOfType("commandLineSwitches", base::Value::Type::LIST);
+  if (switches) {
+    for (const auto& arg : switches->GetList()) {
+      if (arg.is_string() && !arg.GetString().empty())
+        parsed.command_line_switches.push_back(arg.GetString());
+    }
+  }
+
+  base::FilePath::StringType preload_path;
+  if (GetAsString(&preference_, options::kPreloadScript, &preload_path)) {
+    base::FilePath preload(preload_path);
+    if (preload.IsAbsolute()) {
+      parsed.preload_path = std::move(preload);
+    } else {
+      LOG(ERROR) << "preload script must have absolute path.";
+    }
+  } else if (GetAsString(&preference_, options::kPreloadURL, &preload_path)) {
+    // Translate to file path if there is "preload-url" option.
+    base::FilePath preload;
+    GURL preload_url;
+#if defined(OS_WIN)
+    preload_url = GURL(base::WideToUTF8(preload_path));
+#else
+    preload_url = GURL(preload_path);
+#endif
+    if (net::FileURLToFilePath(preload_url, &preload)) {
+      parsed.preload_path = std::move(preload);
+    } else {
+      LOG(ERROR) << "preload url must be file:// protocol.";
+    }
+  }
+
+  parsed_ = std::move(parsed);
 }
 
 bool WebContentsPreferences::IsUndefined(base::StringPiece key) {
@@ -239,6 +387,7 @@ void WebContentsPreferences::Merge(const base::DictionaryValue& extend) {
 void WebContentsPreferences::Clear() {
   if (preference_.is_dict())
     static_cast<base::DictionaryValue*>(&preference_)->Clear();
+  ParsePreferences();
 }
 
 bool WebContentsPreferences::GetPreference(base::StringPiece name,
@@ -246,43 +395,59 @@ bool WebContentsPreferences::GetPreference(base::StringPiece name,
   return GetAsString(&preference_, name, value);
 }
 
+void WebContentsPreferences::SetPreference(base::StringPiece name,
+                                           base::Value value) {
+  preference_.SetKey(name, std::move(value));
+  ParsePreferences();
+}
+
 bool WebContentsPreferences::GetPreloadPath(base::FilePath* path) const {
   DCHECK(path);
-  base::FilePath::StringType preload_path;
-  if (GetAsString(&preference_, options::kPreloadScript, &preload_path)) {
-    base::FilePath preload(preload_path);
-    if (preload.IsAbsolute()) {
-      *path = std::move(preload);
-      return true;
-    } else {
-      LOG(ERROR) << "preload script must have absolute path.";
-    }
-  } else if (GetAsString(&preference_, options::kPreloadURL, &preload_path)) {
-    // Translate to file path if there is "preload-url" option.
-    base::FilePath preload;
-    GURL preload_url;
-#if defined(OS_WIN)
-    preload_url = GURL(base::WideToUTF8(preload_path));
-#else
-    preload_url = GURL(preload_path);
+  if (!parsed_.preload_path)
+    return false;
+  *path = *parsed_.preload_path;
+  return true;
+}
+
+bool WebContentsPreferences::IsRendererCompatibleWith(
+    const WebContentsPreferences& other) const {
+  const ParsedPreferences& a = parsed_;
+  const ParsedPreferences& b = other.parsed_;
+  return a.sandbox == b.sandbox && a.node_integration == b.node_integration &&
+         a.node_integration_in_sub_frames ==
+             b.node_integration_in_sub_frames &&
+         a.node_integration_in_worker == b.node_integration_in_worker &&
+         a.context_isolation == b.context_isolation &&
+         a.native_window_open == b.native_window_open &&
+         a.web_security == b.web_security && a.offscreen == b.offscreen &&
+         a.experimental_features == b.experimental_features &&
+#if defined(OS_MAC)
+         a.scroll_bounce == b.scroll_bounce &&
 #endif
-    if (net::FileURLToFilePath(preload_url, &preload)) {
-      *path = std::move(preload);
-      return true;
-    } else {
-      LOG(ERROR) << "preload url must be file:// protocol.";
-    }
-  }
-  return false;
+         a.enable_blink_features == b.enable_blink_features &&
+         a.disable_blink_features == b.disable_blink_features &&
+         a.preload_path == b.preload_path && a.custom_args == b.custom_args &&
+         a.command_line_switches == b.command_line_switches &&
+         !a.guest_instance_id && !b.guest_instance_id;
 }
 
 // static
 content::WebContents* WebContentsPreferences::GetWebContentsFromProcessID(
     int process_id) {
+  auto iter = process_index_.find(process_id);
+  if (iter != process_index_.end()) {
+    content::WebContents* web_contents = iter->second->web_contents_;
+    if (web_contents->GetMainFrame()->GetProcess()->GetID() == process_id)
+      return web_contents;
+    process_index_.erase(iter);
+  }
+
   for (WebContentsPreferences* preferences : instances_) {
     content::WebContents* web_contents = preferences->web_contents_;
-    if (web_contents->GetMainFrame()->GetProcess()->GetID() == process_id)
+    if (web_contents->GetMainFrame()->GetProcess()->GetID() == process_id) {
+      process_index_[process_id] = preferences;
       return web_contents;
+    }
   }
   return nullptr;
 }
@@ -297,18 +462,19 @@ WebContentsPreferences* WebContentsPreferences::From(
 
 void WebContentsPreferences::AppendCommandLineSwitches(
     base::CommandLine* command_line,
-    bool is_subframe) {
+    bool is_subframe,
+    bool is_spare) {
   // Experimental flags.
-  if (IsEnabled(options::kExperimentalFeatures))
+  if (parsed_.experimental_features)
     command_line->AppendSwitch(
         ::switches::kEnableExperimentalWebPlatformFeatures);
 
   // Sandbox can be enabled for renderer processes hosting cross-origin frames
   // unless nodeIntegrationInSubFrames is enabled
   bool can_sandbox_frame =
-      is_subframe && !IsEnabled(options::kNodeIntegrationInSubFrames);
+      is_subframe && !parsed_.node_integration_in_sub_frames;
 
-  if (IsEnabled(options::kSandbox) || can_sandbox_frame) {
+  if (parsed_.sandbox || can_sandbox_frame) {
     command_line->AppendSwitch(switches::kEnableSandbox);
   } else if (!command_line->HasSwitch(switches::kEnableSandbox)) {
     command_line->AppendSwitch(sandbox::policy::switches::kNoSandbox);
@@ -316,134 +482,107 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   }
 
   // Custom args for renderer process
-  auto* customArgs =
-      preference_.FindKeyOfType(options::kCustomArgs, base::Value::Type::LIST);
-  if (customArgs) {
-    for (const auto& customArg : customArgs->GetList()) {
-      if (customArg.is_string())
-        command_line->AppendArg(customArg.GetString());
-    }
-  }
+  for (const auto& custom_arg : parsed_.custom_args)
+    command_line->AppendArg(custom_arg);
 
   // --offscreen
   // TODO(loc): Offscreen is duplicated in WebPreferences because it's needed
   // earlier than we can get WebPreferences at the moment.
-  if (IsEnabled(options::kOffscreen)) {
+  if (parsed_.offscreen) {
     command_line->AppendSwitch(options::kOffscreen);
   }
 
 #if defined(OS_MAC)
   // Enable scroll bounce.
-  if (IsEnabled(options::kScrollBounce))
+  if (parsed_.scroll_bounce)
     command_line->AppendSwitch(switches::kScrollBounce);
 #endif
 
   // Custom command line switches.
-  auto* args =
-      preference_.FindKeyOfType("commandLineSwitches", base::Value::Type::LIST);
-  if (args) {
-    for (const auto& arg : args->GetList()) {
-      if (arg.is_string()) {
-        const auto& arg_val = arg.GetString();
-        if (!arg_val.empty())
-          command_line->AppendSwitch(arg_val);
-      }
-    }
-  }
+  for (const auto& arg : parsed_.command_line_switches)
+    command_line->AppendSwitch(arg);
 
-  std::string s;
   // Enable blink features.
-  if (GetAsString(&preference_, options::kEnableBlinkFeatures, &s))
-    command_line->AppendSwitchASCII(::switches::kEnableBlinkFeatures, s);
+  if (parsed_.enable_blink_features)
+    command_line->AppendSwitchASCII(::switches::kEnableBlinkFeatures,
+                                    *parsed_.enable_blink_features);
 
   // Disable blink features.
-  if (GetAsString(&preference_, options::kDisableBlinkFeatures, &s))
-    command_line->AppendSwitchASCII(::switches::kDisableBlinkFeatures, s);
+  if (parsed_.disable_blink_features)
+    command_line->AppendSwitchASCII(::switches::kDisableBlinkFeatures,
+                                    *parsed_.disable_blink_features);
 
-  if (IsEnabled(options::kNodeIntegrationInWorker))
+  if (parsed_.node_integration_in_worker)
     command_line->AppendSwitch(switches::kNodeIntegrationInWorker);
 
   // We are appending args to a webContents so let's save the current state
   // of our preferences object so that during the lifetime of the WebContents
   // we can fetch the options used to initally configure the WebContents
-  last_preference_ = preference_.Clone();
+  if (!is_spare)
+    last_preference_ = preference_.Clone();
 }
 
 void WebContentsPreferences::OverrideWebkitPrefs(
     blink::web_pref::WebPreferences* prefs) {
-  prefs->javascript_enabled =
-      IsEnabled(options::kJavaScript, true /* default_value */);
-  prefs->images_enabled = IsEnabled(options::kImages, true /* default_value */);
-  prefs->text_areas_are_resizable =
-      IsEnabled(options::kTextAreasAreResizable, true /* default_value */);
-  prefs->navigate_on_drag_drop =
-      IsEnabled(options::kNavigateOnDragDrop, false /* default_value */);
-  if (!GetAsAutoplayPolicy(&preference_, "autoplayPolicy",
-                           &prefs->autoplay_policy)) {
-    prefs->autoplay_policy =
-        blink::mojom::AutoplayPolicy::kNoUserGestureRequired;
-  }
+  prefs->javascript_enabled = parsed_.javascript;
+  prefs->images_enabled = parsed_.images;
+  prefs->text_areas_are_resizable = parsed_.text_areas_are_resizable;
+  prefs->navigate_on_drag_drop = parsed_.navigate_on_drag_drop;
+  prefs->autoplay_policy = parsed_.autoplay_policy;
 
   // Check if webgl should be enabled.
-  bool is_webgl_enabled = IsEnabled(options::kWebGL, true /* default_value */);
-  prefs->webgl1_enabled = is_webgl_enabled;
-  prefs->webgl2_enabled = is_webgl_enabled;
+  prefs->webgl1_enabled = parsed_.webgl;
+  prefs->webgl2_enabled = parsed_.webgl;
 
   // Check if web security should be enabled.
-  bool is_web_security_enabled =
-      IsEnabled(options::kWebSecurity, true /* default_value */);
-  prefs->web_security_enabled = is_web_security_enabled;
+  prefs->web_security_enabled = parsed_.web_security;
   prefs->allow_running_insecure_content =
-      IsEnabled(options::kAllowRunningInsecureContent,
-                !is_web_security_enabled /* default_value */);
-
-  auto* fonts_dict = preference_.FindKeyOfType("defaultFontFamily",
-                                               base::Value::Type::DICTIONARY);
-  if (fonts_dict) {
-    std::u16string font;
-    if (GetAsString(fonts_dict, "standard", &font))
-      prefs->standard_font_family_map[blink::web_pref::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "serif", &font))
-      prefs->serif_font_family_map[blink::web_pref::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "sansSerif", &font))
-      prefs->sans_serif_font_family_map[blink::web_pref::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "monospace", &font))
-      prefs->fixed_font_family_map[blink::web_pref::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "cursive", &font))
-      prefs->cursive_font_family_map[blink::web_pref::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "fantasy", &font))
-      prefs->fantasy_font_family_map[blink::web_pref::kCommonScript] = font;
-  }
-
-  int size;
-  if (GetAsInteger(&preference_, "defaultFontSize", &size))
-    prefs->default_font_size = size;
-  if (GetAsInteger(&preference_, "defaultMonospaceFontSize", &size))
-    prefs->default_fixed_font_size = size;
-  if (GetAsInteger(&preference_, "minimumFontSize", &size))
-    prefs->minimum_font_size = size;
-  std::string encoding;
-  if (GetAsString(&preference_, "defaultEncoding", &encoding))
-    prefs->default_encoding = encoding;
+      parsed_.allow_running_insecure_content;
+
+  if (parsed_.standard_font_family)
+    prefs->standard_font_family_map[blink::web_pref::kCommonScript] =
+        *parsed_.standard_font_family;
+  if (parsed_.serif_font_family)
+    prefs->serif_font_family_map[blink::web_pref::kCommonScript] =
+        *parsed_.serif_font_family;
+  if (parsed_.sans_serif_font_family)
+    prefs->sans_serif_font_family_map[blink::web_pref::kCommonScript] =
+        *parsed_.sans_serif_font_family;
+  if (parsed_.monospace_font_family)
+    prefs->fixed_font_family_map[blink::web_pref::kCommonScript] =
+        *parsed_.monospace_font_family;
+  if (parsed_.cursive_font_family)
+    prefs->cursive_font_family_map[blink::web_pref::kCommonScript] =
+        *parsed_.cursive_font_family;
+  if (parsed_.fantasy_font_family)
+    prefs->fantasy_font_family_map[blink::web_pref::kCommonScript] =
+        *parsed_.fantasy_font_family;
+
+  if (parsed_.default_font_size)
+    prefs->default_font_size = *parsed_.default_font_size;
+  if (parsed_.default_monospace_font_size)
+    prefs->default_fixed_font_size = *parsed_.default_monospace_font_size;
+  if (parsed_.minimum_font_size)
+    prefs->minimum_font_size = *parsed_.minimum_font_size;
+  if (parsed_.default_encoding)
+    prefs->default_encoding = *parsed_.default_encoding;
 
   // --background-color.
-  std::string color;
-  if (GetAsString(&preference_, options::kBackgroundColor, &color)) {
-    prefs->background_color = color;
-  } else if (!IsEnabled(options::kOffscreen)) {
+  if (parsed_.background_color) {
+    prefs->background_color = *parsed_.background_color;
+  } else if (!parsed_.offscreen) {
     prefs->background_color = "#fff";
   }
 
   // Pass the opener's window id.
-  int opener_id;
-  if (GetAsInteger(&preference_, options::kOpenerID, &opener_id))
-    prefs->opener_id = opener_id;
+  if (parsed_.opener_id)
+    prefs->opener_id = *parsed_.opener_id;
 
   // Run Electron APIs and preload script in isolated world
-  prefs->context_isolation = IsEnabled(options::kContextIsolation, true);
+  prefs->context_isolation = parsed_.context_isolation;
 
-  int guest_instance_id = 0;
-  if (GetAsInteger(&preference_, options::kGuestInstanceID, &guest_instance_id))
+  int guest_instance_id = parsed_.guest_instance_id.value_or(0);
+  if (parsed_.guest_instance_id)
     prefs->guest_instance_id = guest_instance_id;
 
   prefs->hidden_page = false;
@@ -468,53 +607,38 @@ void WebContentsPreferences::OverrideWebkitPrefs(
     }
   }
 
-  prefs->offscreen = IsEnabled(options::kOffscreen);
+  prefs->offscreen = parsed_.offscreen;
 
   // The preload script.
   GetPreloadPath(&prefs->preload);
 
   // Check if nativeWindowOpen is enabled.
-  prefs->native_window_open = IsEnabled(options::kNativeWindowOpen);
+  prefs->native_window_open = parsed_.native_window_open;
 
   // Check if we have node integration specified.
-  prefs->node_integration = IsEnabled(options::kNodeIntegration);
+  prefs->node_integration = parsed_.node_integration;
 
   // Whether to enable node integration in Worker.
-  prefs->node_integration_in_worker =
-      IsEnabled(options::kNodeIntegrationInWorker);
+  prefs->node_integration_in_worker = parsed_.node_integration_in_worker;
 
   prefs->node_integration_in_sub_frames =
-      IsEnabled(options::kNodeIntegrationInSubFrames);
+      parsed_.node_integration_in_sub_frames;
 
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
-  prefs->enable_spellcheck = IsEnabled(options::kSpellcheck);
+  prefs->enable_spellcheck = parsed_.spellcheck;
 #endif
 
   // Check if plugins are enabled.
-  prefs->enable_plugins = IsEnabled(options::kPlugins);
+  prefs->enable_plugins = parsed_.plugins;
 
   // Check if webview tag creation is enabled, default to nodeIntegration value.
-  prefs->webview_tag = IsEnabled(options::kWebviewTag);
+  prefs->webview_tag = parsed_.webview_tag;
 
   // Whether to allow the WebSQL api
-  prefs->enable_websql = IsEnabled(options::kEnableWebSQL);
-
-  std::string v8_cache_options;
-  if (GetAsString(&preference_, "v8CacheOptions", &v8_cache_options)) {
-    if (v8_cache_options == "none") {
-      prefs->v8_cache_options = blink::mojom::V8CacheOptions::kNone;
-    } else if (v8_cache_options == "code") {
-      prefs->v8_cache_options = blink::mojom::V8CacheOptions::kCode;
-    } else if (v8_cache_options == "bypassHeatCheck") {
-      prefs->v8_cache_options =
-          blink::mojom::V8CacheOptions::kCodeWithoutHeatCheck;
-    } else if (v8_cache_options == "bypassHeatCheckAndEagerCompile") {
-      prefs->v8_cache_options =
-          blink::mojom::V8CacheOptions::kFullCodeWithoutHeatCheck;
-    } else {
-      prefs->v8_cache_options = blink::mojom::V8CacheOptions::kDefault;
-    }
-  }
+  prefs->enable_websql = parsed_.enable_websql;
+
+  if (parsed_.v8_cache_options)
+    prefs->v8_cache_options = *parsed_.v8_cache_options;
 }
 
 WEB_CONTENTS_USER_DATA_KEY_IMPL(WebContentsPreferences)
@@ -6,10 +6,16 @@
 #define SHELL_BROWSER_WEB_CONTENTS_PREFERENCES_H_
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "base/files/file_path.h"
+#include "base/optional.h"
 #include "base/values.h"
 #include "content/public/browser/web_contents_user_data.h"
+#include "electron/buildflags/buildflags.h"
+#include "third_party/blink/public/mojom/v8_cache_options.mojom.h"
+#include "third_party/blink/public/mojom/webpreferences/web_preferences.mojom.h"
 
 namespace base {
 class CommandLine;
@@ -29,6 +35,66 @@ namespace electron {
 class WebContentsPreferences
     : public content::WebContentsUserData<WebContentsPreferences> {
  public:
+  // Typed view of |preference_|, rebuilt whenever the preferences change so
+  // that hot paths do not need string-keyed lookups.
+  struct ParsedPreferences {
+    ParsedPreferences();
+    ParsedPreferences(const ParsedPreferences&);
+    ~ParsedPreferences();
+
+    bool allow_running_insecure_content = false;
+    bool context_isolation = true;
+    bool disable_popups = false;
+    bool enable_websql = false;
+    bool experimental_features = false;
+    bool images = true;
+    bool javascript = true;
+    bool native_window_open = false;
+    bool navigate_on_drag_drop = false;
+    bool node_integration = false;
+    bool node_integration_in_sub_frames = false;
+    bool node_integration_in_worker = false;
+    bool offscreen = false;
+    bool plugins = false;
+    bool sandbox = false;
+#if defined(OS_MAC)
+    bool scroll_bounce = false;
+#endif
+#if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
+    bool spellcheck = false;
+#endif
+    bool text_areas_are_resizable = true;
+    bool web_security = true;
+    bool webgl = true;
+    bool webview_tag = false;
+
+    blink::mojom::AutoplayPolicy autoplay_policy =
+        blink::mojom::AutoplayPolicy::kNoUserGestureRequired;
+    base::Optional<blink::mojom::V8CacheOptions> v8_cache_options;
+
+    base::Optional<std::string> background_color;
+    base::Optional<std::string> default_encoding;
+    base::Optional<std::string> disable_blink_features;
+    base::Optional<std::string> enable_blink_features;
+
+    base::Optional<std::u16string> standard_font_family;
+    base::Optional<std::u16string> serif_font_family;
+    base::Optional<std::u16string> sans_serif_font_family;
+    base::Optional<std::u16string> monospace_font_family;
+    base::Optional<std::u16string> cursive_font_family;
+    base::Optional<std::u16string> fantasy_font_family;
+
+    base::Optional<int> default_font_size;
+    base::Optional<int> default_monospace_font_size;
+    base::Optional<int> minimum_font_size;
+    base::Optional<int> guest_instance_id;
+    base::Optional<int> opener_id;
+
+    base::Optional<base::FilePath> preload_path;
+    std::vector<std::string> command_line_switches;
+    std::vector<std::string> custom_args;
+  };
+
   // Get self from WebContents.
   static WebContentsPreferences* From(content::WebContents* web_contents);
 
@@ -45,9 +111,12 @@ class WebContentsPreferences
   // $.extend(|web_preferences|, |new_web_preferences|).
   void Merge(const base::DictionaryValue& new_web_preferences);
 
-  // Append command paramters according to preferences.
+  // Append command paramters according to preferences. |is_spare| is set
+  // when the switches are for a spare renderer launched on behalf of another
+  // page, which must not change what this page was started with.
   void AppendCommandLineSwitches(base::CommandLine* command_line,
-                                 bool is_subframe);
+                                 bool is_subframe,
+                                 bool is_spare);
 
   // Modify the WebPreferences according to preferences.
   void OverrideWebkitPrefs(blink::web_pref::WebPreferences* prefs);
@@ -58,12 +127,21 @@ class WebContentsPreferences
   // Return true if the particular preference value exists.
   bool GetPreference(base::StringPiece name, std::string* value) const;
 
+  // Sets a single preference value.
+  void SetPreference(base::StringPiece name, base::Value value);
+
   // Returns the preload script path.
   bool GetPreloadPath(base::FilePath* path) const;
 
+  // Whether the pages of both webContents can be hosted by the same renderer,
+  // which requires the renderer to be launched and set up the same way.
+  // <webview> guests are never compatible.
+  bool IsRendererCompatibleWith(const WebContentsPreferences& other) const;
+
   // Returns the web preferences.
-  base::Value* preference() { return &preference_; }
-  base::Value* last_preference() { return &last_preference_; }
+  const base::Value* preference() const { return &preference_; }
+  const base::Value* last_preference() const { return &last_preference_; }
+  const ParsedPreferences& parsed() const { return parsed_; }
 
  private:
   friend class content::WebContentsUserData<WebContentsPreferences>;
@@ -81,13 +159,22 @@ class WebContentsPreferences
   // Set preference value to given bool
   void SetBool(base::StringPiece key, bool value);
 
+  // Rebuild |parsed_| from |preference_|.
+  void ParsePreferences();
+
   static std::vector<WebContentsPreferences*> instances_;
 
+  // Caches the owner of each main frame process id. Entries are validated on
+  // lookup since the main frame can move to another process.
+  static std::unordered_map<int, WebContentsPreferences*> process_index_;
+
   content::WebContents* web_contents_;
 
   base::Value preference_ = base::Value(base::Value::Type::DICTIONARY);
   base::Value last_preference_ = base::Value(base::Value::Type::DICTIONARY);
 
+  ParsedPreferences parsed_;
+
   WEB_CONTENTS_USER_DATA_KEY_DECL();
 
   DISALLOW_COPY_AND_ASSIGN(WebContentsPreferences);
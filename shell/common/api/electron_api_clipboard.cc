@@ -4,20 +4,60 @@
 
 #include "shell/common/api/electron_api_clipboard.h"
 
+#include <utility>
+
+#include "base/memory/ref_counted_memory.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "shell/common/gin_converters/image_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixmap.h"
 #include "ui/base/clipboard/clipboard_format_type.h"
 #include "ui/base/clipboard/scoped_clipboard_writer.h"
+#include "ui/gfx/codec/png_codec.h"
 
 namespace electron {
 
 namespace api {
 
+namespace {
+
+scoped_refptr<base::RefCountedMemory> EncodeBitmapToPNG(
+    const SkBitmap& bitmap) {
+  auto png = base::MakeRefCounted<base::RefCountedBytes>();
+  if (!gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &png->data()))
+    return nullptr;
+  return png;
+}
+
+void ResolveImageFromPNG(gin_helper::Promise<gfx::Image> promise,
+                         scoped_refptr<base::RefCountedMemory> png) {
+  // The image keeps the encoded representation, so toPNG() and toDataURL()
+  // do not need to decode it again.
+  promise.Resolve(png ? gfx::Image::CreateFrom1xPNGBytes(png) : gfx::Image());
+}
+
+void OnReadImage(gin_helper::Promise<gfx::Image> promise,
+                 const SkBitmap& bitmap) {
+  if (bitmap.drawsNothing()) {
+    promise.Resolve(gfx::Image());
+    return;
+  }
+
+  SkBitmap copy = bitmap;
+  copy.setImmutable();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&EncodeBitmapToPNG, std::move(copy)),
+      base::BindOnce(&ResolveImageFromPNG, std::move(promise)));
+}
+
+}  // namespace
+
 ui::ClipboardBuffer Clipboard::GetClipboardBuffer(gin_helper::Arguments* args) {
   std::string type;
   if (args->GetNext(&type) && type == "selection")
@@ -194,6 +234,26 @@ gfx::Image Clipboard::ReadImage(gin_helper::Arguments* args) {
   return image.value();
 }
 
+v8::Local<v8::Promise> Clipboard::ReadTextAsync(gin_helper::Arguments* args) {
+  return gin_helper::Promise<std::u16string>::ResolvedPromise(args->isolate(),
+                                                              ReadText(args));
+}
+
+v8::Local<v8::Promise> Clipboard::ReadHTMLAsync(gin_helper::Arguments* args) {
+  return gin_helper::Promise<std::u16string>::ResolvedPromise(args->isolate(),
+                                                              ReadHTML(args));
+}
+
+v8::Local<v8::Promise> Clipboard::ReadImageAsync(gin_helper::Arguments* args) {
+  gin_helper::Promise<gfx::Image> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  clipboard->ReadImage(GetClipboardBuffer(args), /* data_dst = */ nullptr,
+                       base::BindOnce(&OnReadImage, std::move(promise)));
+  return handle;
+}
+
 void Clipboard::WriteImage(const gfx::Image& image,
                            gin_helper::Arguments* args) {
   ui::ScopedClipboardWriter writer(GetClipboardBuffer(args));
@@ -243,6 +303,9 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("writeBookmark", &electron::api::Clipboard::WriteBookmark);
   dict.SetMethod("readImage", &electron::api::Clipboard::ReadImage);
   dict.SetMethod("writeImage", &electron::api::Clipboard::WriteImage);
+  dict.SetMethod("readTextAsync", &electron::api::Clipboard::ReadTextAsync);
+  dict.SetMethod("readHTMLAsync", &electron::api::Clipboard::ReadHTMLAsync);
+  dict.SetMethod("readImageAsync", &electron::api::Clipboard::ReadImageAsync);
   dict.SetMethod("readFindText", &electron::api::Clipboard::ReadFindText);
   dict.SetMethod("writeFindText", &electron::api::Clipboard::WriteFindText);
   dict.SetMethod("readBuffer", &electron::api::Clipboard::ReadBuffer);
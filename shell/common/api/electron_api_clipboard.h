@@ -53,6 +53,14 @@ class Clipboard {
   static gfx::Image ReadImage(gin_helper::Arguments* args);
   static void WriteImage(const gfx::Image& image, gin_helper::Arguments* args);
 
+  // Promise-returning variants of the readers above. ui::Clipboard can only
+  // be read on the thread it belongs to, so the text and HTML readers only
+  // change the shape of the API. The image reader encodes the image as PNG on
+  // a background sequence.
+  static v8::Local<v8::Promise> ReadTextAsync(gin_helper::Arguments* args);
+  static v8::Local<v8::Promise> ReadHTMLAsync(gin_helper::Arguments* args);
+  static v8::Local<v8::Promise> ReadImageAsync(gin_helper::Arguments* args);
+
   static std::u16string ReadFindText();
   static void WriteFindText(const std::u16string& text);
 
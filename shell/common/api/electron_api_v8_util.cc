@@ -5,6 +5,7 @@
 #include <string>
 #include <utility>
 
+#include "base/environment.h"
 #include "base/hash/hash.h"
 #include "electron/buildflags/buildflags.h"
 #include "shell/common/api/electron_api_key_weak_map.h"
@@ -12,6 +13,7 @@
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/js2c_bundles.h"
 #include "shell/common/node_includes.h"
 #include "url/origin.h"
 #include "v8/include/v8-profiler.h"
@@ -103,6 +105,35 @@ void RequestGarbageCollectionForTesting(v8::Isolate* isolate) {
       v8::Isolate::GarbageCollectionType::kFullGarbageCollection);
 }
 
+// Counts the compilations of Electron's bundles in the current Environment
+// that were given the embedded code cache, by whether V8 accepted it. Node
+// only records this per Environment, so bundles that are compiled without one,
+// like the sandboxed renderer's, are not counted.
+v8::Local<v8::Value> GetBuiltinCodeCacheStats(v8::Isolate* isolate) {
+  size_t accepted = 0;
+  size_t rejected = 0;
+#if BUILDFLAG(USE_BUILTIN_CODE_CACHE)
+  node::Environment* env = node::Environment::GetCurrent(isolate);
+  auto variables = base::Environment::Create();
+  if (env && !variables->HasVar("ELECTRON_DISABLE_BUILTIN_CODE_CACHE")) {
+    // Every bundle has an embedded cache, so one that was compiled without a
+    // cache had it rejected.
+    for (const auto& id : env->native_modules_with_cache) {
+      if (electron::FindJs2cBundle(id.c_str()))
+        accepted++;
+    }
+    for (const auto& id : env->native_modules_without_cache) {
+      if (electron::FindJs2cBundle(id.c_str()))
+        rejected++;
+    }
+  }
+#endif
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("accepted", static_cast<uint32_t>(accepted));
+  dict.Set("rejected", static_cast<uint32_t>(rejected));
+  return dict.GetHandle();
+}
+
 bool IsSameOrigin(const GURL& l, const GURL& r) {
   return url::Origin::Create(l).IsSameOriginWith(url::Origin::Create(r));
 }
@@ -157,6 +188,7 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("requestGarbageCollectionForTesting",
                  &RequestGarbageCollectionForTesting);
   dict.SetMethod("isSameOrigin", &IsSameOrigin);
+  dict.SetMethod("getBuiltinCodeCacheStats", &GetBuiltinCodeCacheStats);
 #ifdef DCHECK_IS_ON
   dict.SetMethod("triggerFatalErrorForTesting", &TriggerFatalErrorForTesting);
   dict.SetMethod("getWeaklyTrackedValues", &GetWeaklyTrackedValues);
@@ -9,6 +9,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/allocator/partition_allocator/partition_stats.h"
 #include "base/logging.h"
 #include "base/process/process.h"
 #include "base/process/process_handle.h"
@@ -20,6 +21,7 @@
 #include "services/resource_coordinator/public/cpp/memory_instrumentation/global_memory_dump.h"
 #include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
 #include "shell/browser/browser.h"
+#include "shell/browser/javascript_environment.h"
 #include "shell/common/application_info.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -28,10 +30,83 @@
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/heap_snapshot.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/sampling_profiler.h"
 #include "third_party/blink/renderer/platform/heap/process_heap.h"  // nogncheck
 
 namespace electron {
 
+namespace {
+
+class ArrayBufferAllocatorStatsDumper : public base::PartitionStatsDumper {
+ public:
+  explicit ArrayBufferAllocatorStatsDumper(v8::Isolate* isolate)
+      : isolate_(isolate), dict_(gin::Dictionary::CreateEmpty(isolate)) {}
+
+  v8::Local<v8::Value> GetHandle() {
+    dict_.Set("buckets", buckets_);
+    return dict_.GetHandle();
+  }
+
+  // base::PartitionStatsDumper:
+  void PartitionDumpTotals(const char* partition_name,
+                           const base::PartitionMemoryStats* stats) override {
+    dict_.Set("committed", static_cast<double>(stats->total_committed_bytes));
+    dict_.Set("maxCommitted", static_cast<double>(stats->max_committed_bytes));
+    dict_.Set("resident", static_cast<double>(stats->total_resident_bytes));
+    dict_.Set("active", static_cast<double>(stats->total_active_bytes));
+    dict_.Set("decommittable",
+              static_cast<double>(stats->total_decommittable_bytes));
+    dict_.Set("discardable",
+              static_cast<double>(stats->total_discardable_bytes));
+    // The share of the provisioned memory that isn't handed out to
+    // ArrayBuffers, like Chromium's partition_alloc memory dumps report it.
+    double fragmentation = 0;
+    if (stats->total_resident_bytes) {
+      fragmentation = 1 - static_cast<double>(stats->total_active_bytes) /
+                              stats->total_resident_bytes;
+    }
+    dict_.Set("fragmentation", fragmentation);
+    dict_.Set("threadCacheEnabled", stats->has_thread_cache);
+
+    if (stats->has_thread_cache) {
+      const auto& cache_stats = stats->all_thread_caches_stats;
+      gin_helper::Dictionary thread_cache =
+          gin::Dictionary::CreateEmpty(isolate_);
+      thread_cache.Set("allocCount",
+                       static_cast<double>(cache_stats.alloc_count));
+      thread_cache.Set("allocHits",
+                       static_cast<double>(cache_stats.alloc_hits));
+      thread_cache.Set("allocMisses",
+                       static_cast<double>(cache_stats.alloc_misses));
+      dict_.Set("threadCache", thread_cache);
+    }
+  }
+
+  void PartitionsDumpBucketStats(
+      const char* partition_name,
+      const base::PartitionBucketMemoryStats* stats) override {
+    if (!stats->is_valid || !stats->resident_bytes)
+      return;
+    gin_helper::Dictionary bucket = gin::Dictionary::CreateEmpty(isolate_);
+    bucket.Set("slotSize", stats->bucket_slot_size);
+    bucket.Set("directMap", stats->is_direct_map);
+    bucket.Set("count", stats->active_bytes / stats->bucket_slot_size);
+    bucket.Set("active", stats->active_bytes);
+    bucket.Set("resident", stats->resident_bytes);
+    bucket.Set("discardable", stats->discardable_bytes);
+    buckets_.push_back(bucket);
+  }
+
+ private:
+  v8::Isolate* isolate_;
+  gin_helper::Dictionary dict_;
+  std::vector<gin_helper::Dictionary> buckets_;
+
+  DISALLOW_COPY_AND_ASSIGN(ArrayBufferAllocatorStatsDumper);
+};
+
+}  // namespace
+
 ElectronBindings::ElectronBindings(uv_loop_t* loop) {
   uv_async_init(loop, call_next_tick_async_.get(), OnCallNextTick);
   call_next_tick_async_.get()->data = this;
@@ -55,6 +130,10 @@ void ElectronBindings::BindProcess(v8::Isolate* isolate,
   process->SetMethod("getSystemVersion",
                      &base::SysInfo::OperatingSystemVersion);
   process->SetMethod("getIOCounters", &GetIOCounters);
+  process->SetMethod("startSamplingHeapProfiler", &StartSamplingHeapProfiler);
+  process->SetMethod("stopSamplingHeapProfiler", &StopSamplingHeapProfiler);
+  process->SetMethod("startCpuProfile", &StartCpuProfile);
+  process->SetMethod("stopCpuProfile", &StopCpuProfile);
   process->SetMethod("getCPUUsage",
                      base::BindRepeating(&ElectronBindings::GetCPUUsage,
                                          base::Unretained(metrics)));
@@ -81,6 +160,11 @@ void ElectronBindings::BindTo(v8::Isolate* isolate,
   dict.SetMethod("activateUvLoop",
                  base::BindRepeating(&ElectronBindings::ActivateUVLoop,
                                      base::Unretained(this)));
+  // Renderers allocate ArrayBuffers from Blink's partitions.
+  if (gin_helper::Locker::IsBrowserProcess()) {
+    dict.SetMethod("getArrayBufferAllocatorStats",
+                   &GetArrayBufferAllocatorStats);
+  }
 
   gin_helper::Dictionary versions;
   if (dict.Get("versions", &versions)) {
@@ -299,6 +383,14 @@ v8::Local<v8::Value> ElectronBindings::GetCPUUsage(
   return dict.GetHandle();
 }
 
+// static
+v8::Local<v8::Value> ElectronBindings::GetArrayBufferAllocatorStats(
+    v8::Isolate* isolate) {
+  ArrayBufferAllocatorStatsDumper dumper(isolate);
+  JavascriptEnvironment::DumpArrayBufferAllocatorStats(&dumper);
+  return dumper.GetHandle();
+}
+
 // static
 v8::Local<v8::Value> ElectronBindings::GetIOCounters(v8::Isolate* isolate) {
   auto metrics = base::ProcessMetrics::CreateCurrentProcessMetrics();
@@ -320,13 +412,88 @@ v8::Local<v8::Value> ElectronBindings::GetIOCounters(v8::Isolate* isolate) {
 
 // static
 bool ElectronBindings::TakeHeapSnapshot(v8::Isolate* isolate,
-                                        const base::FilePath& file_path) {
+                                        const base::FilePath& file_path,
+                                        gin_helper::Arguments* args) {
+  HeapSnapshotOptions options;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    std::string compression;
+    if (dict.Get("compression", &compression)) {
+      if (compression == "gzip") {
+        options.gzip = true;
+      } else if (compression != "none") {
+        args->ThrowError("Unsupported compression: " + compression);
+        return false;
+      }
+    }
+  }
+
   base::ThreadRestrictions::ScopedAllowIO allow_io;
 
   base::File file(file_path,
                   base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
 
-  return electron::TakeHeapSnapshot(isolate, &file);
+  return electron::TakeHeapSnapshot(isolate, std::move(file), options);
+}
+
+// static
+void ElectronBindings::StartSamplingHeapProfiler(
+    gin_helper::ErrorThrower thrower,
+    gin_helper::Arguments* args) {
+  uint64_t sampling_interval = kDefaultHeapSamplingInterval;
+  int stack_depth = kDefaultHeapSamplingStackDepth;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("samplingInterval", &sampling_interval);
+    options.Get("stackDepth", &stack_depth);
+  }
+  if (sampling_interval == 0 || stack_depth <= 0) {
+    thrower.ThrowRangeError(
+        "samplingInterval and stackDepth must be greater than 0");
+    return;
+  }
+  if (!electron::StartSamplingHeapProfiler(thrower.isolate(),
+                                           sampling_interval, stack_depth)) {
+    thrower.ThrowError("The sampling heap profiler is already running");
+  }
+}
+
+// static
+std::string ElectronBindings::StopSamplingHeapProfiler(
+    gin_helper::ErrorThrower thrower) {
+  base::Optional<std::string> profile =
+      electron::StopSamplingHeapProfiler(thrower.isolate());
+  if (!profile) {
+    thrower.ThrowError("The sampling heap profiler is not running");
+    return std::string();
+  }
+  return std::move(*profile);
+}
+
+// static
+void ElectronBindings::StartCpuProfile(gin_helper::ErrorThrower thrower,
+                                       gin_helper::Arguments* args) {
+  int sampling_interval = kDefaultCpuSamplingInterval;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("samplingInterval", &sampling_interval);
+  if (sampling_interval <= 0) {
+    thrower.ThrowRangeError("samplingInterval must be greater than 0");
+    return;
+  }
+  if (!electron::StartCpuProfile(thrower.isolate(), sampling_interval))
+    thrower.ThrowError("A CPU profile is already being recorded");
+}
+
+// static
+std::string ElectronBindings::StopCpuProfile(gin_helper::ErrorThrower thrower) {
+  base::Optional<std::string> profile =
+      electron::StopCpuProfile(thrower.isolate());
+  if (!profile) {
+    thrower.ThrowError("No CPU profile is being recorded");
+    return std::string();
+  }
+  return std::move(*profile);
 }
 
 }  // namespace electron
@@ -7,11 +7,13 @@
 
 #include <list>
 #include <memory>
+#include <string>
 
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/process/process_metrics.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_bindings.h"
 #include "uv.h"  // NOLINT(build/include_directory)
@@ -60,8 +62,18 @@ class ElectronBindings {
   static v8::Local<v8::Value> GetCPUUsage(base::ProcessMetrics* metrics,
                                           v8::Isolate* isolate);
   static v8::Local<v8::Value> GetIOCounters(v8::Isolate* isolate);
+  static v8::Local<v8::Value> GetArrayBufferAllocatorStats(
+      v8::Isolate* isolate);
   static bool TakeHeapSnapshot(v8::Isolate* isolate,
-                               const base::FilePath& file_path);
+                               const base::FilePath& file_path,
+                               gin_helper::Arguments* args);
+  static void StartSamplingHeapProfiler(gin_helper::ErrorThrower thrower,
+                                        gin_helper::Arguments* args);
+  static std::string StopSamplingHeapProfiler(
+      gin_helper::ErrorThrower thrower);
+  static void StartCpuProfile(gin_helper::ErrorThrower thrower,
+                              gin_helper::Arguments* args);
+  static std::string StopCpuProfile(gin_helper::ErrorThrower thrower);
 
   void ActivateUVLoop(v8::Isolate* isolate);
 
@@ -2,6 +2,7 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include "base/allocator/buildflags.h"
 #include "electron/buildflags/buildflags.h"
 #include "electron/fuses.h"
 #include "printing/buildflags/buildflags.h"
@@ -58,6 +59,10 @@ bool IsWinDarkModeWindowUiEnabled() {
   return BUILDFLAG(ENABLE_WIN_DARK_MODE_WINDOW_UI);
 }
 
+bool IsPartitionAllocAsMallocEnabled() {
+  return BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC);
+}
+
 bool IsComponentBuild() {
 #if defined(COMPONENT_BUILD)
   return true;
@@ -85,6 +90,8 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("isComponentBuild", &IsComponentBuild);
   dict.SetMethod("isExtensionsEnabled", &IsExtensionsEnabled);
   dict.SetMethod("isWinDarkModeWindowUiEnabled", &IsWinDarkModeWindowUiEnabled);
+  dict.SetMethod("isPartitionAllocAsMallocEnabled",
+                 &IsPartitionAllocAsMallocEnabled);
 }
 
 }  // namespace
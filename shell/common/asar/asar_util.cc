@@ -13,6 +13,7 @@
 #include "base/stl_util.h"
 #include "base/threading/thread_local.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/trace_event/trace_event.h"
 #include "shell/common/asar/archive.h"
 
 namespace asar {
@@ -46,10 +47,15 @@ std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path) {
 
   // if we have it, return it
   const auto lower = map.lower_bound(path);
-  if (lower != std::end(map) && !map.key_comp()(path, lower->first))
+  if (lower != std::end(map) && !map.key_comp()(path, lower->first)) {
+    TRACE_EVENT_INSTANT1("electron.asar", "ArchiveCacheHit",
+                         TRACE_EVENT_SCOPE_THREAD, "path", path.AsUTF8Unsafe());
     return lower->second;
+  }
 
   // if we can create it, return it
+  TRACE_EVENT1("electron.asar", "ArchiveCacheMiss", "path",
+               path.AsUTF8Unsafe());
   auto archive = std::make_shared<Archive>(path);
   if (archive->Init()) {
     base::TryEmplace(map, lower, path, archive);
@@ -90,6 +96,8 @@ bool GetAsarArchivePath(const base::FilePath& full_path,
 }
 
 bool ReadFileToString(const base::FilePath& path, std::string* contents) {
+  TRACE_EVENT1("electron.asar", "ReadFileToString", "path",
+               path.AsUTF8Unsafe());
   base::FilePath asar_path, relative_path;
   if (!GetAsarArchivePath(path, &asar_path, &relative_path))
     return base::ReadFileToString(path, contents);
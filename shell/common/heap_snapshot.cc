@@ -4,53 +4,471 @@
 
 #include "shell/common/heap_snapshot.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/containers/circular_deque.h"
+#include "base/containers/span.h"
+#include "base/memory/ref_counted.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/task/thread_pool.h"
+#include "mojo/public/cpp/system/data_pipe_producer.h"
+#include "mojo/public/cpp/system/string_data_source.h"
+#include "third_party/zlib/zlib.h"
 #include "v8/include/v8-profiler.h"
 
 namespace {
 
+// V8 hands out small chunks, coalesce them before passing them on.
+constexpr size_t kBufferSize = 1024 * 1024;
+
+// Serialization pauses once this much output is waiting to be written, which
+// bounds the memory used when compression or the destination can't keep up.
+constexpr size_t kMaxQueuedBytes = 16 * kBufferSize;
+
+constexpr size_t kGzipOutputSize = 64 * 1024;
+
+using SinkCallback = base::OnceCallback<void(bool success)>;
+
+// The destination of the serialized snapshot. |callback| runs once the data
+// has been handed on, which is right away unless the destination is full.
+class Sink {
+ public:
+  virtual ~Sink() = default;
+
+  virtual void Write(std::string data, SinkCallback callback) = 0;
+  virtual void Finish(SinkCallback callback) { std::move(callback).Run(true); }
+};
+
+class FileSink : public Sink {
+ public:
+  explicit FileSink(base::File file) : file_(std::move(file)) {}
+
+  void Write(std::string data, SinkCallback callback) override {
+    std::move(callback).Run(
+        file_.WriteAtCurrentPos(data.data(), data.size()) ==
+        static_cast<int>(data.size()));
+  }
+
+ private:
+  base::File file_;
+};
+
+// Writes to the pipe as the consumer makes room, without blocking the
+// sequence it runs on.
+class DataPipeSink : public Sink {
+ public:
+  explicit DataPipeSink(mojo::ScopedDataPipeProducerHandle producer)
+      : producer_(std::make_unique<mojo::DataPipeProducer>(
+            std::move(producer))) {}
+
+  void Write(std::string data, SinkCallback callback) override {
+    if (data.empty()) {
+      std::move(callback).Run(true);
+      return;
+    }
+    producer_->Write(
+        std::make_unique<mojo::StringDataSource>(
+            base::make_span(data), mojo::StringDataSource::AsyncWritingMode::
+                                       STRING_MAY_BE_INVALIDATED_BEFORE_COMPLETION),
+        base::BindOnce(
+            [](SinkCallback callback, MojoResult result) {
+              std::move(callback).Run(result == MOJO_RESULT_OK);
+            },
+            std::move(callback)));
+  }
+
+ private:
+  std::unique_ptr<mojo::DataPipeProducer> producer_;
+};
+
+class GzipSink : public Sink {
+ public:
+  explicit GzipSink(std::unique_ptr<Sink> next)
+      : next_(std::move(next)), output_(kGzipOutputSize, '\0') {
+    // Adding 16 to the window bits selects the gzip format.
+    initialized_ = deflateInit2(&stream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                                MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+  }
+
+  ~GzipSink() override {
+    if (initialized_)
+      deflateEnd(&stream_);
+  }
+
+  void Write(std::string data, SinkCallback callback) override {
+    std::string compressed;
+    if (!Deflate(data, Z_NO_FLUSH, &compressed)) {
+      std::move(callback).Run(false);
+      return;
+    }
+    next_->Write(std::move(compressed), std::move(callback));
+  }
+
+  void Finish(SinkCallback callback) override {
+    std::string compressed;
+    if (!Deflate(base::StringPiece(), Z_FINISH, &compressed)) {
+      std::move(callback).Run(false);
+      return;
+    }
+    next_->Write(std::move(compressed),
+                 base::BindOnce(&GzipSink::OnTrailerWritten,
+                                base::Unretained(this), std::move(callback)));
+  }
+
+ private:
+  void OnTrailerWritten(SinkCallback callback, bool success) {
+    if (!success) {
+      std::move(callback).Run(false);
+      return;
+    }
+    next_->Finish(std::move(callback));
+  }
+
+  bool Deflate(base::StringPiece data, int flush, std::string* compressed) {
+    if (!initialized_)
+      return false;
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream_.avail_in = data.size();
+    do {
+      stream_.next_out = reinterpret_cast<Bytef*>(&output_[0]);
+      stream_.avail_out = output_.size();
+      if (deflate(&stream_, flush) == Z_STREAM_ERROR)
+        return false;
+      compressed->append(output_.data(), output_.size() - stream_.avail_out);
+    } while (stream_.avail_out == 0);
+    return true;
+  }
+
+  std::unique_ptr<Sink> next_;
+  z_stream stream_ = {};
+  bool initialized_ = false;
+  std::string output_;
+};
+
+// Sinks made of files and compression complete synchronously, which lets the
+// blocking API use them directly.
+bool WriteNow(Sink* sink, std::string data) {
+  bool result = false;
+  sink->Write(std::move(data),
+              base::BindOnce([](bool* result, bool success) { *result = success; },
+                             &result));
+  return result;
+}
+
+bool FinishNow(Sink* sink) {
+  bool result = false;
+  sink->Finish(base::BindOnce(
+      [](bool* result, bool success) { *result = success; }, &result));
+  return result;
+}
+
+// Passes buffers from the serializing worker to a sink on another sequence
+// through a bounded queue. The serializing worker waits while kMaxQueuedBytes
+// are queued, the sink is only touched on |task_runner_| and is destroyed
+// there.
+class QueuedWriter : public base::RefCountedThreadSafe<QueuedWriter> {
+ public:
+  explicit QueuedWriter(std::unique_ptr<Sink> sink)
+      : task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+            {base::MayBlock(), base::TaskPriority::USER_BLOCKING})),
+        sink_(std::move(sink)),
+        condition_(&lock_) {}
+
+  // Called on the serializing worker.
+  bool Write(std::string buffer) {
+    base::AutoLock auto_lock(lock_);
+    while (queued_bytes_ >= kMaxQueuedBytes && !failed_)
+      condition_.Wait();
+    if (failed_)
+      return false;
+    queued_bytes_ += buffer.size();
+    task_runner_->PostTask(FROM_HERE,
+                           base::BindOnce(&QueuedWriter::WriteOnSequence, this,
+                                          std::move(buffer)));
+    return true;
+  }
+
+  // Called on the serializing worker, waits until everything has been
+  // written and the sink has been closed. |success| is false when
+  // serialization failed.
+  bool Finish(bool success) {
+    task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&QueuedWriter::FinishOnSequence, this, success));
+    base::AutoLock auto_lock(lock_);
+    while (!finished_)
+      condition_.Wait();
+    return !failed_;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<QueuedWriter>;
+  ~QueuedWriter() = default;
+
+  void WriteOnSequence(std::string buffer) {
+    pending_.push_back(std::move(buffer));
+    WriteNext();
+  }
+
+  void FinishOnSequence(bool success) {
+    finish_requested_ = true;
+    if (!success) {
+      base::AutoLock auto_lock(lock_);
+      failed_ = true;
+    }
+    WriteNext();
+  }
+
+  // Hands the next buffer to the sink once it has taken the previous one.
+  void WriteNext() {
+    if (writing_)
+      return;
+    if (pending_.empty()) {
+      if (finish_requested_ && sink_)
+        CloseSink();
+      return;
+    }
+
+    std::string buffer = std::move(pending_.front());
+    pending_.pop_front();
+    size_t size = buffer.size();
+    writing_ = true;
+    if (HasFailed()) {
+      OnWritten(size, false);
+      return;
+    }
+    sink_->Write(std::move(buffer),
+                 base::BindOnce(&QueuedWriter::OnWritten, this, size));
+  }
+
+  void OnWritten(size_t size, bool success) {
+    {
+      base::AutoLock auto_lock(lock_);
+      queued_bytes_ -= size;
+      failed_ |= !success;
+      condition_.Signal();
+    }
+    writing_ = false;
+    // Sinks may call back synchronously, continue from a fresh task.
+    task_runner_->PostTask(FROM_HERE,
+                           base::BindOnce(&QueuedWriter::WriteNext, this));
+  }
+
+  void CloseSink() {
+    if (HasFailed()) {
+      OnClosed(false);
+      return;
+    }
+    writing_ = true;
+    sink_->Finish(base::BindOnce(&QueuedWriter::OnClosed, this));
+  }
+
+  void OnClosed(bool success) {
+    task_runner_->DeleteSoon(FROM_HERE, std::move(sink_));
+    base::AutoLock auto_lock(lock_);
+    failed_ |= !success;
+    finished_ = true;
+    condition_.Signal();
+  }
+
+  bool HasFailed() {
+    base::AutoLock auto_lock(lock_);
+    return failed_;
+  }
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  // Only used on |task_runner_|.
+  std::unique_ptr<Sink> sink_;
+  base::circular_deque<std::string> pending_;
+  bool writing_ = false;
+  bool finish_requested_ = false;
+
+  base::Lock lock_;
+  base::ConditionVariable condition_;
+  size_t queued_bytes_ = 0;
+  bool failed_ = false;
+  bool finished_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(QueuedWriter);
+};
+
+using BufferCallback = base::RepeatingCallback<bool(std::string buffer)>;
+
 class HeapSnapshotOutputStream : public v8::OutputStream {
  public:
-  explicit HeapSnapshotOutputStream(base::File* file) : file_(file) {
-    DCHECK(file_);
+  explicit HeapSnapshotOutputStream(const BufferCallback& callback)
+      : callback_(callback) {
+    buffer_.reserve(kBufferSize);
   }
 
   bool IsComplete() const { return is_complete_; }
 
   // v8::OutputStream
   int GetChunkSize() override { return 65536; }
-  void EndOfStream() override { is_complete_ = true; }
+  void EndOfStream() override { is_complete_ = Flush(); }
 
   v8::OutputStream::WriteResult WriteAsciiChunk(char* data, int size) override {
-    auto bytes_written = file_->WriteAtCurrentPos(data, size);
-    return bytes_written == size ? kContinue : kAbort;
+    buffer_.append(data, size);
+    if (buffer_.size() >= kBufferSize && !Flush())
+      return kAbort;
+    return kContinue;
   }
 
  private:
-  base::File* file_ = nullptr;
+  bool Flush() {
+    if (buffer_.empty())
+      return true;
+    std::string buffer;
+    buffer.reserve(kBufferSize);
+    buffer.swap(buffer_);
+    return callback_.Run(std::move(buffer));
+  }
+
+  BufferCallback callback_;
+  std::string buffer_;
   bool is_complete_ = false;
 };
 
-}  // namespace
+class HeapSnapshotActivityControl : public v8::ActivityControl {
+ public:
+  explicit HeapSnapshotActivityControl(
+      const electron::HeapSnapshotProgressCallback& callback)
+      : callback_(callback) {}
 
-namespace electron {
+  // v8::ActivityControl
+  ControlOption ReportProgressValue(int done, int total) override {
+    callback_.Run(done, total);
+    return kContinue;
+  }
+
+ private:
+  electron::HeapSnapshotProgressCallback callback_;
+};
 
-bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
+std::unique_ptr<Sink> MaybeCompress(std::unique_ptr<Sink> sink,
+                                    const electron::HeapSnapshotOptions& options) {
+  if (options.gzip)
+    return std::make_unique<GzipSink>(std::move(sink));
+  return sink;
+}
+
+// Walks the heap on the calling thread, which must be the isolate's.
+const v8::HeapSnapshot* TakeSnapshot(
+    v8::Isolate* isolate,
+    const electron::HeapSnapshotProgressCallback& progress) {
   DCHECK(isolate);
-  DCHECK(file);
 
-  if (!file->IsValid())
+  HeapSnapshotActivityControl control(progress);
+  return isolate->GetHeapProfiler()->TakeHeapSnapshot(
+      progress ? &control : nullptr);
+}
+
+bool SerializeSnapshot(const v8::HeapSnapshot* snapshot,
+                       const BufferCallback& callback) {
+  HeapSnapshotOutputStream stream(callback);
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+  return stream.IsComplete();
+}
+
+// Runs on a worker that may wait for the queue. Serializing only reads the
+// snapshot, which the isolate leaves alone until it is deleted.
+bool SerializeSnapshotOnWorker(const v8::HeapSnapshot* snapshot,
+                               std::unique_ptr<Sink> sink) {
+  auto writer = base::MakeRefCounted<QueuedWriter>(std::move(sink));
+  bool success = SerializeSnapshot(
+      snapshot, base::BindRepeating(&QueuedWriter::Write, writer));
+  return writer->Finish(success);
+}
+
+void DeleteSnapshot(const v8::HeapSnapshot* snapshot) {
+  const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+}
+
+void TakeHeapSnapshotToSinkAsync(
+    v8::Isolate* isolate,
+    std::unique_ptr<Sink> sink,
+    const electron::HeapSnapshotOptions& options,
+    const electron::HeapSnapshotProgressCallback& progress,
+    electron::HeapSnapshotCallback callback) {
+  const v8::HeapSnapshot* snapshot = TakeSnapshot(isolate, progress);
+  if (!snapshot) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::WithBaseSyncPrimitives(),
+       base::TaskPriority::USER_BLOCKING},
+      base::BindOnce(&SerializeSnapshotOnWorker, base::Unretained(snapshot),
+                     MaybeCompress(std::move(sink), options)),
+      base::BindOnce(
+          [](const v8::HeapSnapshot* snapshot,
+             electron::HeapSnapshotCallback callback, bool success) {
+            DeleteSnapshot(snapshot);
+            std::move(callback).Run(success);
+          },
+          base::Unretained(snapshot), std::move(callback)));
+}
+
+}  // namespace
+
+namespace electron {
+
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      base::File file,
+                      const HeapSnapshotOptions& options) {
+  if (!file.IsValid())
     return false;
 
-  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
+  const v8::HeapSnapshot* snapshot =
+      TakeSnapshot(isolate, HeapSnapshotProgressCallback());
   if (!snapshot)
     return false;
 
-  HeapSnapshotOutputStream stream(file);
-  snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+  auto sink = MaybeCompress(std::make_unique<FileSink>(std::move(file)),
+                            options);
+  bool success = SerializeSnapshot(
+      snapshot, base::BindRepeating(&WriteNow, base::Unretained(sink.get())));
+  DeleteSnapshot(snapshot);
+  return success && FinishNow(sink.get());
+}
 
-  const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+void TakeHeapSnapshotAsync(v8::Isolate* isolate,
+                           base::File file,
+                           const HeapSnapshotOptions& options,
+                           const HeapSnapshotProgressCallback& progress,
+                           HeapSnapshotCallback callback) {
+  if (!file.IsValid()) {
+    std::move(callback).Run(false);
+    return;
+  }
 
-  return stream.IsComplete();
+  TakeHeapSnapshotToSinkAsync(isolate,
+                              std::make_unique<FileSink>(std::move(file)),
+                              options, progress, std::move(callback));
+}
+
+void TakeHeapSnapshotAsync(v8::Isolate* isolate,
+                           mojo::ScopedDataPipeProducerHandle producer,
+                           const HeapSnapshotOptions& options,
+                           const HeapSnapshotProgressCallback& progress,
+                           HeapSnapshotCallback callback) {
+  if (!producer.is_valid()) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  TakeHeapSnapshotToSinkAsync(
+      isolate, std::make_unique<DataPipeSink>(std::move(producer)), options,
+      progress, std::move(callback));
 }
 
 }  // namespace electron
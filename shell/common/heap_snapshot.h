@@ -5,12 +5,46 @@
 #ifndef SHELL_COMMON_HEAP_SNAPSHOT_H_
 #define SHELL_COMMON_HEAP_SNAPSHOT_H_
 
+#include "base/callback.h"
 #include "base/files/file.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "v8/include/v8.h"
 
 namespace electron {
 
-bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file);
+struct HeapSnapshotOptions {
+  // Compress the snapshot with gzip before it is written.
+  bool gzip = false;
+};
+
+// Reports how far the heap has been walked. Runs on the calling thread while
+// the snapshot is being taken, so it must not call into JavaScript.
+using HeapSnapshotProgressCallback =
+    base::RepeatingCallback<void(int done, int total)>;
+
+using HeapSnapshotCallback = base::OnceCallback<void(bool success)>;
+
+// Takes a heap snapshot and writes it to |file| before returning.
+bool TakeHeapSnapshot(
+    v8::Isolate* isolate,
+    base::File file,
+    const HeapSnapshotOptions& options = HeapSnapshotOptions());
+
+// Takes a heap snapshot on the calling thread, then serializes it on a worker
+// while compression and writing to |file| or |producer| happen on another
+// sequence. Serialization pauses while 16 MB of output is waiting to be
+// written, for instance when the consumer of |producer| falls behind.
+// |callback| runs on the calling sequence once everything has been written.
+void TakeHeapSnapshotAsync(v8::Isolate* isolate,
+                           base::File file,
+                           const HeapSnapshotOptions& options,
+                           const HeapSnapshotProgressCallback& progress,
+                           HeapSnapshotCallback callback);
+void TakeHeapSnapshotAsync(v8::Isolate* isolate,
+                           mojo::ScopedDataPipeProducerHandle producer,
+                           const HeapSnapshotOptions& options,
+                           const HeapSnapshotProgressCallback& progress,
+                           HeapSnapshotCallback callback);
 
 }  // namespace electron
 
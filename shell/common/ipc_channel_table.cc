@@ -0,0 +1,57 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/ipc_channel_table.h"
+
+namespace electron {
+
+IPCChannelTable::IPCChannelTable() = default;
+
+IPCChannelTable::~IPCChannelTable() = default;
+
+bool IPCChannelTable::Intern(const std::string& channel,
+                             uint32_t* channel_id,
+                             bool* is_new) {
+  auto it = ids_.find(channel);
+  if (it != ids_.end()) {
+    *channel_id = it->second;
+    *is_new = false;
+    return true;
+  }
+  if (names_.size() >= kMaxChannels)
+    return false;
+  *channel_id = names_.size();
+  *is_new = true;
+  ids_.emplace(channel, *channel_id);
+  names_.push_back(channel);
+  return true;
+}
+
+bool IPCChannelTable::Register(uint32_t channel_id,
+                               const std::string& channel) {
+  if (channel_id != names_.size() || channel_id >= kMaxChannels)
+    return false;
+  names_.push_back(channel);
+  return true;
+}
+
+const std::string* IPCChannelTable::Lookup(uint32_t channel_id) const {
+  if (channel_id >= names_.size())
+    return nullptr;
+  return &names_[channel_id];
+}
+
+const std::string* IPCChannelTable::Resolve(
+    const mojom::IPCChannel& channel) const {
+  if (channel.is_name())
+    return &channel.get_name();
+  return Lookup(channel.get_id());
+}
+
+void IPCChannelTable::Clear() {
+  ids_.clear();
+  names_.clear();
+}
+
+}  // namespace electron
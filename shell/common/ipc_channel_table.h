@@ -0,0 +1,62 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_IPC_CHANNEL_TABLE_H_
+#define SHELL_COMMON_IPC_CHANNEL_TABLE_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+#include "electron/shell/common/api/api.mojom.h"
+
+namespace electron {
+
+// Maps IPC channel names to small integer ids for a single mojo connection,
+// so that each channel name crosses the connection only once.
+//
+// The sending end calls Intern() and announces new ids to the other end with
+// RegisterChannel(). The receiving end mirrors them with Register() and
+// resolves incoming channels with Resolve(). Both ends must Clear() the table
+// when the connection is replaced.
+//
+// Pages can make up channel names at runtime, so a table holds at most
+// kMaxChannels entries. Channels beyond that are sent by name.
+class IPCChannelTable {
+ public:
+  static constexpr size_t kMaxChannels = 1024;
+
+  IPCChannelTable();
+  ~IPCChannelTable();
+
+  // Sets |channel_id| to the id of |channel|, assigning the next id when
+  // |channel| has not been seen before. |is_new| is set to whether an id was
+  // assigned. Returns false when |channel| has no id and the table is full.
+  bool Intern(const std::string& channel, uint32_t* channel_id, bool* is_new);
+
+  // Records |channel| under |channel_id|. Ids must be registered in the order
+  // they were assigned and below kMaxChannels; returns false otherwise.
+  bool Register(uint32_t channel_id, const std::string& channel);
+
+  // Returns the channel registered under |channel_id|, or nullptr.
+  const std::string* Lookup(uint32_t channel_id) const;
+
+  // Returns the name of |channel|, or nullptr when it is an unknown id.
+  const std::string* Resolve(const mojom::IPCChannel& channel) const;
+
+  size_t size() const { return names_.size(); }
+
+  void Clear();
+
+ private:
+  std::unordered_map<std::string, uint32_t> ids_;
+  std::vector<std::string> names_;
+
+  DISALLOW_COPY_AND_ASSIGN(IPCChannelTable);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_IPC_CHANNEL_TABLE_H_
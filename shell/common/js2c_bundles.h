@@ -0,0 +1,54 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_JS2C_BUNDLES_H_
+#define SHELL_COMMON_JS2C_BUNDLES_H_
+
+#include <cstring>
+
+// This header is also used by electron_mkcodecache, which only links V8, so
+// it must not depend on anything else.
+
+namespace electron {
+
+// A script bundled inside the binary by js2c, and the names of the parameters
+// of the function it is wrapped in. The bundles are compiled with these at
+// runtime and by electron_mkcodecache at build time, V8 only accepts a code
+// cache for the parameter list it was created with.
+struct Js2cBundle {
+  const char* id;
+  // Terminated by nullptr.
+  const char* const* parameters;
+};
+
+// The *_init scripts are loaded by node as builtins, which wraps them in its
+// module wrapper.
+constexpr const char* kNodeModuleParameters[] = {
+    "exports",         "require",     "module", "process",
+    "internalBinding", "primordials", nullptr};
+constexpr const char* kAsarBundleParameters[] = {"require", nullptr};
+constexpr const char* kIsolatedBundleParameters[] = {"nodeProcess",
+                                                     "isolatedWorld", nullptr};
+constexpr const char* kSandboxBundleParameters[] = {"binding", nullptr};
+
+constexpr Js2cBundle kJs2cBundles[] = {
+    {"electron/js2c/asar_bundle", kAsarBundleParameters},
+    {"electron/js2c/browser_init", kNodeModuleParameters},
+    {"electron/js2c/isolated_bundle", kIsolatedBundleParameters},
+    {"electron/js2c/renderer_init", kNodeModuleParameters},
+    {"electron/js2c/sandbox_bundle", kSandboxBundleParameters},
+    {"electron/js2c/worker_init", kNodeModuleParameters},
+};
+
+inline const Js2cBundle* FindJs2cBundle(const char* id) {
+  for (const auto& bundle : kJs2cBundles) {
+    if (std::strcmp(bundle.id, id) == 0)
+      return &bundle;
+  }
+  return nullptr;
+}
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_JS2C_BUNDLES_H_
@@ -5,6 +5,7 @@
 #include "shell/common/node_bindings.h"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <set>
 #include <string>
@@ -17,6 +18,7 @@
 #include "base/environment.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -33,12 +35,17 @@
 #include "shell/common/gin_helper/microtasks_scope.h"
 #include "shell/common/mac/main_application_bundle.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/options_switches.h"
 #include "third_party/blink/renderer/bindings/core/v8/v8_initializer.h"  // nogncheck
 
 #if !defined(MAS_BUILD)
 #include "shell/common/crash_keys.h"
 #endif
 
+#if !defined(OS_WIN)
+#include <poll.h>
+#endif
+
 #define ELECTRON_BUILTIN_MODULES(V)      \
   V(electron_browser_app)                \
   V(electron_browser_auto_updater)       \
@@ -312,17 +319,19 @@ NodeBindings::NodeBindings(BrowserEnvironment browser_env)
 }
 
 NodeBindings::~NodeBindings() {
-  // Quit the embed thread.
-  embed_closed_ = true;
-  uv_sem_post(&embed_sem_);
+  if (embed_thread_started_) {
+    // Quit the embed thread.
+    embed_closed_ = true;
+    uv_sem_post(&embed_sem_);
 
-  WakeupEmbedThread();
+    WakeupEmbedThread();
 
-  // Wait for everything to be done.
-  uv_thread_join(&embed_thread_);
+    // Wait for everything to be done.
+    uv_thread_join(&embed_thread_);
 
-  // Clear uv.
-  uv_sem_destroy(&embed_sem_);
+    // Clear uv.
+    uv_sem_destroy(&embed_sem_);
+  }
   dummy_uv_handle_.reset();
 
   // Clean up worker loop
@@ -546,9 +555,35 @@ void NodeBindings::PrepareMessageLoop() {
   // nothing to do.
   uv_async_init(uv_loop_, dummy_uv_handle_.get(), nullptr);
 
+  auto* command_line = base::CommandLine::ForCurrentProcess();
+  int time_slice_ms;
+  if (base::StringToInt(
+          command_line->GetSwitchValueASCII(switches::kNodeLoopTimeSlice),
+          &time_slice_ms) &&
+      time_slice_ms > 0) {
+    uv_run_time_slice_ = base::TimeDelta::FromMilliseconds(time_slice_ms);
+    // A time slice alone drains the loop until it runs out.
+    uv_run_max_passes_ = std::numeric_limits<int>::max();
+  }
+  int max_passes;
+  if (base::StringToInt(
+          command_line->GetSwitchValueASCII(switches::kNodeLoopMaxPasses),
+          &max_passes) &&
+      max_passes > 0) {
+    uv_run_max_passes_ = max_passes;
+  }
+
+  if (!UsesEmbedThread())
+    return;
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
+  embed_thread_started_ = true;
+}
+
+bool NodeBindings::UsesEmbedThread() const {
+  return true;
 }
 
 void NodeBindings::RunMessageLoop() {
@@ -580,9 +615,25 @@ void NodeBindings::UvRunOnce() {
 
   if (browser_env_ != BrowserEnvironment::kBrowser)
     TRACE_EVENT_BEGIN0("devtools.timeline", "FunctionCall");
-
-  // Deal with uv events.
-  int r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+  TRACE_EVENT_BEGIN0("electron.node", "NodeBindings::UvRunOnce");
+
+  // Deal with uv events, keep draining the loop while events keep arriving
+  // and the budget allows it, this saves setting up the scopes above for
+  // every wakeup under heavy callback traffic.
+  const base::TimeTicks start = base::TimeTicks::Now();
+  int passes = 0;
+  int r;
+  do {
+    r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+    ++passes;
+  } while (r != 0 && passes < uv_run_max_passes_ &&
+           base::TimeTicks::Now() - start < uv_run_time_slice_ &&
+           HasPendingUvEvents());
+
+  TRACE_EVENT_END1("electron.node", "NodeBindings::UvRunOnce", "passes",
+                   passes);
+  TRACE_COUNTER2("electron.node", "NodeBindings::UvRunOnce", "passes", passes,
+                 "time_us", (base::TimeTicks::Now() - start).InMicroseconds());
 
   if (browser_env_ != BrowserEnvironment::kBrowser)
     TRACE_EVENT_END0("devtools.timeline", "FunctionCall");
@@ -590,8 +641,28 @@ void NodeBindings::UvRunOnce() {
   if (r == 0)
     base::RunLoop().QuitWhenIdle();  // Quit from uv.
 
+  DidRunUvLoop();
+
   // Tell the worker thread to continue polling.
-  uv_sem_post(&embed_sem_);
+  if (embed_thread_started_)
+    uv_sem_post(&embed_sem_);
+}
+
+bool NodeBindings::HasPendingUvEvents() {
+  return uv_backend_timeout(uv_loop_) == 0 || HasPendingIoEvents();
+}
+
+bool NodeBindings::HasPendingIoEvents() {
+#if !defined(OS_WIN)
+  struct pollfd pfd = {uv_backend_fd(uv_loop_), POLLIN, 0};
+  int r;
+  do {
+    r = poll(&pfd, 1, 0);
+  } while (r == -1 && errno == EINTR);
+  return r > 0;
+#else
+  return false;
+#endif
 }
 
 void NodeBindings::WakeupMainThread() {
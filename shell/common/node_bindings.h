@@ -11,6 +11,7 @@
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
 #include "uv.h"  // NOLINT(build/include_directory)
 #include "v8/include/v8.h"
 
@@ -116,9 +117,24 @@ class NodeBindings {
   // Called to poll events in new thread.
   virtual void PollEvents() = 0;
 
-  // Run the libuv loop for once.
+  // Whether uv events are polled by the embed thread. Platforms that watch
+  // the uv backend fd from the main thread's message pump return false.
+  virtual bool UsesEmbedThread() const;
+
+  // Called on the main thread after each pass of the uv loop.
+  virtual void DidRunUvLoop() {}
+
+  // Run the libuv loop for once, or for as many passes as the drain budget
+  // allows while uv events keep arriving.
   void UvRunOnce();
 
+  // Whether the uv loop has events that a pass would handle right away.
+  bool HasPendingUvEvents();
+
+  // Whether io completions are waiting on the uv backend, checked without
+  // blocking. Only called while the embed thread is not polling.
+  virtual bool HasPendingIoEvents();
+
   // Make the main thread run libuv loop.
   void WakeupMainThread();
 
@@ -141,6 +157,14 @@ class NodeBindings {
   // Whether the libuv loop has ended.
   bool embed_closed_ = false;
 
+  // Whether the embed thread has been started.
+  bool embed_thread_started_ = false;
+
+  // Budget for draining uv in a single wakeup, by default only one pass is
+  // made. See --node-loop-time-slice and --node-loop-max-passes.
+  base::TimeDelta uv_run_time_slice_ = base::TimeDelta::Max();
+  int uv_run_max_passes_ = 1;
+
   // Loop used when constructed in WORKER mode
   uv_loop_t worker_loop_;
 
@@ -6,10 +6,32 @@
 
 #include <sys/epoll.h>
 
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "base/logging.h"
+#include "base/task/current_thread.h"
+#include "shell/common/options_switches.h"
+
 namespace electron {
 
 NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
     : NodeBindings(browser_env), epoll_(epoll_create(1)) {
+#if defined(USE_OZONE)
+  // Only the browser process runs node on a UI message pump that can watch
+  // file descriptors.
+  use_fd_watcher_ = browser_env == BrowserEnvironment::kBrowser &&
+                    base::CommandLine::ForCurrentProcess()->HasSwitch(
+                        switches::kNodeLoopFdWatcher);
+#else
+  if (browser_env == BrowserEnvironment::kBrowser &&
+      base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kNodeLoopFdWatcher)) {
+    LOG(WARNING) << "--" << switches::kNodeLoopFdWatcher
+                 << " is not supported by this build, which does not use "
+                    "Ozone. The embed thread is used instead.";
+  }
+#endif
+
   int backend_fd = uv_backend_fd(uv_loop_);
   struct epoll_event ev = {0};
   ev.events = EPOLLIN;
@@ -25,6 +47,34 @@ void NodeBindingsLinux::RunMessageLoop() {
   uv_loop_->on_watcher_queue_updated = OnWatcherQueueChanged;
 
   NodeBindings::RunMessageLoop();
+
+#if defined(USE_OZONE)
+  if (use_fd_watcher_) {
+    base::CurrentUIThread::Get()->WatchFileDescriptor(
+        uv_backend_fd(uv_loop_), true /* persistent */,
+        base::MessagePumpForUI::WATCH_READ, &fd_watch_controller_, this);
+  }
+#endif
+}
+
+bool NodeBindingsLinux::UsesEmbedThread() const {
+  return !use_fd_watcher_;
+}
+
+void NodeBindingsLinux::DidRunUvLoop() {
+  if (!use_fd_watcher_)
+    return;
+
+  // The backend fd only signals io events, uv timers are driven by a delayed
+  // task matching the loop's next timeout.
+  int timeout = uv_backend_timeout(uv_loop_);
+  if (timeout < 0) {
+    uv_timeout_timer_.Stop();
+    return;
+  }
+  uv_timeout_timer_.Start(FROM_HERE, base::TimeDelta::FromMilliseconds(timeout),
+                          base::BindOnce(&NodeBindingsLinux::UvRunOnce,
+                                         base::Unretained(this)));
 }
 
 // static
@@ -32,7 +82,8 @@ void NodeBindingsLinux::OnWatcherQueueChanged(uv_loop_t* loop) {
   NodeBindingsLinux* self = static_cast<NodeBindingsLinux*>(loop->data);
 
   // We need to break the io polling in the epoll thread when loop's watcher
-  // queue changes, otherwise new events cannot be notified.
+  // queue changes, otherwise new events cannot be notified. When the fd is
+  // watched by the message pump this makes the backend fd readable instead.
   self->WakeupEmbedThread();
 }
 
@@ -47,6 +98,14 @@ void NodeBindingsLinux::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+#if defined(USE_OZONE)
+void NodeBindingsLinux::OnFileCanReadWithoutBlocking(int fd) {
+  UvRunOnce();
+}
+
+void NodeBindingsLinux::OnFileCanWriteWithoutBlocking(int fd) {}
+#endif
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsLinux(browser_env);
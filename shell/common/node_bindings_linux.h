@@ -6,23 +6,50 @@
 #define SHELL_COMMON_NODE_BINDINGS_LINUX_H_
 
 #include "base/compiler_specific.h"
+#include "base/message_loop/message_pump_for_ui.h"
+#include "base/timer/timer.h"
 #include "shell/common/node_bindings.h"
 
 namespace electron {
 
-class NodeBindingsLinux : public NodeBindings {
+class NodeBindingsLinux : public NodeBindings
+#if defined(USE_OZONE)
+    , public base::MessagePumpForUI::FdWatcher
+#endif
+{
  public:
   explicit NodeBindingsLinux(BrowserEnvironment browser_env);
   ~NodeBindingsLinux() override;
 
   void RunMessageLoop() override;
 
+ protected:
+  bool UsesEmbedThread() const override;
+  void DidRunUvLoop() override;
+
  private:
   // Called when uv's watcher queue changes.
   static void OnWatcherQueueChanged(uv_loop_t* loop);
 
   void PollEvents() override;
 
+#if defined(USE_OZONE)
+  // base::MessagePumpForUI::FdWatcher:
+  void OnFileCanReadWithoutBlocking(int fd) override;
+  void OnFileCanWriteWithoutBlocking(int fd) override;
+
+  // Watches uv's backend fd from the UI message pump when the embed thread
+  // is not used.
+  base::MessagePumpForUI::FdWatchController fd_watch_controller_{FROM_HERE};
+#endif
+
+  // Runs the uv loop when its next timer is due.
+  base::OneShotTimer uv_timeout_timer_;
+
+  // Whether uv's backend fd is watched by the message pump instead of being
+  // polled by the embed thread.
+  bool use_fd_watcher_ = false;
+
   // Epoll to poll for uv's backend fd.
   int epoll_;
 
@@ -45,6 +45,19 @@ void NodeBindingsWin::PollEvents() {
     PostQueuedCompletionStatus(uv_loop_->iocp, bytes, key, overlapped);
 }
 
+bool NodeBindingsWin::HasPendingIoEvents() {
+  // An iocp can't be peeked, dequeue a completion and give it back like
+  // PollEvents does.
+  DWORD bytes;
+  ULONG_PTR key;
+  OVERLAPPED* overlapped = nullptr;
+  GetQueuedCompletionStatus(uv_loop_->iocp, &bytes, &key, &overlapped, 0);
+  if (overlapped == nullptr)
+    return false;
+  PostQueuedCompletionStatus(uv_loop_->iocp, bytes, key, overlapped);
+  return true;
+}
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsWin(browser_env);
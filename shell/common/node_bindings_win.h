@@ -17,6 +17,7 @@ class NodeBindingsWin : public NodeBindings {
 
  private:
   void PollEvents() override;
+  bool HasPendingIoEvents() override;
 
   DISALLOW_COPY_AND_ASSIGN(NodeBindingsWin);
 };
@@ -4,6 +4,7 @@
 
 #include "shell/common/node_util.h"
 #include "base/logging.h"
+#include "shell/common/js2c_bundles.h"
 #include "shell/common/node_includes.h"
 #include "third_party/electron_node/src/node_native_module_env.h"
 
@@ -14,14 +15,20 @@ namespace util {
 v8::MaybeLocal<v8::Value> CompileAndCall(
     v8::Local<v8::Context> context,
     const char* id,
-    std::vector<v8::Local<v8::String>>* parameters,
     std::vector<v8::Local<v8::Value>>* arguments,
     node::Environment* optional_env) {
   v8::Isolate* isolate = context->GetIsolate();
+  const Js2cBundle* bundle = FindJs2cBundle(id);
+  CHECK(bundle) << "Unknown electron script: " << id;
+  std::vector<v8::Local<v8::String>> parameters;
+  for (const char* const* name = bundle->parameters; *name; ++name)
+    parameters.push_back(node::OneByteString(isolate, *name));
+  DCHECK_EQ(parameters.size(), arguments->size());
+
   v8::TryCatch try_catch(isolate);
   v8::MaybeLocal<v8::Function> compiled =
       node::native_module::NativeModuleEnv::LookupAndCompile(
-          context, id, parameters, optional_env);
+          context, id, &parameters, optional_env);
   if (compiled.IsEmpty()) {
     return v8::MaybeLocal<v8::Value>();
   }
@@ -159,6 +159,9 @@ const char kAllowRunningInsecureContent[] = "allowRunningInsecureContent";
 
 const char kOffscreen[] = "offscreen";
 
+// Only produce offscreen frames when something could have changed them.
+const char kOnDemandFrames[] = "onDemandFrames";
+
 const char kNodeIntegrationInSubFrames[] = "nodeIntegrationInSubFrames";
 
 // Disable window resizing when HTML Fullscreen API is activated.
@@ -274,6 +277,19 @@ const char kGlobalCrashKeys[] = "global-crash-keys";
 
 const char kEnableWebSQL[] = "enable-websql";
 
+// Integrate the main process' Node.js event loop with the UI message pump.
+const char kNodeLoopFdWatcher[] = "node-loop-fd-watcher";
+
+// Budget for draining the Node.js event loop on a single wakeup.
+const char kNodeLoopTimeSlice[] = "node-loop-time-slice";
+const char kNodeLoopMaxPasses[] = "node-loop-max-passes";
+
+// Enable PartitionAlloc's thread cache for the main process' ArrayBuffers.
+const char kEnableArrayBufferThreadCache[] = "enable-array-buffer-thread-cache";
+
+// Passed to renderers launched before a page needs them.
+const char kSpareRenderer[] = "spare-renderer";
+
 }  // namespace switches
 
 }  // namespace electron
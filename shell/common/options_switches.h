@@ -80,6 +80,7 @@ extern const char kSandbox[];
 extern const char kWebSecurity[];
 extern const char kAllowRunningInsecureContent[];
 extern const char kOffscreen[];
+extern const char kOnDemandFrames[];
 extern const char kNodeIntegrationInSubFrames[];
 extern const char kDisableHtmlFullscreenWindowResize[];
 extern const char kJavaScript[];
@@ -135,6 +136,14 @@ extern const char kDisableNTLMv2[];
 extern const char kGlobalCrashKeys[];
 
 extern const char kEnableWebSQL[];
+
+extern const char kNodeLoopFdWatcher[];
+extern const char kNodeLoopTimeSlice[];
+extern const char kNodeLoopMaxPasses[];
+
+extern const char kEnableArrayBufferThreadCache[];
+
+extern const char kSpareRenderer[];
 }  // namespace switches
 
 }  // namespace electron
@@ -0,0 +1,318 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/sampling_profiler.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "base/json/json_writer.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/values.h"
+#include "gin/converter.h"
+#include "shell/common/node_includes.h"
+#include "v8/include/v8-profiler.h"
+
+namespace electron {
+
+namespace {
+
+// Workers have isolates of their own, so the state of each isolate is kept
+// behind a lock.
+struct ProfilerState {
+  base::Lock lock;
+  std::set<v8::Isolate*> heap_profiling;
+  std::map<v8::Isolate*, v8::CpuProfiler*> cpu_profilers;
+  // node::Environments with a cleanup hook registered, and their isolates.
+  std::map<node::Environment*, v8::Isolate*> cleanup_hooks;
+};
+
+ProfilerState& GetProfilerState() {
+  static base::NoDestructor<ProfilerState> state;
+  return *state;
+}
+
+// Worker isolates go away with their node::Environment, so whatever is still
+// being recorded there is dropped before the isolate is disposed. An isolate
+// can host several environments, like one per frame in a renderer, so this
+// waits for the last one that has a hook.
+void OnEnvironmentCleanup(void* arg) {
+  auto* env = static_cast<node::Environment*>(arg);
+  ProfilerState& state = GetProfilerState();
+  v8::Isolate* isolate;
+  bool heap_profiling;
+  v8::CpuProfiler* profiler = nullptr;
+  {
+    base::AutoLock auto_lock(state.lock);
+    auto hook = state.cleanup_hooks.find(env);
+    if (hook == state.cleanup_hooks.end())
+      return;
+    isolate = hook->second;
+    state.cleanup_hooks.erase(hook);
+    for (const auto& other : state.cleanup_hooks) {
+      if (other.second == isolate)
+        return;
+    }
+    heap_profiling = state.heap_profiling.erase(isolate);
+    auto it = state.cpu_profilers.find(isolate);
+    if (it != state.cpu_profilers.end()) {
+      profiler = it->second;
+      state.cpu_profilers.erase(it);
+    }
+  }
+
+  if (heap_profiling)
+    isolate->GetHeapProfiler()->StopSamplingHeapProfiler();
+  // Disposing the profiler also deletes the profile being recorded.
+  if (profiler)
+    profiler->Dispose();
+}
+
+// Hooks the environment the profiler is started from. Isolates without a
+// node::Environment, like the main world of a sandboxed renderer, live as
+// long as the process and need no hook.
+void AddCleanupHook(v8::Isolate* isolate) {
+  node::Environment* env = node::Environment::GetCurrent(isolate);
+  if (!env)
+    return;
+  ProfilerState& state = GetProfilerState();
+  {
+    base::AutoLock auto_lock(state.lock);
+    if (!state.cleanup_hooks.emplace(env, isolate).second)
+      return;
+  }
+  env->AddCleanupHook(&OnEnvironmentCleanup, env);
+}
+
+// Removes the hooks of all the environments of |isolate| once nothing is
+// being recorded there anymore.
+void MaybeRemoveCleanupHooks(v8::Isolate* isolate) {
+  ProfilerState& state = GetProfilerState();
+  std::vector<node::Environment*> envs;
+  {
+    base::AutoLock auto_lock(state.lock);
+    if (state.heap_profiling.count(isolate) ||
+        state.cpu_profilers.count(isolate))
+      return;
+    for (auto it = state.cleanup_hooks.begin();
+         it != state.cleanup_hooks.end();) {
+      if (it->second == isolate) {
+        envs.push_back(it->first);
+        it = state.cleanup_hooks.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  // The environments share the isolate, and with it this thread.
+  for (auto* env : envs)
+    env->RemoveCleanupHook(&OnEnvironmentCleanup, env);
+}
+
+constexpr char kCpuProfileTitle[] = "electron";
+
+std::string ToStdString(v8::Isolate* isolate, v8::Local<v8::String> value) {
+  v8::String::Utf8Value utf8(isolate, value);
+  return *utf8 ? std::string(*utf8, utf8.length()) : std::string();
+}
+
+// V8 line and column numbers are 1-based, DevTools expects them 0-based with
+// -1 meaning unknown.
+base::Value CallFrame(const std::string& function_name,
+                      const std::string& url,
+                      int script_id,
+                      int line_number,
+                      int column_number) {
+  base::Value call_frame(base::Value::Type::DICTIONARY);
+  call_frame.SetStringKey("functionName", function_name);
+  call_frame.SetStringKey("scriptId", std::to_string(script_id));
+  call_frame.SetStringKey("url", url);
+  call_frame.SetIntKey("lineNumber", line_number - 1);
+  call_frame.SetIntKey("columnNumber", column_number - 1);
+  return call_frame;
+}
+
+base::Value SerializeAllocationNode(v8::Isolate* isolate,
+                                    const v8::AllocationProfile::Node* node) {
+  base::Value result(base::Value::Type::DICTIONARY);
+  result.SetKey("callFrame",
+                CallFrame(ToStdString(isolate, node->name),
+                          ToStdString(isolate, node->script_name),
+                          node->script_id, node->line_number,
+                          node->column_number));
+  double self_size = 0;
+  for (const auto& allocation : node->allocations)
+    self_size += static_cast<double>(allocation.size) * allocation.count;
+  result.SetDoubleKey("selfSize", self_size);
+  result.SetIntKey("id", node->node_id);
+  base::Value children(base::Value::Type::LIST);
+  for (const auto* child : node->children)
+    children.Append(SerializeAllocationNode(isolate, child));
+  result.SetKey("children", std::move(children));
+  return result;
+}
+
+std::string SerializeHeapProfile(v8::Isolate* isolate,
+                                 v8::AllocationProfile* profile) {
+  base::Value result(base::Value::Type::DICTIONARY);
+  result.SetKey("head",
+                SerializeAllocationNode(isolate, profile->GetRootNode()));
+  base::Value samples(base::Value::Type::LIST);
+  for (const auto& sample : profile->GetSamples()) {
+    base::Value value(base::Value::Type::DICTIONARY);
+    value.SetDoubleKey("size",
+                       static_cast<double>(sample.size) * sample.count);
+    value.SetIntKey("nodeId", sample.node_id);
+    value.SetDoubleKey("ordinal", static_cast<double>(sample.sample_id));
+    samples.Append(std::move(value));
+  }
+  result.SetKey("samples", std::move(samples));
+
+  std::string json;
+  base::JSONWriter::Write(result, &json);
+  return json;
+}
+
+void SerializeCpuProfileNode(v8::Isolate* isolate,
+                             const v8::CpuProfileNode* node,
+                             base::Value* nodes) {
+  base::Value result(base::Value::Type::DICTIONARY);
+  result.SetIntKey("id", node->GetNodeId());
+  result.SetKey(
+      "callFrame",
+      CallFrame(node->GetFunctionNameStr(), node->GetScriptResourceNameStr(),
+                node->GetScriptId(), node->GetLineNumber(),
+                node->GetColumnNumber()));
+  result.SetIntKey("hitCount", node->GetHitCount());
+  base::Value children(base::Value::Type::LIST);
+  for (int i = 0; i < node->GetChildrenCount(); ++i)
+    children.Append(node->GetChild(i)->GetNodeId());
+  result.SetKey("children", std::move(children));
+  nodes->Append(std::move(result));
+
+  for (int i = 0; i < node->GetChildrenCount(); ++i)
+    SerializeCpuProfileNode(isolate, node->GetChild(i), nodes);
+}
+
+std::string SerializeCpuProfile(v8::Isolate* isolate,
+                                const v8::CpuProfile* profile) {
+  base::Value result(base::Value::Type::DICTIONARY);
+  base::Value nodes(base::Value::Type::LIST);
+  SerializeCpuProfileNode(isolate, profile->GetTopDownRoot(), &nodes);
+  result.SetKey("nodes", std::move(nodes));
+  result.SetDoubleKey("startTime",
+                      static_cast<double>(profile->GetStartTime()));
+  result.SetDoubleKey("endTime", static_cast<double>(profile->GetEndTime()));
+
+  base::Value samples(base::Value::Type::LIST);
+  base::Value time_deltas(base::Value::Type::LIST);
+  int64_t last_timestamp = profile->GetStartTime();
+  for (int i = 0; i < profile->GetSamplesCount(); ++i) {
+    samples.Append(profile->GetSample(i)->GetNodeId());
+    int64_t timestamp = profile->GetSampleTimestamp(i);
+    time_deltas.Append(static_cast<int>(timestamp - last_timestamp));
+    last_timestamp = timestamp;
+  }
+  result.SetKey("samples", std::move(samples));
+  result.SetKey("timeDeltas", std::move(time_deltas));
+
+  std::string json;
+  base::JSONWriter::Write(result, &json);
+  return json;
+}
+
+}  // namespace
+
+bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                               uint64_t sample_interval,
+                               int stack_depth) {
+  ProfilerState& state = GetProfilerState();
+  {
+    base::AutoLock auto_lock(state.lock);
+    if (!state.heap_profiling.insert(isolate).second)
+      return false;
+  }
+  if (!isolate->GetHeapProfiler()->StartSamplingHeapProfiler(sample_interval,
+                                                             stack_depth)) {
+    base::AutoLock auto_lock(state.lock);
+    state.heap_profiling.erase(isolate);
+    return false;
+  }
+  AddCleanupHook(isolate);
+  return true;
+}
+
+base::Optional<std::string> StopSamplingHeapProfiler(v8::Isolate* isolate) {
+  ProfilerState& state = GetProfilerState();
+  {
+    base::AutoLock auto_lock(state.lock);
+    if (!state.heap_profiling.erase(isolate))
+      return base::nullopt;
+  }
+  MaybeRemoveCleanupHooks(isolate);
+
+  v8::HandleScope handle_scope(isolate);
+  v8::HeapProfiler* heap_profiler = isolate->GetHeapProfiler();
+  std::unique_ptr<v8::AllocationProfile> profile(
+      heap_profiler->GetAllocationProfile());
+  heap_profiler->StopSamplingHeapProfiler();
+  if (!profile)
+    return base::nullopt;
+  return SerializeHeapProfile(isolate, profile.get());
+}
+
+bool StartCpuProfile(v8::Isolate* isolate, int sampling_interval_us) {
+  ProfilerState& state = GetProfilerState();
+  {
+    base::AutoLock auto_lock(state.lock);
+    if (state.cpu_profilers.count(isolate))
+      return false;
+
+    v8::HandleScope handle_scope(isolate);
+    v8::CpuProfiler* profiler = v8::CpuProfiler::New(isolate);
+    v8::CpuProfilingStatus status = profiler->StartProfiling(
+        gin::StringToV8(isolate, kCpuProfileTitle),
+        v8::CpuProfilingOptions(v8::kLeafNodeLineNumbers,
+                                v8::CpuProfilingOptions::kNoSampleLimit,
+                                sampling_interval_us));
+    if (status == v8::CpuProfilingStatus::kErrorTooManyProfilers) {
+      profiler->Dispose();
+      return false;
+    }
+    state.cpu_profilers[isolate] = profiler;
+  }
+  AddCleanupHook(isolate);
+  return true;
+}
+
+base::Optional<std::string> StopCpuProfile(v8::Isolate* isolate) {
+  ProfilerState& state = GetProfilerState();
+  v8::CpuProfiler* profiler;
+  {
+    base::AutoLock auto_lock(state.lock);
+    auto it = state.cpu_profilers.find(isolate);
+    if (it == state.cpu_profilers.end())
+      return base::nullopt;
+    profiler = it->second;
+    state.cpu_profilers.erase(it);
+  }
+  MaybeRemoveCleanupHooks(isolate);
+
+  v8::HandleScope handle_scope(isolate);
+  v8::CpuProfile* profile =
+      profiler->StopProfiling(gin::StringToV8(isolate, kCpuProfileTitle));
+  base::Optional<std::string> result;
+  if (profile) {
+    result = SerializeCpuProfile(isolate, profile);
+    profile->Delete();
+  }
+  profiler->Dispose();
+  return result;
+}
+
+}  // namespace electron
@@ -0,0 +1,42 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_SAMPLING_PROFILER_H_
+#define SHELL_COMMON_SAMPLING_PROFILER_H_
+
+#include <string>
+
+#include "base/optional.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+// Low-overhead profilers that can stay enabled in production, as opposed to
+// heap snapshots which pause the isolate. At most one profile of each kind
+// can be recorded per isolate at a time.
+
+// The defaults match node's --heap-prof-interval and --cpu-prof-interval.
+constexpr uint64_t kDefaultHeapSamplingInterval = 512 * 1024;
+constexpr int kDefaultHeapSamplingStackDepth = 16;
+constexpr int kDefaultCpuSamplingInterval = 1000;
+
+// Samples one allocation every |sample_interval| bytes on average, recording
+// up to |stack_depth| frames. Returns false if the profiler is already running.
+bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                               uint64_t sample_interval,
+                               int stack_depth);
+// Returns the profile serialized in the DevTools .heapprofile format, or
+// nothing if the profiler was not running.
+base::Optional<std::string> StopSamplingHeapProfiler(v8::Isolate* isolate);
+
+// Samples the JavaScript stack every |sampling_interval_us| microseconds.
+// Returns false if a CPU profile is already being recorded.
+bool StartCpuProfile(v8::Isolate* isolate, int sampling_interval_us);
+// Returns the profile serialized in the DevTools .cpuprofile format, or
+// nothing if no profile was being recorded.
+base::Optional<std::string> StopCpuProfile(v8::Isolate* isolate);
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_SAMPLING_PROFILER_H_
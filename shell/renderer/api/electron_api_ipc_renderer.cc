@@ -19,6 +19,7 @@
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/function_template_extensions.h"
 #include "shell/common/gin_helper/promise.h"
+#include "shell/common/ipc_channel_table.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/v8_value_serializer.h"
@@ -63,13 +64,13 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
         electron_browser_remote_.BindNewPipeAndPassReceiver());
   }
 
-  void OnDestruct() override { electron_browser_remote_.reset(); }
+  void OnDestruct() override { ResetRemote(); }
 
   void WillReleaseScriptContext(v8::Local<v8::Context> context,
                                 int32_t world_id) override {
     if (weak_context_.IsEmpty() ||
         weak_context_.Get(context->GetIsolate()) == context)
-      electron_browser_remote_.reset();
+      ResetRemote();
   }
 
   // gin::Wrappable:
@@ -87,6 +88,24 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
   const char* GetTypeName() override { return "IPCRenderer"; }
 
  private:
+  void ResetRemote() {
+    electron_browser_remote_.reset();
+    channels_.Clear();
+  }
+
+  // Returns the id of |channel| on |electron_browser_remote_|, registering
+  // it with the browser on first use. Falls back to the name once the
+  // channel table is full.
+  electron::mojom::IPCChannelPtr GetChannel(const std::string& channel) {
+    uint32_t channel_id;
+    bool is_new;
+    if (!channels_.Intern(channel, &channel_id, &is_new))
+      return electron::mojom::IPCChannel::NewName(channel);
+    if (is_new)
+      electron_browser_remote_->RegisterChannel(channel_id, channel);
+    return electron::mojom::IPCChannel::NewId(channel_id);
+  }
+
   void SendMessage(v8::Isolate* isolate,
                    gin_helper::ErrorThrower thrower,
                    bool internal,
@@ -100,7 +119,8 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
     if (!electron::SerializeV8Value(isolate, arguments, &message)) {
       return;
     }
-    electron_browser_remote_->Message(internal, channel, std::move(message));
+    electron_browser_remote_->Message(internal, GetChannel(channel),
+                                      std::move(message));
   }
 
   v8::Local<v8::Promise> Invoke(v8::Isolate* isolate,
@@ -120,7 +140,7 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
     auto handle = p.GetHandle();
 
     electron_browser_remote_->Invoke(
-        internal, channel, std::move(message),
+        internal, GetChannel(channel), std::move(message),
         base::BindOnce(
             [](gin_helper::Promise<blink::CloneableMessage> p,
                blink::CloneableMessage result) { p.Resolve(result); },
@@ -218,13 +238,14 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
     }
 
     blink::CloneableMessage result;
-    electron_browser_remote_->MessageSync(internal, channel, std::move(message),
-                                          &result);
+    electron_browser_remote_->MessageSync(internal, GetChannel(channel),
+                                          std::move(message), &result);
     return electron::DeserializeV8Value(isolate, result);
   }
 
   v8::Global<v8::Context> weak_context_;
   mojo::Remote<electron::mojom::ElectronBrowser> electron_browser_remote_;
+  electron::IPCChannelTable channels_;
 };
 
 gin::WrapperInfo IPCRenderer::kWrapperInfo = {gin::kEmbedderNativeGin};
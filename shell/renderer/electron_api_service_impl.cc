@@ -11,7 +11,9 @@
 #include "base/environment.h"
 #include "base/macros.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/trace_event/trace_event.h"
 #include "gin/data_object_builder.h"
+#include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/platform_handle.h"
 #include "shell/common/electron_constants.h"
 #include "shell/common/gin_converters/blink_converter.h"
@@ -19,6 +21,7 @@
 #include "shell/common/heap_snapshot.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/sampling_profiler.h"
 #include "shell/common/v8_value_serializer.h"
 #include "shell/renderer/electron_render_frame_observer.h"
 #include "shell/renderer/renderer_client_base.h"
@@ -48,52 +51,14 @@ v8::Local<v8::Object> GetIpcObject(v8::Local<v8::Context> context) {
   return value->ToObject(context).ToLocalChecked();
 }
 
-void InvokeIpcCallback(v8::Local<v8::Context> context,
-                       const std::string& callback_name,
-                       std::vector<v8::Local<v8::Value>> args) {
-  TRACE_EVENT0("devtools.timeline", "FunctionCall");
-  auto* isolate = context->GetIsolate();
-
-  auto ipcNative = GetIpcObject(context);
-  if (ipcNative.IsEmpty())
-    return;
-
-  // Only set up the node::CallbackScope if there's a node environment.
-  // Sandboxed renderers don't have a node environment.
-  node::Environment* env = node::Environment::GetCurrent(context);
-  std::unique_ptr<node::CallbackScope> callback_scope;
-  if (env) {
-    callback_scope.reset(new node::CallbackScope(isolate, ipcNative, {0, 0}));
-  }
-
-  auto callback_key = gin::ConvertToV8(isolate, callback_name)
-                          ->ToString(context)
-                          .ToLocalChecked();
-  auto callback_value = ipcNative->Get(context, callback_key).ToLocalChecked();
-  DCHECK(callback_value->IsFunction());  // set by init.ts
-  auto callback = callback_value.As<v8::Function>();
-  ignore_result(callback->Call(context, ipcNative, args.size(), args.data()));
-}
-
-void EmitIPCEvent(v8::Local<v8::Context> context,
-                  bool internal,
-                  const std::string& channel,
-                  std::vector<v8::Local<v8::Value>> ports,
-                  v8::Local<v8::Value> args,
-                  int32_t sender_id) {
-  auto* isolate = context->GetIsolate();
-
-  v8::HandleScope handle_scope(isolate);
-  v8::Context::Scope context_scope(context);
-  v8::MicrotasksScope script_scope(isolate,
-                                   v8::MicrotasksScope::kRunMicrotasks);
-
-  std::vector<v8::Local<v8::Value>> argv = {
-      gin::ConvertToV8(isolate, internal), gin::ConvertToV8(isolate, channel),
-      gin::ConvertToV8(isolate, ports), args,
-      gin::ConvertToV8(isolate, sender_id)};
-
-  InvokeIpcCallback(context, "onMessage", argv);
+HeapSnapshotProgressCallback GetHeapSnapshotProgressCallback(
+    mojo::Remote<mojom::HeapSnapshotObserver>* observer) {
+  if (!observer->is_bound())
+    return HeapSnapshotProgressCallback();
+  return base::BindRepeating(
+      [](mojo::Remote<mojom::HeapSnapshotObserver>* observer, int done,
+         int total) { (*observer)->OnProgress(done, total); },
+      base::Unretained(observer));
 }
 
 }  // namespace
@@ -112,17 +77,24 @@ ElectronApiServiceImpl::ElectronApiServiceImpl(
 void ElectronApiServiceImpl::BindTo(
     mojo::PendingReceiver<mojom::ElectronRenderer> receiver) {
   if (document_created_) {
-    if (receiver_.is_bound())
-      receiver_.reset();
-
-    receiver_.Bind(std::move(receiver));
-    receiver_.set_disconnect_handler(base::BindOnce(
-        &ElectronApiServiceImpl::OnConnectionError, GetWeakPtr()));
+    BindReceiver(std::move(receiver));
   } else {
     pending_receiver_ = std::move(receiver);
   }
 }
 
+void ElectronApiServiceImpl::BindReceiver(
+    mojo::PendingReceiver<mojom::ElectronRenderer> receiver) {
+  if (receiver_.is_bound())
+    receiver_.reset();
+  channels_.Clear();
+  v8_channels_.clear();
+
+  receiver_.Bind(std::move(receiver));
+  receiver_.set_disconnect_handler(base::BindOnce(
+      &ElectronApiServiceImpl::OnConnectionError, GetWeakPtr()));
+}
+
 void ElectronApiServiceImpl::OnInterfaceRequestForFrame(
     const std::string& interface_name,
     mojo::ScopedMessagePipeHandle* interface_pipe) {
@@ -132,14 +104,18 @@ void ElectronApiServiceImpl::OnInterfaceRequestForFrame(
 void ElectronApiServiceImpl::DidCreateDocumentElement() {
   document_created_ = true;
 
-  if (pending_receiver_) {
-    if (receiver_.is_bound())
-      receiver_.reset();
+  if (pending_receiver_)
+    BindReceiver(std::move(pending_receiver_));
+}
 
-    receiver_.Bind(std::move(pending_receiver_));
-    receiver_.set_disconnect_handler(base::BindOnce(
-        &ElectronApiServiceImpl::OnConnectionError, GetWeakPtr()));
-  }
+void ElectronApiServiceImpl::WillReleaseScriptContext(
+    v8::Local<v8::Context> context,
+    int32_t world_id) {
+  if (ipc_context_.IsEmpty() || ipc_context_ != context)
+    return;
+  ipc_context_.Reset();
+  ipc_native_.Reset();
+  ipc_on_message_.Reset();
 }
 
 void ElectronApiServiceImpl::OnDestruct() {
@@ -151,10 +127,24 @@ void ElectronApiServiceImpl::OnConnectionError() {
     receiver_.reset();
 }
 
+void ElectronApiServiceImpl::RegisterChannel(uint32_t channel_id,
+                                             const std::string& channel) {
+  if (!channels_.Register(channel_id, channel))
+    receiver_.ReportBadMessage("Out of order IPC channel id");
+}
+
 void ElectronApiServiceImpl::Message(bool internal,
-                                     const std::string& channel,
+                                     mojom::IPCChannelPtr ipc_channel,
                                      blink::CloneableMessage arguments,
                                      int32_t sender_id) {
+  const std::string* channel = channels_.Resolve(*ipc_channel);
+  if (!channel) {
+    receiver_.ReportBadMessage("Unknown IPC channel id");
+    return;
+  }
+  TRACE_EVENT2("electron.ipc", "ElectronApiServiceImpl::Message", "channel",
+               *channel, "bytes", arguments.encoded_message.size());
+
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
   if (!frame)
     return;
@@ -165,9 +155,30 @@ void ElectronApiServiceImpl::Message(bool internal,
   v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
   v8::Context::Scope context_scope(context);
 
-  v8::Local<v8::Value> args = gin::ConvertToV8(isolate, arguments);
+  // V8 strings are not bound to a context, so the converted channel can be
+  // reused for every message on this connection. Channels sent by name are
+  // past the table's limit and are not cached either.
+  v8::Local<v8::String> v8_channel;
+  if (ipc_channel->is_id()) {
+    uint32_t channel_id = ipc_channel->get_id();
+    if (v8_channels_.size() <= channel_id)
+      v8_channels_.resize(channels_.size());
+    if (v8_channels_[channel_id].IsEmpty()) {
+      v8_channels_[channel_id].Reset(
+          isolate, gin::StringToSymbol(isolate, *channel));
+    }
+    v8_channel = v8_channels_[channel_id].Get(isolate);
+  } else {
+    v8_channel = gin::StringToV8(isolate, *channel);
+  }
+
+  v8::Local<v8::Value> args;
+  {
+    TRACE_EVENT0("electron.ipc", "ElectronApiServiceImpl::Deserialize");
+    args = gin::ConvertToV8(isolate, arguments);
+  }
 
-  EmitIPCEvent(context, internal, channel, {}, args, sender_id);
+  EmitIPCEvent(context, internal, v8_channel, {}, args, sender_id);
 }
 
 void ElectronApiServiceImpl::ReceivePostMessage(
@@ -194,12 +205,81 @@ void ElectronApiServiceImpl::ReceivePostMessage(
 
   std::vector<v8::Local<v8::Value>> args = {message_value};
 
-  EmitIPCEvent(context, false, channel, ports, gin::ConvertToV8(isolate, args),
-               0);
+  EmitIPCEvent(context, false, gin::StringToV8(isolate, channel), ports,
+               gin::ConvertToV8(isolate, args), 0);
+}
+
+void ElectronApiServiceImpl::EmitIPCEvent(
+    v8::Local<v8::Context> context,
+    bool internal,
+    v8::Local<v8::String> channel,
+    std::vector<v8::Local<v8::Value>> ports,
+    v8::Local<v8::Value> args,
+    int32_t sender_id) {
+  TRACE_EVENT0("devtools.timeline", "FunctionCall");
+  auto* isolate = context->GetIsolate();
+
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(context);
+  v8::MicrotasksScope script_scope(isolate,
+                                   v8::MicrotasksScope::kRunMicrotasks);
+
+  v8::Local<v8::Object> ipc_native;
+  v8::Local<v8::Function> on_message;
+  if (!GetIpcCallback(context, &ipc_native, &on_message))
+    return;
+
+  // Only set up the node::CallbackScope if there's a node environment.
+  // Sandboxed renderers don't have a node environment.
+  node::Environment* env = node::Environment::GetCurrent(context);
+  std::unique_ptr<node::CallbackScope> callback_scope;
+  if (env) {
+    callback_scope.reset(new node::CallbackScope(isolate, ipc_native, {0, 0}));
+  }
+
+  std::vector<v8::Local<v8::Value>> argv = {
+      gin::ConvertToV8(isolate, internal), channel,
+      gin::ConvertToV8(isolate, ports), args,
+      gin::ConvertToV8(isolate, sender_id)};
+
+  ignore_result(
+      on_message->Call(context, ipc_native, argv.size(), argv.data()));
+}
+
+bool ElectronApiServiceImpl::GetIpcCallback(
+    v8::Local<v8::Context> context,
+    v8::Local<v8::Object>* ipc_native,
+    v8::Local<v8::Function>* on_message) {
+  auto* isolate = context->GetIsolate();
+  if (!ipc_context_.IsEmpty() && ipc_context_ == context) {
+    *ipc_native = ipc_native_.Get(isolate);
+    *on_message = ipc_on_message_.Get(isolate);
+    return true;
+  }
+
+  auto object = GetIpcObject(context);
+  if (object.IsEmpty())
+    return false;
+
+  auto callback_value =
+      object->Get(context, gin::StringToSymbol(isolate, "onMessage"))
+          .ToLocalChecked();
+  DCHECK(callback_value->IsFunction());  // set by init.ts
+  if (!callback_value->IsFunction())
+    return false;
+
+  ipc_context_.Reset(isolate, context);
+  ipc_native_.Reset(isolate, object);
+  ipc_on_message_.Reset(isolate, callback_value.As<v8::Function>());
+  *ipc_native = object;
+  *on_message = callback_value.As<v8::Function>();
+  return true;
 }
 
 void ElectronApiServiceImpl::TakeHeapSnapshot(
     mojo::ScopedHandle file,
+    bool gzip,
+    mojo::PendingRemote<mojom::HeapSnapshotObserver> observer,
     TakeHeapSnapshotCallback callback) {
   base::ThreadRestrictions::ScopedAllowIO allow_io;
 
@@ -210,12 +290,53 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
     std::move(callback).Run(false);
     return;
   }
-  base::File base_file(std::move(platform_file));
 
-  bool success =
-      electron::TakeHeapSnapshot(blink::MainThreadIsolate(), &base_file);
+  HeapSnapshotOptions options;
+  options.gzip = gzip;
+  mojo::Remote<mojom::HeapSnapshotObserver> observer_remote(
+      std::move(observer));
+  electron::TakeHeapSnapshotAsync(
+      blink::MainThreadIsolate(), base::File(std::move(platform_file)),
+      options, GetHeapSnapshotProgressCallback(&observer_remote),
+      std::move(callback));
+}
+
+void ElectronApiServiceImpl::StreamHeapSnapshot(
+    mojo::ScopedDataPipeProducerHandle stream,
+    bool gzip,
+    mojo::PendingRemote<mojom::HeapSnapshotObserver> observer,
+    StreamHeapSnapshotCallback callback) {
+  HeapSnapshotOptions options;
+  options.gzip = gzip;
+  mojo::Remote<mojom::HeapSnapshotObserver> observer_remote(
+      std::move(observer));
+  electron::TakeHeapSnapshotAsync(
+      blink::MainThreadIsolate(), std::move(stream), options,
+      GetHeapSnapshotProgressCallback(&observer_remote), std::move(callback));
+}
+
+void ElectronApiServiceImpl::StartSamplingHeapProfiler(
+    uint64_t sample_interval,
+    int32_t stack_depth,
+    StartSamplingHeapProfilerCallback callback) {
+  std::move(callback).Run(electron::StartSamplingHeapProfiler(
+      blink::MainThreadIsolate(), sample_interval, stack_depth));
+}
+
+void ElectronApiServiceImpl::StopSamplingHeapProfiler(
+    StopSamplingHeapProfilerCallback callback) {
+  std::move(callback).Run(
+      electron::StopSamplingHeapProfiler(blink::MainThreadIsolate()));
+}
+
+void ElectronApiServiceImpl::StartCpuProfile(int32_t sampling_interval_us,
+                                             StartCpuProfileCallback callback) {
+  std::move(callback).Run(electron::StartCpuProfile(
+      blink::MainThreadIsolate(), sampling_interval_us));
+}
 
-  std::move(callback).Run(success);
+void ElectronApiServiceImpl::StopCpuProfile(StopCpuProfileCallback callback) {
+  std::move(callback).Run(electron::StopCpuProfile(blink::MainThreadIsolate()));
 }
 
 }  // namespace electron
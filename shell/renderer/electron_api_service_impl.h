@@ -7,6 +7,7 @@
 
 #include <queue>
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "content/public/renderer/render_frame.h"
@@ -15,6 +16,8 @@
 #include "electron/shell/common/api/api.mojom.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/receiver.h"
+#include "shell/common/ipc_channel_table.h"
+#include "v8/include/v8.h"
 
 namespace electron {
 
@@ -29,14 +32,33 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
 
   void BindTo(mojo::PendingReceiver<mojom::ElectronRenderer> receiver);
 
+  void RegisterChannel(uint32_t channel_id,
+                       const std::string& channel) override;
   void Message(bool internal,
-               const std::string& channel,
+               mojom::IPCChannelPtr ipc_channel,
                blink::CloneableMessage arguments,
                int32_t sender_id) override;
   void ReceivePostMessage(const std::string& channel,
                           blink::TransferableMessage message) override;
-  void TakeHeapSnapshot(mojo::ScopedHandle file,
-                        TakeHeapSnapshotCallback callback) override;
+  void TakeHeapSnapshot(
+      mojo::ScopedHandle file,
+      bool gzip,
+      mojo::PendingRemote<mojom::HeapSnapshotObserver> observer,
+      TakeHeapSnapshotCallback callback) override;
+  void StreamHeapSnapshot(
+      mojo::ScopedDataPipeProducerHandle stream,
+      bool gzip,
+      mojo::PendingRemote<mojom::HeapSnapshotObserver> observer,
+      StreamHeapSnapshotCallback callback) override;
+  void StartSamplingHeapProfiler(
+      uint64_t sample_interval,
+      int32_t stack_depth,
+      StartSamplingHeapProfilerCallback callback) override;
+  void StopSamplingHeapProfiler(
+      StopSamplingHeapProfilerCallback callback) override;
+  void StartCpuProfile(int32_t sampling_interval_us,
+                       StartCpuProfileCallback callback) override;
+  void StopCpuProfile(StopCpuProfileCallback callback) override;
   void ProcessPendingMessages();
 
   base::WeakPtr<ElectronApiServiceImpl> GetWeakPtr() {
@@ -50,10 +72,29 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
  private:
   // RenderFrameObserver implementation.
   void DidCreateDocumentElement() override;
+  void WillReleaseScriptContext(v8::Local<v8::Context> context,
+                                int32_t world_id) override;
   void OnDestruct() override;
 
   void OnConnectionError();
 
+  // Binds |receiver_|, dropping channels registered on a previous connection.
+  void BindReceiver(mojo::PendingReceiver<mojom::ElectronRenderer> receiver);
+
+  // Calls ipcNative.onMessage in |context|.
+  void EmitIPCEvent(v8::Local<v8::Context> context,
+                    bool internal,
+                    v8::Local<v8::String> channel,
+                    std::vector<v8::Local<v8::Value>> ports,
+                    v8::Local<v8::Value> args,
+                    int32_t sender_id);
+
+  // Looks up ipcNative and its onMessage function in |context|, reusing the
+  // handles found for the previous message when the context is unchanged.
+  bool GetIpcCallback(v8::Local<v8::Context> context,
+                      v8::Local<v8::Object>* ipc_native,
+                      v8::Local<v8::Function>* on_message);
+
   // Whether the DOM document element has been created.
   bool document_created_ = false;
   service_manager::BinderRegistry registry_;
@@ -61,6 +102,16 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
   mojo::PendingReceiver<mojom::ElectronRenderer> pending_receiver_;
   mojo::Receiver<mojom::ElectronRenderer> receiver_{this};
 
+  // Channels registered by the browser on |receiver_|, along with their
+  // V8 strings so they are only converted once.
+  IPCChannelTable channels_;
+  std::vector<v8::Global<v8::String>> v8_channels_;
+
+  // Cached ipcNative object and onMessage function of |ipc_context_|.
+  v8::Global<v8::Context> ipc_context_;
+  v8::Global<v8::Object> ipc_native_;
+  v8::Global<v8::Function> ipc_on_message_;
+
   RendererClientBase* renderer_client_;
   base::WeakPtrFactory<ElectronApiServiceImpl> weak_factory_{this};
 
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/buildflags/buildflags.h"
 #include "shell/common/api/electron_bindings.h"
@@ -56,6 +57,21 @@ ElectronRendererClient* ElectronRendererClient::Get() {
   return self_;
 }
 
+void ElectronRendererClient::RenderThreadStarted() {
+  RendererClientBase::RenderThreadStarted();
+
+  // Spare renderers are launched before any page needs them, so do the per
+  // process part of the Node.js setup now rather than when the first page
+  // creates its script context.
+  if (base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kSpareRenderer)) {
+    TRACE_EVENT0("electron.node", "ElectronRendererClient::PrewarmNode");
+    node_integration_initialized_ = true;
+    node_bindings_->Initialize();
+    node_bindings_->PrepareMessageLoop();
+  }
+}
+
 void ElectronRendererClient::RenderFrameCreated(
     content::RenderFrame* render_frame) {
   new ElectronRenderFrameObserver(render_frame, this);
@@ -115,6 +131,8 @@ void ElectronRendererClient::DidCreateScriptContext(
   if (!should_load_node)
     return;
 
+  TRACE_EVENT0("electron.preload",
+               "ElectronRendererClient::DidCreateScriptContext");
   injected_frames_.insert(render_frame);
 
   if (!node_integration_initialized_) {
@@ -237,10 +255,6 @@ void ElectronRendererClient::SetupMainWorldOverrides(
   // Wrap the bundle into a function that receives the isolatedWorld as
   // an argument.
   auto* isolate = context->GetIsolate();
-  std::vector<v8::Local<v8::String>> isolated_bundle_params = {
-      node::FIXED_ONE_BYTE_STRING(isolate, "nodeProcess"),
-      node::FIXED_ONE_BYTE_STRING(isolate, "isolatedWorld")};
-
   auto* env = GetEnvironment(render_frame);
   DCHECK(env);
 
@@ -249,7 +263,7 @@ void ElectronRendererClient::SetupMainWorldOverrides(
       GetContext(render_frame->GetWebFrame(), isolate)->Global()};
 
   util::CompileAndCall(context, "electron/js2c/isolated_bundle",
-                       &isolated_bundle_params, &isolated_bundle_args, nullptr);
+                       &isolated_bundle_args, nullptr);
 }
 
 node::Environment* ElectronRendererClient::GetEnvironment(
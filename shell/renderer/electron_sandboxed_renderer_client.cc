@@ -9,6 +9,7 @@
 #include "base/files/file_path.h"
 #include "base/path_service.h"
 #include "base/process/process_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/buildflags/buildflags.h"
 #include "shell/common/api/electron_bindings.h"
@@ -212,6 +213,8 @@ void ElectronSandboxedRendererClient::DidCreateScriptContext(
   if (!should_load_preload)
     return;
 
+  TRACE_EVENT0("electron.preload",
+               "ElectronSandboxedRendererClient::DidCreateScriptContext");
   injected_frames_.insert(render_frame);
 
   // Wrap the bundle into a function that receives the binding object as
@@ -220,14 +223,11 @@ void ElectronSandboxedRendererClient::DidCreateScriptContext(
   auto binding = v8::Object::New(isolate);
   InitializeBindings(binding, context, render_frame);
 
-  std::vector<v8::Local<v8::String>> sandbox_preload_bundle_params = {
-      node::FIXED_ONE_BYTE_STRING(isolate, "binding")};
-
   std::vector<v8::Local<v8::Value>> sandbox_preload_bundle_args = {binding};
 
   util::CompileAndCall(
       isolate->GetCurrentContext(), "electron/js2c/sandbox_bundle",
-      &sandbox_preload_bundle_params, &sandbox_preload_bundle_args, nullptr);
+      &sandbox_preload_bundle_args, nullptr);
 
   v8::HandleScope handle_scope(isolate);
   v8::Context::Scope context_scope(context);
@@ -250,16 +250,12 @@ void ElectronSandboxedRendererClient::SetupMainWorldOverrides(
   gin_helper::Dictionary process = gin::Dictionary::CreateEmpty(isolate);
   process.SetMethod("_linkedBinding", GetBinding);
 
-  std::vector<v8::Local<v8::String>> isolated_bundle_params = {
-      node::FIXED_ONE_BYTE_STRING(isolate, "nodeProcess"),
-      node::FIXED_ONE_BYTE_STRING(isolate, "isolatedWorld")};
-
   std::vector<v8::Local<v8::Value>> isolated_bundle_args = {
       process.GetHandle(),
       GetContext(render_frame->GetWebFrame(), isolate)->Global()};
 
   util::CompileAndCall(context, "electron/js2c/isolated_bundle",
-                       &isolated_bundle_params, &isolated_bundle_args, nullptr);
+                       &isolated_bundle_args, nullptr);
 }
 
 void ElectronSandboxedRendererClient::WillReleaseScriptContext(
@@ -1681,6 +1681,28 @@ describe('default behavior', () => {
     });
   });
 
+  describe('app.enableStallDetection()', () => {
+    afterEach(() => {
+      app.disableStallDetection();
+    });
+
+    it('emits main-thread-stall with the blocking JavaScript stack', async () => {
+      app.enableStallDetection({ threshold: 100 });
+      const stalled = emittedOnce(app, 'main-thread-stall');
+      setTimeout(function blockMainThread () {
+        const end = Date.now() + 500;
+        while (Date.now() < end);
+      }, 0);
+      const [, details] = await stalled;
+      expect(details.duration).to.be.at.least(100);
+      expect(details.stack).to.include('blockMainThread');
+    });
+
+    it('throws on a non-positive threshold', () => {
+      expect(() => app.enableStallDetection({ threshold: 0 })).to.throw(/threshold must be a positive number/);
+    });
+  });
+
   describe('login event', () => {
     afterEach(closeAllWindows);
     let server: http.Server;
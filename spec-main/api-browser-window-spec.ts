@@ -9,7 +9,7 @@ import { AddressInfo } from 'net';
 import { app, BrowserWindow, BrowserView, ipcMain, OnBeforeSendHeadersListenerDetails, protocol, screen, webContents, session, WebContents, BrowserWindowConstructorOptions } from 'electron/main';
 
 import { emittedOnce, emittedUntil } from './events-helpers';
-import { ifit, ifdescribe, defer, delay } from './spec-helpers';
+import { ifit, ifdescribe, defer, delay, runJsonApp } from './spec-helpers';
 import { closeWindow, closeAllWindows } from './window-helpers';
 
 const features = process._linkedBinding('electron_common_features');
@@ -3226,6 +3226,50 @@ describe('BrowserWindow module', () => {
     });
   });
 
+  describe('startRecording method', () => {
+    afterEach(closeAllWindows);
+    const webmHeader = Buffer.from([0x1a, 0x45, 0xdf, 0xa3]);
+
+    it('writes a WebM file', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
+      const videoPath = path.join(os.tmpdir(), `electron-recording-${process.pid}.webm`);
+      defer(() => fs.unlinkSync(videoPath));
+      w.webContents.startRecording({ path: videoPath, codec: 'vp9', frameRate: 10 });
+      await delay(1000);
+      await w.webContents.stopRecording();
+      const video = fs.readFileSync(videoPath);
+      expect(video.slice(0, 4)).to.deep.equal(webmHeader);
+      expect(video.length).to.be.greaterThan(webmHeader.length);
+    });
+
+    it('streams the video via the recording-data event', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
+      const chunks: Buffer[] = [];
+      w.webContents.on('recording-data', (event, chunk) => chunks.push(chunk));
+      w.webContents.startRecording();
+      await delay(1000);
+      await w.webContents.stopRecording();
+      expect(chunks).to.not.be.empty();
+      expect(Buffer.concat(chunks).slice(0, 4)).to.deep.equal(webmHeader);
+    });
+
+    it('rejects invalid options', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => w.webContents.startRecording({ codec: 'h264' as any })).to.throw(/Unsupported codec/);
+      expect(() => w.webContents.startRecording({ frameRate: 0 })).to.throw(/frameRate/);
+    });
+
+    it('only allows one recording at a time', async () => {
+      const w = new BrowserWindow({ show: false });
+      w.webContents.startRecording();
+      expect(() => w.webContents.startRecording()).to.throw(/already in progress/);
+      await w.webContents.stopRecording();
+      await expect(w.webContents.stopRecording()).to.eventually.be.rejectedWith(/No recording/);
+    });
+  });
+
   describe('savePage method', () => {
     const savePageDir = path.join(fixtures, 'save_page');
     const savePageHtmlPath = path.join(savePageDir, 'save_page.html');
@@ -4523,5 +4567,76 @@ describe('BrowserWindow module', () => {
         expect(w.webContents.frameRate).to.equal(30);
       });
     });
+
+    describe('onDemandFrames', () => {
+      it('paints after requestFrame() once the page is idle', async () => {
+        const c = new BrowserWindow({
+          width: 100,
+          height: 100,
+          show: false,
+          webPreferences: { offscreen: true, onDemandFrames: true }
+        });
+        await c.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+        await delay(500);
+
+        const paint = emittedOnce(c.webContents, 'paint');
+        c.webContents.requestFrame();
+        const [,, image] = await paint;
+        expect(image.isEmpty()).to.be.false('image is empty');
+        c.destroy();
+      });
+
+      it('paints changes the page makes on its own while idle', async () => {
+        const c = new BrowserWindow({
+          width: 100,
+          height: 100,
+          show: false,
+          webPreferences: { offscreen: true, onDemandFrames: true }
+        });
+        await c.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+        await delay(500);
+
+        const paint = emittedOnce(c.webContents, 'paint');
+        await c.webContents.executeJavaScript("setTimeout(() => { document.body.style.background = 'red'; }, 100)");
+        const [,, image] = await paint;
+        expect(image.isEmpty()).to.be.false('image is empty');
+        c.destroy();
+      });
+
+      it('uses less CPU per idle view than continuous frame production', async function () {
+        this.timeout(120000);
+        const appPath = path.join(__dirname, 'fixtures', 'apps', 'osr-idle-cpu', 'main.js');
+        const continuous = await runJsonApp([appPath, '10']);
+        const onDemand = await runJsonApp([appPath, '10', '--on-demand']);
+        console.log(`idle OSR CPU per view (%), continuous: ${continuous.cpuPerView}, on-demand: ${onDemand.cpuPerView}`);
+        expect(onDemand.cpuPerView).to.be.at.most(continuous.cpuPerView);
+      });
+    });
+
+    describe('paint mode APIs', () => {
+      it('defaults to frame', () => {
+        expect(w.webContents.getPaintMode()).to.equal('frame');
+      });
+
+      it('throws on an invalid mode', () => {
+        expect(() => w.webContents.setPaintMode('foo' as any)).to.throw(/Invalid paint mode/);
+      });
+
+      it('delivers images of the dirty rect size in dirty-rects mode', async () => {
+        const domReady = emittedOnce(w.webContents, 'dom-ready');
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+        await domReady;
+
+        w.webContents.setPaintMode('dirty-rects');
+        expect(w.webContents.getPaintMode()).to.equal('dirty-rects');
+
+        const [, dirtyRect, image] = await emittedOnce(w.webContents, 'paint');
+        expect(image.getSize()).to.deep.equal({ width: dirtyRect.width, height: dirtyRect.height });
+
+        const stats = w.webContents.getPaintStats();
+        expect(stats.deliveredBytes).to.be.greaterThan(0);
+        expect(stats.deliveredBytes).to.be.at.most(stats.fullFrameBytes);
+      });
+    });
   });
 });
@@ -1,8 +1,9 @@
 import { expect } from 'chai';
-import { app, contentTracing, TraceConfig, TraceCategoriesAndOptions } from 'electron/main';
+import { app, BrowserWindow, contentTracing, TraceConfig, TraceCategoriesAndOptions } from 'electron/main';
 import * as fs from 'fs';
 import * as path from 'path';
 import { ifdescribe, delay } from './spec-helpers';
+import { closeAllWindows } from './window-helpers';
 
 // FIXME: The tests are skipped on arm/arm64.
 ifdescribe(!(['arm', 'arm64'].includes(process.arch)))('contentTracing', () => {
@@ -149,5 +150,21 @@ ifdescribe(!(['arm', 'arm64'].includes(process.arch)))('contentTracing', () => {
       const parsed = JSON.parse(data);
       expect(parsed.traceEvents.some((x: any) => x.cat === 'disabled-by-default-v8.cpu_profiler' && x.name === 'ProfileChunk')).to.be.true();
     });
+
+    describe('from electron categories', () => {
+      afterEach(closeAllWindows);
+
+      it('include window creation', async () => {
+        await contentTracing.startRecording({
+          categoryFilter: 'electron.window',
+          traceOptions: 'record-until-full'
+        });
+        const w = new BrowserWindow({ show: false });
+        await w.loadURL('about:blank');
+        const path = await contentTracing.stopRecording();
+        const parsed = JSON.parse(fs.readFileSync(path, 'utf8'));
+        expect(parsed.traceEvents.some((x: any) => x.cat === 'electron.window' && x.name === 'BrowserWindow::New')).to.be.true();
+      });
+    });
   });
 });
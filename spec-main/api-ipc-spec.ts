@@ -196,6 +196,81 @@ describe('ipc module', () => {
       expect(received).to.have.lengthOf(1000);
       expect(received).to.deep.equal([...received].sort((a, b) => a - b));
     });
+
+    it('is preserved when new channels are interleaved with known ones', async () => {
+      const received: string[] = [];
+      const channels = Array.from({ length: 20 }, (_, i) => `test-channel-${i}`);
+      for (const channel of channels) {
+        ipcMain.on(channel, (e, i) => { received.push(`${channel}:${i}`); });
+      }
+      const done = new Promise<void>(resolve => ipcMain.once('done', () => { resolve(); }));
+      function rendererSend (channels: string[]) {
+        const { ipcRenderer } = require('electron');
+        for (let i = 0; i < 100; i++) {
+          ipcRenderer.send(channels[i % channels.length], i);
+        }
+        ipcRenderer.send('done');
+      }
+      try {
+        w.webContents.executeJavaScript(`(${rendererSend})(${JSON.stringify(channels)})`);
+        await done;
+      } finally {
+        for (const channel of channels) {
+          ipcMain.removeAllListeners(channel);
+        }
+      }
+      expect(received).to.deep.equal(Array.from({ length: 100 }, (_, i) => `${channels[i % channels.length]}:${i}`));
+    });
+
+    it('is preserved past the number of channels a connection caches', async () => {
+      const received: string[] = [];
+      const channels = Array.from({ length: 1100 }, (_, i) => `test-many-channels-${i}`);
+      for (const channel of channels) {
+        ipcMain.on(channel, (e, i) => { received.push(`${channel}:${i}`); });
+      }
+      const done = new Promise<void>(resolve => ipcMain.once('done', () => { resolve(); }));
+      function rendererSend (channels: string[]) {
+        const { ipcRenderer } = require('electron');
+        for (let i = 0; i < channels.length; i++) {
+          ipcRenderer.send(channels[i], i);
+        }
+        // Channels past the cache limit are sent by name, send some again.
+        ipcRenderer.send(channels[channels.length - 1], channels.length);
+        ipcRenderer.send(channels[0], channels.length + 1);
+        ipcRenderer.send('done');
+      }
+      try {
+        w.webContents.executeJavaScript(`(${rendererSend})(${JSON.stringify(channels)})`);
+        await done;
+      } finally {
+        for (const channel of channels) {
+          ipcMain.removeAllListeners(channel);
+        }
+      }
+      expect(received).to.deep.equal([
+        ...channels.map((channel, i) => `${channel}:${i}`),
+        `${channels[channels.length - 1]}:${channels.length}`,
+        `${channels[0]}:${channels.length + 1}`
+      ]);
+    });
+
+    it('is preserved past the number of channels a connection caches when sent to the renderer', async () => {
+      const channels = Array.from({ length: 1100 }, (_, i) => `test-many-channels-${i}`);
+      function rendererListen (channels: string[]) {
+        const { ipcRenderer } = require('electron');
+        const received: string[] = [];
+        for (const channel of channels) {
+          ipcRenderer.on(channel, (e: any, i: number) => { received.push(`${channel}:${i}`); });
+        }
+        ipcRenderer.on('done', () => { ipcRenderer.send('received', received); });
+      }
+      await w.webContents.executeJavaScript(`(${rendererListen})(${JSON.stringify(channels)})`);
+      const received = emittedOnce(ipcMain, 'received');
+      channels.forEach((channel, i) => w.webContents.send(channel, i));
+      w.webContents.send('done');
+      const [, messages] = await received;
+      expect(messages).to.deep.equal(channels.map((channel, i) => `${channel}:${i}`));
+    });
   });
 
   describe('MessagePort', () => {
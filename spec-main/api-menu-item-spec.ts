@@ -450,6 +450,57 @@ describe('MenuItems', () => {
     });
   });
 
+  describe('MenuItem native state', () => {
+    it('is kept in sync with the item properties without calling into JS', () => {
+      const menu = Menu.buildFromTemplate([
+        { label: 'a', type: 'checkbox' },
+        { label: 'b', type: 'radio', checked: true },
+        { label: 'c', type: 'radio' }
+      ]) as any;
+      menu._isCommandIdChecked = menu._isCommandIdEnabled = menu._isCommandIdVisible = () => {
+        throw new Error('should not be called');
+      };
+
+      expect(menu.isItemCheckedAt(0)).to.be.false();
+      menu.items[0].checked = true;
+      expect(menu.isItemCheckedAt(0)).to.be.true();
+
+      menu.items[0].enabled = false;
+      expect(menu.isEnabledAt(0)).to.be.false();
+      menu.items[0].visible = false;
+      expect(menu.isVisibleAt(0)).to.be.false();
+
+      expect(menu.isItemCheckedAt(1)).to.be.true();
+      menu.items[2].checked = true;
+      expect(menu.isItemCheckedAt(1)).to.be.false();
+      expect(menu.isItemCheckedAt(2)).to.be.true();
+    });
+
+    it('refreshes the native accelerator when it is changed', () => {
+      const menu = Menu.buildFromTemplate([
+        { label: 'text', accelerator: 'Shift+A' }
+      ]) as any;
+      menu._getAcceleratorForCommandId = () => {
+        throw new Error('should not be called');
+      };
+      const isDarwin = process.platform === 'darwin';
+      expect(menu.getAcceleratorTextAt(0)).to.equal(isDarwin ? '⇧A' : 'Shift+A');
+      menu.items[0].accelerator = 'Shift+B';
+      expect(menu.getAcceleratorTextAt(0)).to.equal(isDarwin ? '⇧B' : 'Shift+B');
+    });
+
+    it('queries items with dynamicState from JS', () => {
+      let enabled = false;
+      const menu = Menu.buildFromTemplate([
+        { label: 'a', dynamicState: true }
+      ]);
+      Object.defineProperty(menu.items[0], 'enabled', { get: () => enabled });
+      expect((menu as any).isEnabledAt(0)).to.be.false();
+      enabled = true;
+      expect((menu as any).isEnabledAt(0)).to.be.true();
+    });
+  });
+
   describe('MenuItem accelerators', () => {
     const isDarwin = () => {
       return (process.platform === 'darwin');
@@ -1,6 +1,10 @@
 import { expect } from 'chai';
 import { net, session, ClientRequest, BrowserWindow, ClientRequestConstructorOptions } from 'electron/main';
+import * as crypto from 'crypto';
+import * as fs from 'fs';
 import * as http from 'http';
+import * as os from 'os';
+import * as path from 'path';
 import * as url from 'url';
 import { AddressInfo, Socket } from 'net';
 import { emittedOnce } from './events-helpers';
@@ -215,6 +219,47 @@ describe('net module', () => {
       expect(chunkIndex).to.be.equal(chunkCount);
     });
 
+    it('should upload a range of a file with uploadFile', async () => {
+      const fileData = randomBuffer(kOneMegaByte);
+      const tmpDir = await fs.promises.mkdtemp(path.join(os.tmpdir(), 'electron-net-spec-'));
+      defer(() => fs.promises.rmdir(tmpDir, { recursive: true }));
+      const filePath = path.join(tmpDir, 'upload.bin');
+      await fs.promises.writeFile(filePath, fileData);
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        request.pipe(response);
+      });
+      const urlRequest = net.request({
+        method: 'POST',
+        url: serverUrl,
+        uploadFile: { path: filePath, offset: kOneKiloByte, length: 2 * kOneKiloByte }
+      });
+      const response = await getResponse(urlRequest);
+      const received = await collectStreamBodyBuffer(response);
+      expect(received.equals(fileData.slice(kOneKiloByte, 3 * kOneKiloByte))).to.be.true();
+    });
+
+    it('should resend a buffered body after a 307 redirect', async () => {
+      const bodyData = randomBuffer(kOneMegaByte);
+      const serverUrl = await respondNTimes.toRoutes({
+        '/redirect': (request, response) => {
+          request.resume();
+          request.on('end', () => {
+            response.statusCode = 307;
+            response.setHeader('Location', '/echo');
+            response.end();
+          });
+        },
+        '/echo': (request, response) => {
+          request.pipe(response);
+        }
+      }, 2);
+      const urlRequest = net.request({ method: 'POST', url: serverUrl + '/redirect' });
+      urlRequest.write(bodyData);
+      const response = await getResponse(urlRequest);
+      const received = await collectStreamBodyBuffer(response);
+      expect(received.equals(bodyData)).to.be.true();
+    });
+
     for (const extraOptions of [{}, { credentials: 'include' }, { useSessionCookies: false, credentials: 'include' }] as ClientRequestConstructorOptions[]) {
       describe(`authentication when ${JSON.stringify(extraOptions)}`, () => {
         it('should emit the login event when 401', async () => {
@@ -1107,6 +1152,108 @@ describe('net module', () => {
       await eventHandlers;
     });
 
+    describe('response body delivery', () => {
+      let tmpDir: string;
+      beforeEach(async () => {
+        tmpDir = await fs.promises.mkdtemp(path.join(os.tmpdir(), 'electron-net-spec-'));
+      });
+      afterEach(async () => {
+        await fs.promises.rmdir(tmpDir, { recursive: true });
+      });
+
+      it('can write the response body to a file', async () => {
+        const bodyData = randomBuffer(kOneMegaByte);
+        const serverUrl = await respondOnce.toSingleURL((request, response) => {
+          response.end(bodyData);
+        });
+        const filePath = path.join(tmpDir, 'body.bin');
+        const urlRequest = net.request({ url: serverUrl, downloadToFile: filePath });
+        const response = await getResponse(urlRequest);
+        const received = await collectStreamBodyBuffer(response);
+        expect(received.length).to.equal(0);
+        expect((await fs.promises.readFile(filePath)).equals(bodyData)).to.be.true();
+      });
+
+      it('verifies downloadHash', async () => {
+        const bodyData = randomBuffer(kOneKiloByte);
+        const serverUrl = await respondNTimes.toSingleURL((request, response) => {
+          response.end(bodyData);
+        }, 2);
+        const digest = crypto.createHash('sha256').update(bodyData).digest('hex');
+
+        const goodPath = path.join(tmpDir, 'good.bin');
+        const goodRequest = net.request({ url: serverUrl, downloadToFile: goodPath, downloadHash: digest.toUpperCase() });
+        await collectStreamBodyBuffer(await getResponse(goodRequest));
+        expect((await fs.promises.readFile(goodPath)).equals(bodyData)).to.be.true();
+
+        const badPath = path.join(tmpDir, 'bad.bin');
+        const badRequest = net.request({ url: serverUrl, downloadToFile: badPath, downloadHash: '0'.repeat(64) });
+        const [, error] = await emittedOnce(badRequest, 'error', () => badRequest.end());
+        expect(error.message).to.match(/does not match/);
+        await delay(100);
+        expect(fs.existsSync(badPath)).to.be.false();
+      });
+
+      it('can deliver the response body as a single buffer', async () => {
+        const bodyData = randomBuffer(kOneMegaByte);
+        const serverUrl = await respondOnce.toSingleURL((request, response) => {
+          response.write(bodyData.slice(0, kOneKiloByte));
+          setTimeout(() => response.end(bodyData.slice(kOneKiloByte)), 50);
+        });
+        const urlRequest = net.request({ url: serverUrl, downloadToBuffer: true });
+        const response = await getResponse(urlRequest);
+        const chunks: Buffer[] = [];
+        response.on('data', (chunk) => chunks.push(chunk));
+        await emittedOnce(response, 'end');
+        expect(chunks).to.have.lengthOf(1);
+        expect(chunks[0].equals(bodyData)).to.be.true();
+      });
+
+      it('throttles download-progress with progressInterval', async () => {
+        const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+          for (let i = 0; i < 10; i++) {
+            response.write(randomBuffer(kOneKiloByte));
+            await delay(20);
+          }
+          response.end();
+        });
+        const urlRequest = net.request({ url: serverUrl, progressInterval: 10000 });
+        const response = await getResponse(urlRequest);
+        const progress: number[] = [];
+        response.on('download-progress', (current) => { progress.push(current); });
+        await collectStreamBodyBuffer(response);
+        expect(progress).to.have.lengthOf.at.most(2);
+        expect(progress[progress.length - 1]).to.equal(10 * kOneKiloByte);
+      });
+
+      it('fails a buffered response larger than downloadMaxSize', async () => {
+        const serverUrl = await respondOnce.toSingleURL((request, response) => {
+          response.end(randomBuffer(kOneKiloByte * 2));
+        });
+        const urlRequest = net.request({ url: serverUrl, downloadToBuffer: true, downloadMaxSize: kOneKiloByte });
+        const [, error] = await emittedOnce(urlRequest, 'error', () => urlRequest.end());
+        expect(error.message).to.match(/exceeds downloadMaxSize/);
+      });
+
+      it('rejects a downloadMaxSize over the buffered body limit', () => {
+        expect(() => net.request({ url: 'https://127.0.0.1', downloadToBuffer: true, downloadMaxSize: 1024 * kOneMegaByte })).to.throw(/downloadMaxSize/);
+      });
+
+      it('deletes the file when the request is cancelled while checking downloadHash', async () => {
+        const bodyData = randomBuffer(kOneMegaByte);
+        const serverUrl = await respondOnce.toSingleURL((request, response) => {
+          response.end(bodyData);
+        });
+        const filePath = path.join(tmpDir, 'cancelled.bin');
+        const urlRequest = net.request({ url: serverUrl, downloadToFile: filePath, downloadHash: '0'.repeat(64) });
+        const response = await getResponse(urlRequest);
+        response.on('data', () => {});
+        urlRequest.abort();
+        await delay(500);
+        expect(fs.existsSync(filePath)).to.be.false();
+      });
+    });
+
     describe('webRequest', () => {
       afterEach(() => {
         session.defaultSession.webRequest.onBeforeRequest(null);
@@ -1137,6 +1284,23 @@ describe('net module', () => {
         }).to.not.throw();
       });
 
+      it('reports the body of a POST request as uploadData bytes', async () => {
+        const bodyData = 'hello world';
+        const serverUrl = await respondOnce.toSingleURL((request, response) => {
+          response.end();
+        });
+        let uploadData: Electron.UploadData[] | undefined;
+        session.defaultSession.webRequest.onBeforeRequest((details, callback) => {
+          if (details.url === serverUrl) uploadData = details.uploadData;
+          callback({});
+        });
+        const urlRequest = net.request({ url: serverUrl, method: 'POST' });
+        urlRequest.write(bodyData);
+        await collectStreamBody(await getResponse(urlRequest));
+        expect(uploadData).to.have.lengthOf(1);
+        expect(uploadData![0].bytes.toString()).to.equal(bodyData);
+      });
+
       it('Requests should be intercepted by webRequest module', async () => {
         const requestUrl = '/requestUrl';
         const redirectUrl = '/redirectUrl';
@@ -3,6 +3,7 @@ import * as http from 'http';
 import * as https from 'https';
 import * as path from 'path';
 import * as fs from 'fs';
+import * as os from 'os';
 import * as ChildProcess from 'child_process';
 import { app, session, BrowserWindow, net, ipcMain, Session } from 'electron/main';
 import * as send from 'send';
@@ -368,6 +369,27 @@ describe('session module', () => {
       expect(proxy).to.equal('PROXY myproxy:80');
     });
 
+    it('resolves concurrent lookups and caches results per host', async () => {
+      customSession.setProxyResolverOptions({ maxConcurrentLookups: 2, cacheTTL: 60 * 1000 });
+      try {
+        await customSession.setProxy({ proxyRules: 'http=myproxy:80' });
+        const urls = ['http://a.example.com/', 'http://b.example.com/', 'http://c.example.com/'];
+        const proxies = await Promise.all(urls.map(url => customSession.resolveProxy(url)));
+        expect(proxies).to.deep.equal(urls.map(() => 'PROXY myproxy:80'));
+
+        const { lookups } = customSession.getProxyResolverStats();
+        expect(await customSession.resolveProxy('http://a.example.com/other')).to.equal('PROXY myproxy:80');
+        const stats = customSession.getProxyResolverStats();
+        expect(stats.lookups).to.equal(lookups);
+        expect(stats.cacheHits).to.be.at.least(1);
+
+        await customSession.setProxy({ proxyRules: 'http=otherproxy:80' });
+        expect(await customSession.resolveProxy('http://a.example.com/')).to.equal('PROXY otherproxy:80');
+      } finally {
+        customSession.setProxyResolverOptions({ cacheTTL: 0 });
+      }
+    });
+
     it('allows removing the implicit bypass rules for localhost', async () => {
       const config = {
         proxyRules: 'http=myproxy:80',
@@ -740,6 +762,89 @@ describe('session module', () => {
       session.defaultSession.downloadURL(`${url}:${port}`);
     });
 
+    it('emits aggregated download-progress when enabled', async () => {
+      const slowServer = http.createServer(async (req, res) => {
+        res.writeHead(200, {
+          'Content-Length': 10 * 1024,
+          'Content-Type': 'application/octet-stream',
+          'Content-Disposition': 'attachment; filename="slow.bin"'
+        });
+        for (let i = 0; i < 10; i++) {
+          res.write(Buffer.alloc(1024));
+          await delay(100);
+        }
+        res.end();
+      });
+      await new Promise<void>(resolve => slowServer.listen(0, '127.0.0.1', resolve));
+      defer(() => slowServer.close());
+      const { port } = slowServer.address() as AddressInfo;
+
+      const ses = session.fromPartition('download-progress-spec');
+      ses.setDownloadProgressOptions({ interval: 50, emitItemUpdates: false });
+      const savePath = path.join(os.tmpdir(), `download-progress-${Date.now()}.bin`);
+      let updated = 0;
+      ses.once('will-download', (e, item) => {
+        item.savePath = savePath;
+        item.on('updated', () => { updated++; });
+      });
+      const progressEvents: Electron.DownloadProgress[] = [];
+      ses.on('download-progress', (e, progress) => progressEvents.push(progress));
+      ses.downloadURL(`${url}:${port}`);
+      const [, item] = await emittedOnce(ses, 'will-download');
+      await emittedOnce(item, 'done');
+      ses.removeAllListeners('download-progress');
+      fs.unlinkSync(savePath);
+
+      expect(updated).to.equal(0);
+      expect(progressEvents).to.not.be.empty();
+      const last = progressEvents[progressEvents.length - 1];
+      expect(last.items).to.have.lengthOf(1);
+      expect(last.items[0].item).to.equal(item);
+      expect(last.totalBytes).to.equal(10 * 1024);
+      expect(last.bytesPerSecond).to.be.a('number');
+    });
+
+    it('emits download-progress again for a resumed download', async () => {
+      const slowServer = http.createServer(async (req, res) => {
+        res.writeHead(200, {
+          'Content-Length': 4 * 1024,
+          'Content-Type': 'application/octet-stream'
+        });
+        for (let i = 0; i < 4; i++) {
+          res.write(Buffer.alloc(1024));
+          await delay(100);
+        }
+        res.end();
+      });
+      await new Promise<void>(resolve => slowServer.listen(0, '127.0.0.1', resolve));
+      defer(() => slowServer.close());
+      const { port } = slowServer.address() as AddressInfo;
+
+      const ses = session.fromPartition('download-progress-resume-spec');
+      ses.setDownloadProgressOptions({ interval: 50 });
+      const savePath = path.join(os.tmpdir(), `download-progress-resume-${Date.now()}.bin`);
+      const willDownload = emittedOnce(ses, 'will-download');
+      ses.createInterruptedDownload({
+        path: savePath,
+        urlChain: [`${url}:${port}/`],
+        offset: 0,
+        length: 4 * 1024
+      });
+      const [, item] = await willDownload;
+      // Let the progress timer notice that nothing is in progress and stop.
+      await delay(200);
+
+      const progressEvents: Electron.DownloadProgress[] = [];
+      ses.on('download-progress', (e, progress) => progressEvents.push(progress));
+      defer(() => ses.removeAllListeners('download-progress'));
+      item.resume();
+      await emittedOnce(item, 'done');
+      if (fs.existsSync(savePath)) fs.unlinkSync(savePath);
+
+      expect(item.getState()).to.equal('completed');
+      expect(progressEvents).to.not.be.empty();
+    });
+
     it('can download using WebContents.downloadURL', (done) => {
       const port = address.port;
       const w = new BrowserWindow({ show: false });
@@ -993,6 +1098,72 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.setPermissionCheckHandler(handler)', () => {
+    afterEach(closeAllWindows);
+    it('caches decisions returned with a lifetime', async () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          partition: 'very-temp-permission-check-handler'
+        }
+      });
+      const ses = w.webContents.session;
+      let handlerCalls = 0;
+      ses.setPermissionCheckHandler((wc, permission) => {
+        if (permission === 'geolocation') handlerCalls++;
+        return { granted: true, cacheFor: Infinity };
+      });
+
+      await w.loadFile(path.join(fixtures, 'pages', 'blank.html'));
+      const query = () => w.webContents.executeJavaScript('navigator.permissions.query({ name: \'geolocation\' }).then(s => s.state)');
+      expect(await query()).to.equal('granted');
+      expect(await query()).to.equal('granted');
+      expect(handlerCalls).to.equal(1);
+      expect(ses.getPermissionDecisionStats().hits).to.be.at.least(1);
+
+      ses.clearPermissionDecisions();
+      expect(ses.getPermissionDecisionStats().entries).to.equal(0);
+      expect(await query()).to.equal('granted');
+      expect(handlerCalls).to.equal(2);
+    });
+
+    it('does not reuse a cached decision for another webContents', async () => {
+      const partition = `${Math.random()}`;
+      const w1 = new BrowserWindow({ show: false, webPreferences: { partition } });
+      const w2 = new BrowserWindow({ show: false, webPreferences: { partition } });
+      const ses = w1.webContents.session;
+      const askedBy: number[] = [];
+      ses.setPermissionCheckHandler((wc, permission) => {
+        if (permission !== 'geolocation') return false;
+        askedBy.push(wc!.id);
+        return { granted: wc === w1.webContents, cacheFor: Infinity };
+      });
+
+      await w1.loadFile(path.join(fixtures, 'pages', 'blank.html'));
+      await w2.loadFile(path.join(fixtures, 'pages', 'blank.html'));
+      const query = (w: BrowserWindow) => w.webContents.executeJavaScript('navigator.permissions.query({ name: \'geolocation\' }).then(s => s.state)');
+      expect(await query(w1)).to.equal('granted');
+      expect(await query(w2)).to.not.equal('granted');
+      expect(await query(w2)).to.not.equal('granted');
+      expect(askedBy).to.deep.equal([w1.webContents.id, w2.webContents.id]);
+    });
+
+    it('forgets the decisions of closed pages', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { partition: `${Math.random()}` } });
+      const ses = w.webContents.session;
+      ses.setPermissionCheckHandler(() => ({ granted: true, cacheFor: Infinity }));
+
+      await w.loadFile(path.join(fixtures, 'pages', 'blank.html'));
+      await w.webContents.executeJavaScript('navigator.permissions.query({ name: \'geolocation\' })');
+      expect(ses.getPermissionDecisionStats().entries).to.be.at.least(1);
+
+      const destroyed = emittedOnce(w.webContents, 'destroyed');
+      w.destroy();
+      await destroyed;
+      expect(ses.getPermissionDecisionStats().entries).to.equal(0);
+    });
+  });
+
   describe('ses.setPermissionRequestHandler(handler)', () => {
     afterEach(closeAllWindows);
     it('cancels any pending requests when cleared', async () => {
@@ -1053,6 +1224,185 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.setRendererMemoryBudget()', () => {
+    afterEach(closeAllWindows);
+
+    it('throws without a positive limit', () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      expect(() => ses.setRendererMemoryBudget({} as any)).to.throw(/positive limit/);
+      expect(() => ses.setRendererMemoryBudget({ limit: 0 })).to.throw(/positive limit/);
+    });
+
+    it('reports no metrics without a budget', () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      expect(ses.getRendererMemoryMetrics()).to.be.null();
+    });
+
+    it('discards hidden pages chosen by the policy when over the budget', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL('about:blank');
+
+      const policyCalled = new Promise<any[]>(resolve => {
+        ses.setRendererMemoryBudget({
+          limit: 1,
+          interval: 100,
+          policy: (candidates) => {
+            resolve(candidates);
+            return candidates.map(c => c.webContents);
+          }
+        });
+      });
+      const discarded = emittedOnce(w.webContents, 'discarded');
+      const candidates = await policyCalled;
+      expect(candidates).to.have.lengthOf(1);
+      expect(candidates[0].webContents).to.equal(w.webContents);
+      expect(candidates[0].privateMemory).to.be.a('number').that.is.greaterThan(0);
+      expect(candidates[0].lastActiveTime).to.be.a('number');
+      await discarded;
+
+      const metrics = ses.getRendererMemoryMetrics()!;
+      expect(metrics.limit).to.equal(1);
+      expect(metrics.usage).to.be.greaterThan(1);
+      expect(metrics.pressureEvents).to.be.at.least(1);
+      expect(metrics.discards).to.equal(1);
+      expect(metrics.restores).to.equal(0);
+
+      ses.setRendererMemoryBudget(null);
+      expect(ses.getRendererMemoryMetrics()).to.be.null();
+    });
+  });
+
+  // Spares are launched by a best-effort task after the first paint.
+  const waitForSpare = async (ses: Electron.Session) => {
+    for (let elapsed = 0; ses.getSpareRendererMetrics().spares === 0; elapsed += 50) {
+      if (elapsed >= 10000) {
+        throw new Error('Timed out waiting for a spare renderer to be launched');
+      }
+      await delay(50);
+    }
+  };
+
+  describe('ses.setSpareRendererOptions()', () => {
+    afterEach(closeAllWindows);
+
+    it('starts the next window of a profile on a spare renderer', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      ses.setSpareRendererOptions({ count: 1 });
+      const webPreferences = { session: ses, contextIsolation: false };
+
+      const w1 = new BrowserWindow({ show: false, webPreferences });
+      const ready = emittedOnce(w1, 'ready-to-show');
+      await w1.loadURL('about:blank');
+      await ready;
+      const lastWebPreferences = w1.webContents.getLastWebPreferences();
+      await waitForSpare(ses);
+      expect(w1.webContents.getLastWebPreferences()).to.deep.equal(lastWebPreferences);
+
+      const w2 = new BrowserWindow({ show: false, webPreferences });
+      await w2.loadURL('about:blank');
+      expect(await w2.webContents.executeJavaScript('1 + 1')).to.equal(2);
+      expect(w2.webContents.getOSProcessId()).to.not.equal(w1.webContents.getOSProcessId());
+
+      const metrics = ses.getSpareRendererMetrics();
+      expect(metrics.launched).to.equal(1);
+      expect(metrics.hits).to.equal(1);
+      expect(metrics.misses).to.equal(1);
+      expect(metrics.firstPaintWithoutSpare).to.be.a('number');
+    });
+
+    it('does not hand out spares across profiles', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      ses.setSpareRendererOptions({ count: 1 });
+
+      const w1 = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      const ready = emittedOnce(w1, 'ready-to-show');
+      await w1.loadURL('about:blank');
+      await ready;
+      await waitForSpare(ses);
+
+      const w2 = new BrowserWindow({ show: false, webPreferences: { session: ses, sandbox: true } });
+      await w2.loadURL('about:blank');
+      const metrics = ses.getSpareRendererMetrics();
+      expect(metrics.hits).to.equal(0);
+      expect(metrics.misses).to.equal(2);
+    });
+
+    it('is disabled by default', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL('about:blank');
+      expect(ses.getSpareRendererMetrics()).to.deep.equal({
+        spares: 0, launched: 0, hits: 0, misses: 0, discarded: 0
+      });
+    });
+  });
+
+  describe('ses.setRendererSharingPolicy()', () => {
+    afterEach(closeAllWindows);
+
+    const blankPage = path.join(fixtures, 'pages', 'blank.html');
+
+    it('places pages of a site in its existing renderer over the threshold', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      ses.setRendererSharingPolicy({ sharingThreshold: 1 });
+      const webPreferences = { session: ses };
+
+      const w1 = new BrowserWindow({ show: false, webPreferences });
+      await w1.loadFile(blankPage);
+      const w2 = new BrowserWindow({ show: false, webPreferences });
+      await w2.loadFile(blankPage);
+      expect(w2.webContents.getOSProcessId()).to.equal(w1.webContents.getOSProcessId());
+
+      expect(ses.getRendererSharingMetrics()).to.deep.equal({
+        renderers: 1, webContents: 2, processesSaved: 1, sharedNavigations: 1
+      });
+    });
+
+    it('does not share renderers between incompatible webPreferences', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      ses.setRendererSharingPolicy({ maxRenderers: 1 });
+
+      const w1 = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w1.loadFile(blankPage);
+      const w2 = new BrowserWindow({ show: false, webPreferences: { session: ses, sandbox: true } });
+      await w2.loadFile(blankPage);
+      expect(w2.webContents.getOSProcessId()).to.not.equal(w1.webContents.getOSProcessId());
+      expect(ses.getRendererSharingMetrics().processesSaved).to.equal(0);
+    });
+
+    it('keeps pages that started on a spare renderer in it', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      ses.setRendererSharingPolicy({ sharingThreshold: 1 });
+      ses.setSpareRendererOptions({ count: 1 });
+      const webPreferences = { session: ses };
+
+      const w1 = new BrowserWindow({ show: false, webPreferences });
+      const ready = emittedOnce(w1, 'ready-to-show');
+      await w1.loadFile(blankPage);
+      await ready;
+      await waitForSpare(ses);
+
+      const w2 = new BrowserWindow({ show: false, webPreferences });
+      await w2.loadFile(blankPage);
+      expect(ses.getSpareRendererMetrics().hits).to.equal(1);
+      expect(w2.webContents.getOSProcessId()).to.not.equal(w1.webContents.getOSProcessId());
+      expect(ses.getRendererSharingMetrics().sharedNavigations).to.equal(0);
+    });
+
+    it('is disabled by default', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      const webPreferences = { session: ses };
+      const w1 = new BrowserWindow({ show: false, webPreferences });
+      await w1.loadFile(blankPage);
+      const w2 = new BrowserWindow({ show: false, webPreferences });
+      await w2.loadFile(blankPage);
+      expect(ses.getRendererSharingMetrics()).to.deep.equal({
+        renderers: 2, webContents: 2, processesSaved: 0, sharedNavigations: 0
+      });
+    });
+  });
+
   describe('ses.setUserAgent()', () => {
     afterEach(closeAllWindows);
 
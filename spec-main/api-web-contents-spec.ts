@@ -3,6 +3,7 @@ import { AddressInfo } from 'net';
 import * as path from 'path';
 import * as fs from 'fs';
 import * as http from 'http';
+import * as zlib from 'zlib';
 import { BrowserWindow, ipcMain, webContents, session, WebContents, app, BrowserView } from 'electron/main';
 import { clipboard } from 'electron/common';
 import { emittedOnce } from './events-helpers';
@@ -1342,6 +1343,38 @@ describe('webContents module', () => {
     });
   }
 
+  describe('discard()', () => {
+    afterEach(closeAllWindows);
+
+    it('discards a hidden page and reloads it when shown', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { partition: `discard-${Math.random()}` } });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'base-page.html'));
+      const processGone = emittedOnce(w.webContents, 'render-process-gone');
+      const discarded = emittedOnce(w.webContents, 'discarded');
+      expect(w.webContents.discard()).to.equal(true);
+      await discarded;
+      expect(w.webContents.isDiscarded()).to.equal(true);
+      expect(w.webContents.isCrashed()).to.equal(false);
+
+      const restored = emittedOnce(w.webContents, 'restored');
+      const loaded = emittedOnce(w.webContents, 'did-finish-load');
+      w.show();
+      await restored;
+      await loaded;
+      expect(w.webContents.isDiscarded()).to.equal(false);
+      expect(await w.webContents.executeJavaScript('document.wasDiscarded')).to.equal(true);
+      const result = await Promise.race([processGone, delay(100)]);
+      expect(result).to.be.undefined();
+    });
+
+    it('does not discard a visible page', async () => {
+      const w = new BrowserWindow({ show: true });
+      await w.loadURL('about:blank');
+      expect(w.webContents.discard()).to.equal(false);
+      expect(w.webContents.isDiscarded()).to.equal(false);
+    });
+  });
+
   // Destroying webContents in its event listener is going to crash when
   // Electron is built in Debug mode.
   describe('destroy()', () => {
@@ -1654,6 +1687,103 @@ describe('webContents module', () => {
       const promise = w.webContents.takeHeapSnapshot('');
       return expect(promise).to.be.eventually.rejectedWith(Error, 'takeHeapSnapshot failed');
     });
+
+    it('writes gzip-compressed snapshots', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+
+      const filePath = path.join(app.getPath('temp'), 'test.heapsnapshot.gz');
+      defer(() => fs.unlinkSync(filePath));
+
+      let progressed = false;
+      w.webContents.on('heap-snapshot-progress', (event, done, total) => {
+        expect(done).to.be.at.most(total);
+        progressed = true;
+      });
+      await w.webContents.takeHeapSnapshot(filePath, { compression: 'gzip' });
+      const snapshot = JSON.parse(zlib.gunzipSync(fs.readFileSync(filePath)).toString());
+      expect(snapshot).to.have.property('snapshot');
+      expect(progressed).to.be.true('heap-snapshot-progress was not emitted');
+    });
+
+    it('rejects unknown compression', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      expect(() => w.webContents.takeHeapSnapshot('', { compression: 'zip' as any })).to.throw(/Unsupported compression/);
+    });
+  });
+
+  describe('createHeapSnapshotStream()', () => {
+    afterEach(closeAllWindows);
+
+    it('streams the snapshot', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+
+      const chunks: Buffer[] = [];
+      const stream = w.webContents.createHeapSnapshotStream();
+      stream.on('data', (chunk: Buffer) => chunks.push(chunk));
+      await emittedOnce(stream, 'end');
+      const snapshot = JSON.parse(Buffer.concat(chunks).toString());
+      expect(snapshot).to.have.property('snapshot');
+    });
+
+    it('can compress the stream', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+
+      const chunks: Buffer[] = [];
+      const stream = w.webContents.createHeapSnapshotStream({ compression: 'gzip' });
+      stream.on('data', (chunk: Buffer) => chunks.push(chunk));
+      await emittedOnce(stream, 'end');
+      const snapshot = JSON.parse(zlib.gunzipSync(Buffer.concat(chunks)).toString());
+      expect(snapshot).to.have.property('snapshot');
+    });
+
+    it('stops reading from the renderer while the consumer is behind', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+
+      const stream = w.webContents.createHeapSnapshotStream();
+      await delay(1000);
+      expect(stream.readableLength).to.be.below(1024 * 1024);
+
+      const chunks: Buffer[] = [];
+      stream.on('data', (chunk: Buffer) => chunks.push(chunk));
+      await emittedOnce(stream, 'end');
+      const snapshot = JSON.parse(Buffer.concat(chunks).toString());
+      expect(snapshot).to.have.property('snapshot');
+    });
+  });
+
+  describe('sampling profilers', () => {
+    afterEach(closeAllWindows);
+
+    it('records a heap profile of the renderer', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.startSamplingHeapProfiler({ samplingInterval: 1024 });
+      await w.webContents.executeJavaScript('window.retained = Array.from({ length: 1000 }, (_, i) => new Array(100).fill(i)); null');
+      const profile = JSON.parse(await w.webContents.stopSamplingHeapProfiler());
+      expect(profile.head).to.have.property('callFrame');
+      expect(profile.samples).to.not.be.empty();
+    });
+
+    it('records a CPU profile of the renderer', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.startCpuProfile({ samplingInterval: 100 });
+      await w.webContents.executeJavaScript('{ const start = Date.now(); while (Date.now() - start < 50) Math.sqrt(Math.random()); }');
+      const profile = JSON.parse(await w.webContents.stopCpuProfile());
+      expect(profile.nodes).to.not.be.empty();
+      expect(profile.samples).to.have.lengthOf(profile.timeDeltas.length);
+    });
+
+    it('rejects when the profiler is not running', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await expect(w.webContents.stopCpuProfile()).to.eventually.be.rejectedWith(/No CPU profile/);
+    });
   });
 
   describe('setBackgroundThrottling()', () => {
@@ -0,0 +1,19 @@
+// Prints how many compilations of Electron's builtin bundles were given the
+// embedded code cache in the browser process and in a renderer, split by
+// whether V8 accepted it.
+const { app, BrowserWindow } = require('electron');
+
+const v8Util = process._linkedBinding('electron_common_v8_util');
+
+app.whenReady().then(async () => {
+  const w = new BrowserWindow({
+    show: false,
+    webPreferences: { nodeIntegration: true, contextIsolation: false }
+  });
+  await w.loadURL('about:blank');
+  const renderer = await w.webContents.executeJavaScript(
+    "process._linkedBinding('electron_common_v8_util').getBuiltinCodeCacheStats()");
+  const browser = v8Util.getBuiltinCodeCacheStats();
+  process.stdout.write(JSON.stringify({ browser, renderer }) + '\n');
+  app.quit();
+});
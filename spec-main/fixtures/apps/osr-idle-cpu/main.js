@@ -0,0 +1,44 @@
+// Measures the CPU used by idle offscreen views, used to compare continuous
+// and on-demand frame production.
+// Usage: electron main.js [viewCount] [--on-demand]
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+const viewCount = parseInt(process.argv.find(arg => /^\d+$/.test(arg)) || '10', 10);
+const onDemandFrames = process.argv.includes('--on-demand');
+const settleTime = 2000;
+const sampleTime = 5000;
+
+const delay = (ms) => new Promise(resolve => setTimeout(resolve, ms));
+
+app.whenReady().then(async () => {
+  const page = path.resolve(__dirname, '..', '..', '..', '..', 'spec', 'fixtures', 'api', 'offscreen-rendering.html');
+  const windows = [];
+  for (let i = 0; i < viewCount; i++) {
+    const w = new BrowserWindow({
+      show: false,
+      width: 400,
+      height: 300,
+      webPreferences: { offscreen: true, onDemandFrames, backgroundThrottling: false }
+    });
+    await w.loadFile(page);
+    windows.push(w);
+  }
+
+  await delay(settleTime);
+
+  // percentCPUUsage is measured since the previous call.
+  app.getAppMetrics();
+  await delay(sampleTime);
+  const totalCPU = app.getAppMetrics().reduce((sum, metric) => sum + metric.cpu.percentCPUUsage, 0);
+
+  process.stdout.write(JSON.stringify({
+    viewCount,
+    onDemandFrames,
+    totalCPU,
+    cpuPerView: totalCPU / viewCount
+  }) + '\n');
+
+  for (const w of windows) w.destroy();
+  app.quit();
+});
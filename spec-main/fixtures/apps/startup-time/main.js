@@ -0,0 +1,25 @@
+// Measures process startup, used to compare runs with and without the builtin
+// code cache (ELECTRON_DISABLE_BUILTIN_CODE_CACHE=1).
+// Usage: electron main.js
+const { app, BrowserWindow } = require('electron');
+
+// Time from process start until the browser's init script has run.
+const browserInit = process.uptime() * 1000;
+
+// Time from creating a window until its page has loaded, which includes
+// starting the renderer process and running its init script.
+async function measureRenderer (webPreferences) {
+  const start = process.hrtime.bigint();
+  const w = new BrowserWindow({ show: false, webPreferences });
+  await w.loadURL('about:blank');
+  const result = Number(process.hrtime.bigint() - start) / 1e6;
+  w.destroy();
+  return result;
+}
+
+app.whenReady().then(async () => {
+  const renderer = await measureRenderer({ nodeIntegration: true, contextIsolation: false });
+  const sandboxedRenderer = await measureRenderer({ sandbox: true });
+  process.stdout.write(JSON.stringify({ browserInit, renderer, sandboxedRenderer }) + '\n');
+  app.quit();
+});
@@ -0,0 +1,33 @@
+// Queues each immediate from the previous one while tracing the Node.js event
+// loop integration, and reports how many passes every wakeup ran.
+// Usage: electron main.js [--node-loop-max-passes=<passes>]
+const { app, contentTracing } = require('electron');
+const fs = require('fs');
+
+const generations = 200;
+
+function chainImmediates () {
+  return new Promise(resolve => {
+    let remaining = generations;
+    const next = () => {
+      if (--remaining > 0) setImmediate(next);
+      else resolve();
+    };
+    setImmediate(next);
+  });
+}
+
+app.whenReady().then(async () => {
+  await contentTracing.startRecording({
+    categoryFilter: 'electron.node',
+    traceOptions: 'record-until-full'
+  });
+  await chainImmediates();
+  const tracePath = await contentTracing.stopRecording();
+  const { traceEvents } = JSON.parse(fs.readFileSync(tracePath, 'utf8'));
+  const passes = traceEvents
+    .filter(event => event.name === 'NodeBindings::UvRunOnce' && event.ph === 'C')
+    .map(event => Number(event.args.passes));
+  process.stdout.write(JSON.stringify({ passes }) + '\n');
+  app.quit();
+});
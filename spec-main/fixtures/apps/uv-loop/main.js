@@ -0,0 +1,87 @@
+// Runs the kinds of callbacks the Node.js event loop integration has to wake
+// up for, reports the order they ran in and measures how long timer and fs
+// callbacks take to run, to compare the integrations.
+const { app } = require('electron');
+const fs = require('fs');
+const net = require('net');
+
+const iterations = 200;
+
+function percentile (samples, p) {
+  const sorted = [...samples].sort((a, b) => a - b);
+  return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))];
+}
+
+function summarize (samples) {
+  return {
+    mean: samples.reduce((a, b) => a + b, 0) / samples.length,
+    p50: percentile(samples, 0.5),
+    p99: percentile(samples, 0.99)
+  };
+}
+
+async function measureTimers () {
+  const samples = [];
+  for (let i = 0; i < iterations; i++) {
+    const start = process.hrtime.bigint();
+    await new Promise(resolve => setTimeout(resolve, 1));
+    samples.push(Math.max(0, Number(process.hrtime.bigint() - start) / 1e6 - 1));
+  }
+  return summarize(samples);
+}
+
+async function measureFs () {
+  const samples = [];
+  for (let i = 0; i < iterations; i++) {
+    const start = process.hrtime.bigint();
+    await fs.promises.stat(__filename);
+    samples.push(Number(process.hrtime.bigint() - start) / 1e6);
+  }
+  return summarize(samples);
+}
+
+function runTimers () {
+  return new Promise(resolve => {
+    const order = [];
+    const start = Date.now();
+    let immediate = false;
+    setTimeout(() => order.push('timeout 20'), 20);
+    setTimeout(() => order.push('timeout 0'), 0);
+    setImmediate(() => { immediate = true; });
+    setTimeout(() => {
+      order.push('timeout 40');
+      resolve({ order, immediate, elapsedAtLeastDelay: Date.now() - start >= 40 });
+    }, 40);
+  });
+}
+
+function runFs () {
+  return fs.promises.readFile(__filename, 'utf8').then(data => data.length > 0);
+}
+
+function runSocket () {
+  return new Promise((resolve, reject) => {
+    const server = net.createServer(socket => socket.pipe(socket));
+    server.listen(0, '127.0.0.1', () => {
+      const client = net.connect(server.address().port, '127.0.0.1', () => client.end('ping'));
+      let echo = '';
+      client.on('data', data => { echo += data; });
+      client.on('end', () => { server.close(); resolve(echo); });
+      client.on('error', reject);
+    });
+  });
+}
+
+app.whenReady().then(async () => {
+  const result = {
+    timers: await runTimers(),
+    fs: await runFs(),
+    socket: await runSocket(),
+    latency: {
+      timers: await measureTimers(),
+      fs: await measureFs()
+    }
+  };
+  process.stdout.write(JSON.stringify(result) + '\n');
+  app.quit();
+});
@@ -3,7 +3,7 @@ import * as childProcess from 'child_process';
 import * as path from 'path';
 import * as util from 'util';
 import { emittedOnce } from './events-helpers';
-import { ifdescribe, ifit } from './spec-helpers';
+import { ifdescribe, ifit, runJsonApp } from './spec-helpers';
 import { webContents, WebContents } from 'electron/main';
 
 const features = process._linkedBinding('electron_common_features');
@@ -33,6 +33,138 @@ describe('node feature', () => {
     expect(code).to.equal(0);
   });
 
+  ifdescribe(process.platform === 'linux')('event loop integration', () => {
+    const runLoopApp = (args: string[]) => {
+      return runJsonApp([path.join(mainFixturesPath, 'apps', 'uv-loop', 'main.js'), ...args]);
+    };
+
+    for (const args of [[], ['--node-loop-fd-watcher']]) {
+      it(`runs timers, fs and socket callbacks in order with ${args.length ? args[0] : 'the embed thread'}`, async () => {
+        const { latency, ...result } = await runLoopApp(args);
+        console.log(`uv latency (ms), ${args.length ? args[0] : 'embed thread'}: ${JSON.stringify(latency)}`);
+        for (const samples of [latency.timers, latency.fs]) {
+          expect(samples.mean).to.be.a('number').and.to.be.at.least(0);
+          expect(samples.p99).to.be.at.least(samples.p50);
+        }
+        expect(result).to.deep.equal({
+          timers: {
+            order: ['timeout 0', 'timeout 20', 'timeout 40'],
+            immediate: true,
+            elapsedAtLeastDelay: true
+          },
+          fs: true,
+          socket: 'ping'
+        });
+      });
+    }
+  });
+
+  describe('--node-loop-max-passes', () => {
+    const runPassesApp = (args: string[]) => {
+      return runJsonApp([path.join(mainFixturesPath, 'apps', 'uv-loop-passes', 'main.js'), ...args]);
+    };
+
+    it('returns to the message loop after every pass by default', async () => {
+      const { passes } = await runPassesApp([]);
+      expect(passes).to.not.be.empty();
+      expect(passes.every((count: number) => count === 1)).to.be.true();
+    });
+
+    it('runs callbacks queued during a pass within the same wakeup', async () => {
+      const { passes } = await runPassesApp(['--node-loop-max-passes=4']);
+      expect(passes).to.not.be.empty();
+      expect(Math.max(...passes)).to.equal(4);
+    });
+  });
+
+  describe('ArrayBuffer allocator', () => {
+    it('reports statistics that follow allocations', () => {
+      const before = process.getArrayBufferAllocatorStats();
+      const size = 64 * 1024;
+      const buffers = Array.from({ length: 64 }, () => Buffer.alloc(size));
+      const after = process.getArrayBufferAllocatorStats();
+
+      expect(after.committed).to.be.above(0);
+      expect(after.active).to.be.at.least(before.active + buffers.length * size * 0.75);
+      expect(after.fragmentation).to.be.within(0, 1);
+      const bucket = after.buckets.find(bucket => bucket.slotSize >= size && !bucket.directMap);
+      expect(bucket).to.not.be.undefined();
+      expect(bucket!.count).to.be.at.least(buffers.length);
+      for (const bucket of after.buckets) {
+        expect(bucket.resident).to.be.at.least(bucket.active);
+      }
+    });
+
+    const runChurnApp = (args: string[]) => {
+      return runJsonApp([...args, path.join(mainFixturesPath, 'apps', 'array-buffer-churn', 'main.js')]);
+    };
+
+    it('runs without a thread cache by default', async () => {
+      const { stats } = await runChurnApp([]);
+      expect(stats.threadCacheEnabled).to.be.false();
+      expect(stats.threadCache).to.be.undefined();
+    });
+
+    // Builds that use PartitionAlloc as malloc give the thread cache to
+    // malloc, there the switch only logs a warning.
+    ifit(!features.isPartitionAllocAsMallocEnabled())('serves allocations from the thread cache with --enable-array-buffer-thread-cache', async () => {
+      const { stats } = await runChurnApp(['--enable-array-buffer-thread-cache']);
+      expect(stats.threadCacheEnabled).to.be.true();
+      expect(stats.threadCache.allocCount).to.be.above(0);
+      expect(stats.threadCache.allocHits).to.be.above(0);
+    });
+
+    it('runs Buffer heavy workloads with and without the thread cache', async () => {
+      const defaultCache = await runChurnApp([]);
+      const threadCache = await runChurnApp(['--enable-array-buffer-thread-cache']);
+      console.log(`Buffer churn (ms), default: ${JSON.stringify({ ...defaultCache, stats: undefined })}`);
+      console.log(`Buffer churn (ms), thread cache: ${JSON.stringify({ ...threadCache, stats: undefined })}`);
+      for (const result of [defaultCache, threadCache]) {
+        expect(result.small).to.be.a('number').and.to.be.at.least(0);
+        expect(result.chunks).to.be.a('number').and.to.be.at.least(0);
+        expect(result.stream).to.be.a('number').and.to.be.at.least(0);
+      }
+    });
+  });
+
+  describe('builtin code cache', () => {
+    // Spawned without the spec runner's --js-flags, which V8 would reject the
+    // cache for.
+    const getCodeCacheStats = (env: NodeJS.ProcessEnv) => {
+      return runJsonApp([path.join(mainFixturesPath, 'apps', 'builtin-code-cache', 'main.js')], env);
+    };
+
+    const runStartupApp = (env: NodeJS.ProcessEnv) => {
+      return runJsonApp([path.join(mainFixturesPath, 'apps', 'startup-time', 'main.js')], env);
+    };
+
+    it('is accepted in the browser and renderer processes', async () => {
+      const { browser, renderer } = await getCodeCacheStats({});
+      expect(browser.accepted).to.be.at.least(1);
+      expect(browser.rejected).to.equal(0);
+      expect(renderer.accepted).to.be.at.least(1);
+      expect(renderer.rejected).to.equal(0);
+    });
+
+    it('is not used when ELECTRON_DISABLE_BUILTIN_CODE_CACHE is set', async () => {
+      const { browser, renderer } = await getCodeCacheStats({ ELECTRON_DISABLE_BUILTIN_CODE_CACHE: '1' });
+      expect(browser).to.deep.equal({ accepted: 0, rejected: 0 });
+      expect(renderer).to.deep.equal({ accepted: 0, rejected: 0 });
+    });
+
+    it('starts processes with and without the code cache', async () => {
+      const withCache = await runStartupApp({});
+      const withoutCache = await runStartupApp({ ELECTRON_DISABLE_BUILTIN_CODE_CACHE: '1' });
+      console.log(`startup (ms), code cache: ${JSON.stringify(withCache)}`);
+      console.log(`startup (ms), no code cache: ${JSON.stringify(withoutCache)}`);
+      for (const result of [withCache, withoutCache]) {
+        expect(result.browserInit).to.be.a('number').and.to.be.above(0);
+        expect(result.renderer).to.be.a('number').and.to.be.above(0);
+        expect(result.sandboxedRenderer).to.be.a('number').and.to.be.above(0);
+      }
+    });
+  });
+
   describe('contexts', () => {
     describe('setTimeout called under Chromium event loop in browser process', () => {
       it('Can be scheduled in time', (done) => {
@@ -86,3 +86,16 @@ export async function startRemoteControlApp () {
   defer(() => { appProcess.kill('SIGINT'); });
   return new RemoteControlApp(appProcess, port);
 }
+
+// Runs a fixture app that prints a single line of JSON before quitting, and
+// returns what it printed.
+export async function runJsonApp (args: string[], env: NodeJS.ProcessEnv = {}) {
+  const appProcess = childProcess.spawn(process.execPath, args, { env: { ...process.env, ...env } });
+  let output = '';
+  appProcess.stdout.on('data', (data) => { output += data; });
+  const code = await new Promise(resolve => appProcess.once('close', resolve));
+  if (code !== 0) {
+    throw new Error(`${path.basename(path.dirname(args[0]))} exited with code ${code}`);
+  }
+  return JSON.parse(output.trim());
+}
@@ -41,6 +41,25 @@ describe('clipboard module', () => {
     });
   });
 
+  describe('clipboard.readImageAsync()', () => {
+    it('resolves with a NativeImage instance', async () => {
+      const p = path.join(fixtures, 'assets', 'logo.png');
+      const i = nativeImage.createFromPath(p);
+      clipboard.writeImage(p);
+      const readImage = await clipboard.readImageAsync();
+      expect(readImage.toDataURL()).to.equal(i.toDataURL());
+    });
+  });
+
+  describe('clipboard.readTextAsync() and clipboard.readHTMLAsync()', () => {
+    it('resolve with the same content as the sync readers', async () => {
+      clipboard.writeText('千江有水千江月，万里无云万里天');
+      expect(await clipboard.readTextAsync()).to.equal(clipboard.readText());
+      clipboard.writeHTML('<string>Hi</string>');
+      expect(await clipboard.readHTMLAsync()).to.equal(clipboard.readHTML());
+    });
+  });
+
   describe('clipboard.readRTF', () => {
     it('returns rtf text correctly', () => {
       const rtf = '{\\rtf1\\ansi{\\fonttbl\\f0\\fswiss Helvetica;}\\f0\\pard\nThis is some {\\b bold} text.\\par\n}';
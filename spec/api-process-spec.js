@@ -1,6 +1,7 @@
 const { ipcRenderer } = require('electron');
 const fs = require('fs');
 const path = require('path');
+const zlib = require('zlib');
 
 const { expect } = require('chai');
 
@@ -114,6 +115,55 @@ describe('process module', () => {
       const success = process.takeHeapSnapshot('');
       expect(success).to.be.false();
     });
+
+    it('can compress the snapshot', async () => {
+      const filePath = path.join(await ipcRenderer.invoke('get-temp-dir'), 'test.heapsnapshot.gz');
+      try {
+        const success = process.takeHeapSnapshot(filePath, { compression: 'gzip' });
+        expect(success).to.be.true();
+        const snapshot = JSON.parse(zlib.gunzipSync(fs.readFileSync(filePath)).toString());
+        expect(snapshot).to.have.property('snapshot');
+      } finally {
+        fs.unlinkSync(filePath);
+      }
+    });
+  });
+
+  describe('process.startSamplingHeapProfiler()', () => {
+    it('records a .heapprofile', () => {
+      process.startSamplingHeapProfiler({ samplingInterval: 1024 });
+      const retained = [];
+      for (let i = 0; i < 1000; i++) retained.push(new Array(100).fill(i));
+      const profile = JSON.parse(process.stopSamplingHeapProfiler());
+      expect(profile.head).to.have.property('callFrame');
+      expect(profile.head.children).to.be.an('array');
+      expect(profile.samples).to.not.be.empty();
+    });
+
+    it('throws when the profiler is not running', () => {
+      expect(() => process.stopSamplingHeapProfiler()).to.throw(/not running/);
+    });
+  });
+
+  describe('process.startCpuProfile()', () => {
+    it('records a .cpuprofile', () => {
+      process.startCpuProfile({ samplingInterval: 100 });
+      const start = Date.now();
+      while (Date.now() - start < 50) Math.sqrt(Math.random());
+      const profile = JSON.parse(process.stopCpuProfile());
+      expect(profile.nodes).to.not.be.empty();
+      expect(profile.samples).to.have.lengthOf(profile.timeDeltas.length);
+      expect(profile.endTime).to.be.at.least(profile.startTime);
+    });
+
+    it('can not record two profiles at once', () => {
+      process.startCpuProfile();
+      try {
+        expect(() => process.startCpuProfile()).to.throw(/already being recorded/);
+      } finally {
+        process.stopCpuProfile();
+      }
+    });
   });
 
   describe('process.contextId', () => {
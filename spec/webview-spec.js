@@ -828,6 +828,51 @@ describe('<webview> tag', function () {
     });
   });
 
+  describe('cached guest state', () => {
+    it('is up to date when navigation events are dispatched', async () => {
+      await loadWebView(webview, { src: `file://${fixtures}/pages/a.html` });
+      expect(webview.getURL()).to.equal(`file://${fixtures}/pages/a.html`);
+      expect(webview.isLoading()).to.be.false();
+
+      webview.src = `file://${fixtures}/pages/b.html`;
+      const { url } = await waitForEvent(webview, 'did-navigate');
+      expect(webview.getURL()).to.equal(url);
+      expect(webview.canGoBack()).to.be.true();
+    });
+
+    it('is up to date after a method changes the guest state', async () => {
+      await loadWebView(webview, { src: `file://${fixtures}/pages/a.html` });
+      webview.src = `file://${fixtures}/pages/b.html`;
+      await waitForEvent(webview, 'did-navigate');
+      expect(webview.canGoBack()).to.be.true();
+      webview.clearHistory();
+      expect(webview.canGoBack()).to.be.false();
+    });
+
+    it('reflects setters immediately', async () => {
+      await loadWebView(webview, { src: `file://${fixtures}/pages/a.html` });
+      webview.setZoomFactor(1.5);
+      expect(webview.getZoomFactor()).to.equal(1.5);
+      webview.audioMuted = true;
+      expect(webview.audioMuted).to.be.true();
+      expect(webview.isAudioMuted()).to.be.true();
+    });
+
+    it('logs errors of methods that are not waited for', async () => {
+      await loadWebView(webview, { src: `file://${fixtures}/pages/a.html` });
+      const originalError = console.error;
+      const logged = new Promise(resolve => {
+        console.error = (message) => {
+          console.error = originalError;
+          resolve(message);
+        };
+      });
+      webview.setZoomFactor(-1);
+      expect(await logged).to.match(/'zoomFactor' must be a double greater than 0.0/);
+      expect(webview.getZoomFactor()).to.equal(1);
+    });
+  });
+
   describe('dom-ready event', () => {
     it('emits when document is loaded', (done) => {
       const server = http.createServer(() => {});
@@ -24,6 +24,7 @@ declare namespace NodeJS {
     isExtensionsEnabled(): boolean;
     isComponentBuild(): boolean;
     isWinDarkModeWindowUiEnabled(): boolean;
+    isPartitionAllocAsMallocEnabled(): boolean;
   }
 
   interface IpcRendererBinding {
@@ -45,6 +46,7 @@ declare namespace NodeJS {
     getWeaklyTrackedValues(): any[];
     runUntilIdle(): void;
     isSameOrigin(a: string, b: string): boolean;
+    getBuiltinCodeCacheStats(): { accepted: number, rejected: number };
     triggerFatalErrorForTesting(): void;
   }
 
@@ -127,13 +129,18 @@ declare namespace NodeJS {
     done: () => void;
   };
   type BodyFunc = (pipe: DataPipe) => void;
+  type FileBody = {
+    path: string;
+    offset?: number;
+    length?: number;
+  };
   type CreateURLLoaderOptions = {
     method: string;
     url: string;
     extraHeaders?: Record<string, string>;
     useSessionCookies?: boolean;
     credentials?: 'include' | 'omit';
-    body: Uint8Array | BodyFunc;
+    body: Uint8Array | BodyFunc | FileBody;
     session?: Electron.Session;
     partition?: string;
     referrer?: string;
@@ -141,6 +148,11 @@ declare namespace NodeJS {
     hasUserActivation?: boolean;
     mode?: string;
     destination?: string;
+    downloadToFile?: string;
+    downloadHash?: string;
+    downloadToBuffer?: boolean;
+    downloadMaxSize?: number;
+    progressInterval?: number;
   };
   type ResponseHead = {
     statusCode: number;
@@ -161,7 +173,7 @@ declare namespace NodeJS {
 
   interface URLLoader extends EventEmitter {
     cancel(): void;
-    on(eventName: 'data', listener: (event: any, data: ArrayBuffer, resume: () => void) => void): this;
+    on(eventName: 'data', listener: (event: any, data: ArrayBuffer, resume?: () => void) => void): this;
     on(eventName: 'response-started', listener: (event: any, finalUrl: string, responseHead: ResponseHead) => void): this;
     on(eventName: 'complete', listener: (event: any) => void): this;
     on(eventName: 'error', listener: (event: any, netErrorString: string) => void): this;
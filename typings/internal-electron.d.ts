@@ -78,6 +78,7 @@ declare namespace Electron {
     _printToPDF(options: any): Promise<Buffer>;
     _print(options: any, callback?: (success: boolean, failureReason: string) => void): void;
     _getPrinters(): Electron.PrinterInfo[];
+    _streamHeapSnapshot(callback: (chunk: Buffer, resume: () => void) => boolean, options: Electron.CreateHeapSnapshotStreamOptions): Promise<void>;
     _init(): void;
     canGoToIndex(index: number): boolean;
     getActiveIndex(): number;
@@ -123,10 +124,9 @@ declare namespace Electron {
     _callMenuWillShow(): void;
     _executeCommand(event: any, id: number): void;
     _menuWillShow(): void;
+    _updateItemState(item: MenuItem): void;
     commandsMap: Record<string, MenuItem>;
-    groupsMap: Record<string, {
-      checked: boolean;
-    }[]>;
+    groupsMap: Record<string, MenuItem[]>;
     getItemCount(): number;
     popupAt(window: BaseWindow, x: number, y: number, positioning: number, callback: () => void): void;
     closePopupAt(id: number): void;
@@ -134,6 +134,7 @@ declare namespace Electron {
     setToolTip(index: number, tooltip: string): void;
     setIcon(index: number, image: string | NativeImage): void;
     setRole(index: number, role: string): void;
+    setItemState(commandId: number, state: MenuItemState): void;
     insertItem(index: number, commandId: number, label: string): void;
     insertCheckItem(index: number, commandId: number, label: string): void;
     insertRadioItem(index: number, commandId: number, label: string, groupId: number): void;
@@ -143,8 +144,20 @@ declare namespace Electron {
     getAcceleratorTextAt(index: number): string;
   }
 
+  type MenuItemState = {
+    checked: boolean;
+    enabled: boolean;
+    visible: boolean;
+    acceleratorWorksWhenHidden: boolean;
+    registerAccelerator: boolean;
+    accelerator?: Accelerator;
+    defaultAccelerator?: Accelerator;
+  };
+
   interface MenuItem {
     overrideReadOnlyProperty(property: string, value: any): void;
+    overrideStateProperty(property: string, value: any): void;
+    hasDynamicState(): boolean;
     groupId: number;
     getDefaultRoleAccelerator(): Accelerator | undefined;
     getCheckStatus(): boolean;